@@ -39,11 +39,23 @@ main(int argc, char *argv[])
       prm.parse_input(argv[1]);
       NSparam.parse(prm);
 
-      GLSNavierStokesSolver<2> problem_2d(
-        NSparam,
-        NSparam.fem_parameters.velocity_order,
-        NSparam.fem_parameters.pressure_order);
-      problem_2d.solve();
+      if (NSparam.linear_solver.vector_backend ==
+          Parameters::LinearSolver::VectorBackend::dealii)
+        {
+          GLSNavierStokesSolver<2, LinearAlgebra::distributed::Vector<double>>
+            problem_2d(NSparam,
+                       NSparam.fem_parameters.velocity_order,
+                       NSparam.fem_parameters.pressure_order);
+          problem_2d.solve();
+        }
+      else
+        {
+          GLSNavierStokesSolver<2> problem_2d(
+            NSparam,
+            NSparam.fem_parameters.velocity_order,
+            NSparam.fem_parameters.pressure_order);
+          problem_2d.solve();
+        }
     }
   catch (std::exception &exc)
     {
@@ -39,11 +39,23 @@ main(int argc, char *argv[])
       prm.parse_input(argv[1]);
       NSparam.parse(prm);
 
-      GLSNavierStokesSolver<3> problem_3d(
-        NSparam,
-        NSparam.fem_parameters.velocity_order,
-        NSparam.fem_parameters.pressure_order);
-      problem_3d.solve();
+      if (NSparam.linear_solver.vector_backend ==
+          Parameters::LinearSolver::VectorBackend::dealii)
+        {
+          GLSNavierStokesSolver<3, LinearAlgebra::distributed::Vector<double>>
+            problem_3d(NSparam,
+                       NSparam.fem_parameters.velocity_order,
+                       NSparam.fem_parameters.pressure_order);
+          problem_3d.solve();
+        }
+      else
+        {
+          GLSNavierStokesSolver<3> problem_3d(
+            NSparam,
+            NSparam.fem_parameters.velocity_order,
+            NSparam.fem_parameters.pressure_order);
+          problem_3d.solve();
+        }
     }
   catch (std::exception &exc)
     {
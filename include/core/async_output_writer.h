@@ -0,0 +1,132 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2020 -  by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_async_output_writer_h
+#define lethe_async_output_writer_h
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief The AsyncOutputWriter class writes files from a background thread.
+ * The content of the files is produced in memory by the solver, which then
+ * continues its computation while the files are written to the file system.
+ *
+ * The memory used by the files waiting to be written is bounded. When a new
+ * file would exceed the bound, the solver waits until enough files have been
+ * written. The background thread only does file operations, it never calls
+ * MPI or deal.II. Tasks doing file operations, such as the commit of a
+ * checkpoint, can also be queued after the files they depend on.
+ */
+class AsyncOutputWriter
+{
+public:
+  /**
+   * @brief Constructor for the AsyncOutputWriter. Starts the background thread
+   *
+   * @param max_buffer_size Maximal number of bytes of the files waiting to be
+   * written. A single file larger than this bound is still written.
+   */
+  AsyncOutputWriter(const std::size_t max_buffer_size);
+
+  /**
+   * @brief Destructor. Writes the remaining files and stops the background
+   * thread
+   */
+  ~AsyncOutputWriter();
+
+  AsyncOutputWriter(const AsyncOutputWriter &) = delete;
+  AsyncOutputWriter &
+  operator=(const AsyncOutputWriter &) = delete;
+
+  /**
+   * @brief write Queues a file to be written by the background thread. Waits
+   * if the file would exceed the memory bound of the queue. The files are
+   * written in the order in which they are queued.
+   *
+   * @param filename Name of the file
+   *
+   * @param content Content of the file, which is moved into the queue
+   */
+  void
+  write(const std::string &filename, std::string &&content);
+
+  /**
+   * @brief enqueue Queues a task executed by the background thread once the
+   * files queued before it have been written. The task must not call MPI or
+   * deal.II. An exception thrown by the task is handled as a failed write.
+   *
+   * @param task Task executed by the background thread
+   */
+  void
+  enqueue(std::function<void()> &&task);
+
+  /**
+   * @brief flush Waits until all the queued files have been written. The
+   * error of a failed write is thrown by the following call to write or flush
+   */
+  void
+  flush();
+
+private:
+  /**
+   * @brief Writes the queued files until the writer is destroyed
+   */
+  void
+  run();
+
+  /**
+   * @brief Throws the error of a failed write, if there is one. The mutex
+   * must be locked.
+   */
+  void
+  throw_error();
+
+  const std::size_t max_buffer_size;
+
+  // File or task waiting in the queue
+  struct QueuedWrite
+  {
+    std::string           filename;
+    std::string           content;
+    std::function<void()> task;
+  };
+
+  // Files and tasks waiting to be written and total size of the files. The
+  // file being written is counted in the buffer size until it is written.
+  std::deque<QueuedWrite> queue;
+  std::size_t             buffer_size;
+  bool                    writing;
+  bool                    stop;
+  std::exception_ptr      error;
+
+  std::mutex              mutex;
+  std::condition_variable file_queued;
+  std::condition_variable file_written;
+  std::thread             thread;
+};
+
+#endif
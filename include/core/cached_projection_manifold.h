@@ -0,0 +1,227 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2019 - 2020 by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_cached_projection_manifold_h
+#define lethe_cached_projection_manifold_h
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_OPENCASCADE
+
+#  include <deal.II/base/array_view.h>
+#  include <deal.II/base/point.h>
+
+#  include <deal.II/opencascade/manifold_lib.h>
+
+#  include "core/fnv1a_hash.h"
+
+#  include <list>
+#  include <memory>
+#  include <mutex>
+#  include <unordered_map>
+#  include <vector>
+
+using namespace dealii;
+
+/**
+ * @brief CachedProjectionManifold. Normal to mesh projection on a CAD shape
+ * which stores the result of each projection. The new points of the mesh
+ * refinement and the support points of the curved mappings are computed from
+ * the same surrounding points every time a cell is refined or a MappingQ is
+ * reinitialized on it. Only the first of these computations pays for the
+ * OpenCASCADE projection, the next ones are found in the cache.
+ *
+ * The projections are identified by the surrounding points and the candidate
+ * point, compared exactly, since the same computation always receives the
+ * exact same arguments. The cache is shared by the clones of the manifold,
+ * such as the one held by the triangulation, and is protected by a mutex
+ * since the mappings are evaluated by the assembly threads. When the cache is
+ * full, the projection which was used the least recently is evicted.
+ */
+template <int dim, int spacedim>
+class CachedProjectionManifold
+  : public OpenCASCADE::NormalToMeshProjectionManifold<dim, spacedim>
+{
+public:
+  /**
+   * @brief Constructor for the CachedProjectionManifold.
+   *
+   * @param shape CAD shape on which the points are projected
+   *
+   * @param tolerance Tolerance of the projection on the shape
+   *
+   * @param max_cache_size Maximal number of projections kept in the cache,
+   * which bounds its memory footprint
+   */
+  CachedProjectionManifold(const TopoDS_Shape &shape,
+                           const double        tolerance,
+                           const std::size_t   max_cache_size = 1000000)
+    : OpenCASCADE::NormalToMeshProjectionManifold<dim, spacedim>(shape,
+                                                                 tolerance)
+    , shape(shape)
+    , tolerance(tolerance)
+    , cache(std::make_shared<ProjectionCache>(max_cache_size))
+  {}
+
+  virtual std::unique_ptr<Manifold<dim, spacedim>>
+  clone() const override
+  {
+    auto copy = std::make_unique<CachedProjectionManifold<dim, spacedim>>(
+      shape, tolerance, cache->max_size);
+    copy->cache = cache;
+    return copy;
+  }
+
+  virtual Point<spacedim>
+  project_to_manifold(
+    const ArrayView<const Point<spacedim>> &surrounding_points,
+    const Point<spacedim> &                 candidate) const override
+  {
+    std::vector<double> key;
+    key.reserve((surrounding_points.size() + 1) * spacedim);
+    for (const Point<spacedim> &point : surrounding_points)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        key.push_back(point[d]);
+    for (unsigned int d = 0; d < spacedim; ++d)
+      key.push_back(candidate[d]);
+
+    {
+      std::lock_guard<std::mutex> lock(cache->mutex);
+      const auto                  projection = cache->projections.find(key);
+      if (projection != cache->projections.end())
+        {
+          ++cache->n_hits;
+          cache->usage.splice(cache->usage.begin(),
+                              cache->usage,
+                              projection->second.usage);
+          return projection->second.point;
+        }
+    }
+
+    // The projection is computed outside of the lock so that the threads
+    // can project different points concurrently
+    const Point<spacedim> projected_point =
+      OpenCASCADE::NormalToMeshProjectionManifold<dim, spacedim>::
+        project_to_manifold(surrounding_points, candidate);
+
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    const auto                  inserted = cache->projections.emplace(
+      std::move(key), CachedProjection{projected_point, {}});
+
+    // Another thread may have stored the same projection in the meantime
+    if (!inserted.second)
+      return projected_point;
+
+    cache->usage.push_front(&inserted.first->first);
+    inserted.first->second.usage = cache->usage.begin();
+    if (cache->projections.size() > cache->max_size)
+      {
+        const auto least_recent =
+          cache->projections.find(*cache->usage.back());
+        cache->usage.pop_back();
+        cache->projections.erase(least_recent);
+      }
+    return projected_point;
+  }
+
+  /**
+   * @brief Returns the number of projections currently stored in the cache
+   */
+  std::size_t
+  n_cached_projections() const
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    return cache->projections.size();
+  }
+
+  /**
+   * @brief Returns the number of projections which were found in the cache
+   * since its creation
+   */
+  std::size_t
+  n_cache_hits() const
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    return cache->n_hits;
+  }
+
+private:
+  // Coordinates of the surrounding points and of the candidate point
+  using Key = std::vector<double>;
+
+  /**
+   * @brief Hash of the coordinates identifying a projection (64 bits FNV-1a
+   * of their bytes)
+   */
+  struct CoordinatesHash
+  {
+    std::size_t
+    operator()(const std::vector<double> &coordinates) const
+    {
+      FNV1aHash hash;
+      for (const double coordinate : coordinates)
+        {
+          // Adding zero maps -0 to +0, which compare equal
+          const double normalized_coordinate = coordinate + 0.;
+          hash.add(&normalized_coordinate, sizeof(normalized_coordinate));
+        }
+      return static_cast<std::size_t>(hash.value());
+    }
+  };
+
+  /**
+   * @brief Projected point and its position in the order of usage of the
+   * cache
+   */
+  struct CachedProjection
+  {
+    Point<spacedim>                           point;
+    typename std::list<const Key *>::iterator usage;
+  };
+
+  /**
+   * @brief Projections stored by their coordinates. The usage list holds the
+   * keys of the projections from the most to the least recently used one,
+   * which is the one evicted when the cache is full. The keys of an
+   * unordered_map are never moved, so the list can point to them.
+   */
+  struct ProjectionCache
+  {
+    ProjectionCache(const std::size_t max_size)
+      : max_size(max_size)
+      , n_hits(0)
+    {}
+
+    const std::size_t max_size;
+    std::size_t       n_hits;
+    std::mutex        mutex;
+
+    std::unordered_map<Key, CachedProjection, CoordinatesHash> projections;
+    std::list<const Key *>                                     usage;
+  };
+
+  const TopoDS_Shape shape;
+  const double       tolerance;
+
+  std::shared_ptr<ProjectionCache> cache;
+};
+
+#endif // DEAL_II_WITH_OPENCASCADE
+
+#endif
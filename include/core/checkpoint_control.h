@@ -0,0 +1,133 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2020 -  by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_checkpoint_control_h
+#define lethe_checkpoint_control_h
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The CheckpointControl class rotates the checkpoints over a number of
+ * generations and validates them with checksums.
+ *
+ * The files of a checkpoint share a prefix. Once they are all written, their
+ * size and checksum are stored in the prefix.checksums file and the prefix is
+ * added at the top of the list of the checkpoints, the filename.checkpoints
+ * file. Both files are replaced atomically by renaming a temporary file, so a
+ * checkpoint interrupted by a crash never replaces the previous valid one.
+ * When the simulation is restarted, the most recent checkpoint whose files
+ * match their checksums is used.
+ *
+ * The class only does file operations, so the commit of a checkpoint can be
+ * done by a background thread.
+ */
+class CheckpointControl
+{
+public:
+  /**
+   * @brief Size and checksum of a file of a checkpoint
+   */
+  struct FileChecksum
+  {
+    std::uint64_t size;
+    std::uint64_t checksum;
+  };
+
+  /**
+   * @brief Constructor for the CheckpointControl
+   *
+   * @param filename Prefix of the checkpoints
+   *
+   * @param n_generations Number of checkpoints kept. At least two are kept,
+   * since the only checkpoint of a single generation would be overwritten in
+   * place and lost if the simulation crashed while writing it.
+   */
+  CheckpointControl(const std::string &filename,
+                    const unsigned int n_generations);
+
+  /**
+   * @brief next_prefix Returns the prefix of the next checkpoint, which is the
+   * first unused generation or else the oldest one. The generations are named
+   * filename_00, filename_01, etc.
+   */
+  std::string
+  next_prefix() const;
+
+  /**
+   * @brief checksum Returns the size and the checksum of the content of a
+   * file. The checksums of the files built in memory are calculated before
+   * they are written, which spares reading them back at the commit.
+   *
+   * @param content Content of the file
+   */
+  static FileChecksum
+  checksum(const std::string &content);
+
+  /**
+   * @brief commit Stores the checksums of the files of a checkpoint and makes
+   * it the most recent checkpoint. The files which do not exist are ignored.
+   *
+   * @param prefix Prefix of the checkpoint
+   *
+   * @param suffixes Suffixes of the files of the checkpoint
+   *
+   * @param known_checksums Checksums of the files whose content was known
+   * when they were written, indexed by their suffix. The other files are read
+   * to calculate their checksums.
+   */
+  void
+  commit(const std::string &                        prefix,
+         const std::vector<std::string> &           suffixes,
+         const std::map<std::string, FileChecksum> &known_checksums =
+           std::map<std::string, FileChecksum>()) const;
+
+  /**
+   * @brief is_valid Checks that the files of a checkpoint match the size and
+   * the checksum stored when the checkpoint was committed
+   *
+   * @param prefix Prefix of the checkpoint
+   */
+  bool
+  is_valid(const std::string &prefix) const;
+
+  /**
+   * @brief latest_valid_prefix Returns the prefix of the most recent valid
+   * checkpoint. The filename is returned if there is no list of checkpoints,
+   * which is the case of the checkpoints written without checksums. Throws if
+   * none of the listed checkpoints is valid.
+   */
+  std::string
+  latest_valid_prefix() const;
+
+private:
+  /**
+   * @brief Reads the prefixes of the committed checkpoints, the most recent
+   * first
+   */
+  std::vector<std::string>
+  read_checkpoint_list() const;
+
+  std::string  filename;
+  unsigned int n_generations;
+};
+
+#endif
@@ -0,0 +1,84 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2019 - 2020 by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_fnv1a_hash_h
+#define lethe_fnv1a_hash_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief FNV1aHash. 64 bits FNV-1a hash of a sequence of bytes, which can be
+ * added in several pieces. Unlike std::hash, its value does not depend on the
+ * standard library, which keeps the hashes written to files stable.
+ */
+class FNV1aHash
+{
+public:
+  FNV1aHash()
+    : hash(14695981039346656037ULL)
+  {}
+
+  /**
+   * @brief Adds bytes to the hashed sequence
+   *
+   * @param data Pointer to the first byte
+   *
+   * @param size Number of bytes
+   */
+  void
+  add(const void *data, const std::size_t size)
+  {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; ++i)
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+
+  void
+  add(const std::string &data)
+  {
+    add(data.data(), data.size());
+  }
+
+  /**
+   * @brief Returns the hash of the bytes added so far
+   */
+  std::uint64_t
+  value() const
+  {
+    return hash;
+  }
+
+private:
+  std::uint64_t hash;
+};
+
+/**
+ * @brief Returns the 64 bits FNV-1a hash of a string
+ */
+inline std::uint64_t
+fnv1a_hash(const std::string &data)
+{
+  FNV1aHash hash;
+  hash.add(data);
+  return hash.value();
+}
+
+#endif
@@ -0,0 +1,359 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2019 - 2020 by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_jfnk_non_linear_solver_h
+#define lethe_jfnk_non_linear_solver_h
+
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+
+#include "non_linear_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief JFNKNonLinearSolver. Jacobian-free Newton-Krylov solver for non-linear systems of
+ * equations. The Newton correction is obtained with a GMRES solver in which
+ * the product of the jacobian matrix with a vector is approximated by a finite
+ * difference of the residual:
+ *   J v ~ (R(x + eps v) - R(x)) / eps
+ * The residual is evaluated with the assemble_rhs function of the physics
+ * solver. A matrix is only assembled to build the preconditioner: it is the
+ * Picard linearization of the equations, which is cheaper to assemble than
+ * the jacobian matrix, and the physics solver may release its storage once
+ * the preconditioner is built. The preconditioner is kept over
+ * jfnk_preconditioner_lifetime non-linear iterations, also across successive
+ * solutions, and rebuilt earlier only if the Krylov solver does not converge
+ * with it. The maximal number of iterations and the
+ * restart of the GMRES solver are those of the linear solver of the physics
+ * solver. The update is then relaxed with the same line search as the
+ * NewtonNonLinearSolver.
+ */
+template <typename VectorType>
+class JFNKNonLinearSolver : public NonLinearSolver<VectorType>
+{
+public:
+  /**
+   * @brief Constructor for the JFNKNonLinearSolver.
+   *
+   * @param physics_solver A pointer to the physics solver to which the non-linear solver is attached
+   *
+   * @param param Non-linear solver parameters
+   *
+   */
+  JFNKNonLinearSolver(PhysicsSolver<VectorType> *        physics_solver,
+                      const Parameters::NonLinearSolver &param);
+
+  /**
+   * @brief Solve the non-linear system of equation.
+   *
+   * @param time_stepping_method Time stepping method being used. This is
+   * required since the jacobian of the matrix is going to depend on the method
+   * used
+   *
+   * @param is_initial_step Boolean variable that controls which constraints are
+   * going to be applied to the equations
+   *
+   * @param force_matrix_renewal Boolean variable that controls if the
+   * preconditioner is rebuilt at the first iteration even if it has not
+   * reached the end of its skip_iterations lifetime.
+   */
+  void
+  solve(const Parameters::SimulationControl::TimeSteppingMethod
+                   time_stepping_method,
+        const bool is_initial_step,
+        const bool force_matrix_renewal = true) override;
+
+  /**
+   * @brief Calculates the finite difference approximation of the product of the
+   * jacobian matrix with the vector src around the present base solution
+   */
+  void
+  jacobian_vmult(VectorType &dst, const VectorType &src);
+
+  /**
+   * @brief Returns the number of jacobian-free products calculated since the
+   * construction of the solver, each of which requires the assembly of a
+   * right-hand side
+   */
+  unsigned int
+  get_n_jacobian_products() const
+  {
+    return n_jacobian_products;
+  }
+
+private:
+  /**
+   * @brief Linear operator passed to the Krylov solver. Its vmult
+   * is the jacobian-free product of the attached non-linear solver.
+   */
+  class JacobianOperator
+  {
+  public:
+    JacobianOperator(JFNKNonLinearSolver<VectorType> *jfnk_solver)
+      : jfnk_solver(jfnk_solver)
+    {}
+
+    void
+    vmult(VectorType &dst, const VectorType &src) const
+    {
+      jfnk_solver->jacobian_vmult(dst, src);
+    }
+
+  private:
+    JFNKNonLinearSolver<VectorType> *jfnk_solver;
+  };
+
+  /**
+   * @brief Preconditioner passed to the Krylov solver. It applies the
+   * preconditioner built by the physics solver from the last assembled
+   * jacobian matrix.
+   */
+  class Preconditioner
+  {
+  public:
+    Preconditioner(PhysicsSolver<VectorType> *physics_solver)
+      : physics_solver(physics_solver)
+    {}
+
+    void
+    vmult(VectorType &dst, const VectorType &src) const
+    {
+      physics_solver->apply_preconditioner(dst, src);
+    }
+
+  private:
+    PhysicsSolver<VectorType> *physics_solver;
+  };
+
+  // Iterations done with the present preconditioner
+  unsigned int preconditioner_age;
+
+  // Set when the Krylov solver did not converge with the present
+  // preconditioner, which is then rebuilt at the next iteration
+  bool preconditioner_failed;
+
+  // Number of jacobian-free products calculated
+  unsigned int n_jacobian_products;
+
+  // Time stepping method of the present solve, used by the residual
+  // evaluations of the jacobian-free product
+  Parameters::SimulationControl::TimeSteppingMethod time_stepping_method;
+
+  // Right-hand side of the present solution, around which the jacobian is
+  // approximated
+  VectorType base_rhs;
+};
+
+template <typename VectorType>
+JFNKNonLinearSolver<VectorType>::JFNKNonLinearSolver(
+  PhysicsSolver<VectorType> *        physics_solver,
+  const Parameters::NonLinearSolver &params)
+  : NonLinearSolver<VectorType>(physics_solver, params)
+  , preconditioner_age(0)
+  , preconditioner_failed(false)
+  , n_jacobian_products(0)
+{}
+
+template <typename VectorType>
+void
+JFNKNonLinearSolver<VectorType>::jacobian_vmult(VectorType &      dst,
+                                                const VectorType &src)
+{
+  PhysicsSolver<VectorType> *solver = this->physics_solver;
+
+  // The constrained degrees of freedom are not perturbed. Their rows of the
+  // residual are zero, so they are treated as an identity block instead. The
+  // destination holds the constrained direction until the residual is
+  // evaluated, which spares a work vector.
+  dst = src;
+  solver->nonzero_constraints.set_zero(dst);
+
+  const double direction_norm = dst.l2_norm();
+  if (direction_norm == 0.)
+    {
+      dst = src;
+      return;
+    }
+
+  const double epsilon =
+    std::sqrt(std::numeric_limits<double>::epsilon()) *
+    (1. + solver->present_solution.l2_norm()) / direction_norm;
+
+  solver->local_evaluation_point = solver->present_solution;
+  solver->local_evaluation_point.add(epsilon, dst);
+  solver->apply_constraints();
+  solver->evaluation_point = solver->local_evaluation_point;
+  solver->assemble_rhs(time_stepping_method);
+  ++n_jacobian_products;
+
+  // The right-hand side is the opposite of the residual
+  dst.sadd(-1., 1., src);
+  dst.add(1. / epsilon, base_rhs, -1. / epsilon, solver->system_rhs);
+}
+
+template <typename VectorType>
+void
+JFNKNonLinearSolver<VectorType>::solve(
+  const Parameters::SimulationControl::TimeSteppingMethod
+             p_time_stepping_method,
+  const bool is_initial_step,
+  const bool force_matrix_renewal)
+{
+  double       current_res;
+  double       last_res;
+  unsigned int outer_iteration = 0;
+  last_res                     = 1.0;
+  current_res                  = 1.0;
+
+  time_stepping_method = p_time_stepping_method;
+
+  PhysicsSolver<VectorType> *solver = this->physics_solver;
+
+  base_rhs.reinit(solver->newton_update);
+
+  const unsigned int preconditioner_lifetime =
+    std::max(this->params.jfnk_preconditioner_lifetime, 1U);
+  const double forcing_term = this->params.jfnk_forcing_term > 0 ?
+                                this->params.jfnk_forcing_term :
+                                1e-2;
+
+  JacobianOperator jacobian_operator(this);
+  Preconditioner   preconditioner(solver);
+
+  while ((current_res > this->params.tolerance) &&
+         outer_iteration < this->params.max_iterations)
+    {
+      if (outer_iteration == 0)
+        solver->evaluation_point = solver->present_solution;
+
+      const bool renew_preconditioner =
+        !solver->is_preconditioner_available() ||
+        preconditioner_age >= preconditioner_lifetime ||
+        preconditioner_failed ||
+        (outer_iteration == 0 && (is_initial_step || force_matrix_renewal));
+
+      // The matrix is only assembled to build the preconditioner. It is the
+      // cheaper Picard linearization of the equations, and its storage is
+      // released once the preconditioner is built since the jacobian-free
+      // products never use it.
+      if (renew_preconditioner)
+        {
+          solver->picard_linearization = true;
+          solver->assemble_matrix_and_rhs(time_stepping_method);
+          solver->picard_linearization = false;
+          solver->setup_preconditioner();
+          solver->release_system_matrix();
+          preconditioner_age    = 0;
+          preconditioner_failed = false;
+        }
+      else
+        {
+          ++solver->solver_statistics.preconditioner_reuses;
+          if (outer_iteration == 0)
+            solver->assemble_rhs(time_stepping_method);
+        }
+
+      if (outer_iteration == 0)
+        {
+          current_res = solver->system_rhs.l2_norm();
+          last_res    = current_res;
+          solver->accept_non_linear_iterate(time_stepping_method, current_res);
+        }
+
+      if (this->params.verbosity != Parameters::Verbosity::quiet)
+        {
+          solver->pcout << "JFNK iteration: " << outer_iteration
+                        << "  - Residual:  " << current_res << std::endl;
+        }
+
+      base_rhs = solver->system_rhs;
+
+      SolverControl solver_control(solver->get_krylov_max_iterations(),
+                                   std::max(forcing_term * current_res,
+                                            0.1 * this->params.tolerance),
+                                   false,
+                                   false);
+      typename SolverGMRES<VectorType>::AdditionalData gmres_data(
+        solver->get_krylov_max_vectors(), true);
+      SolverGMRES<VectorType> gmres(solver_control, gmres_data);
+
+      solver->newton_update = 0;
+      try
+        {
+          gmres.solve(jacobian_operator,
+                      solver->newton_update,
+                      base_rhs,
+                      preconditioner);
+        }
+      catch (SolverControl::NoConvergence &)
+        {
+          // An inexact correction is still used by the line search, but the
+          // lagged preconditioner is no longer good enough
+          preconditioner_failed = true;
+        }
+      ++preconditioner_age;
+      solver->solver_statistics.linear_iterations.push_back(
+        solver_control.last_step());
+
+      if (this->params.verbosity != Parameters::Verbosity::quiet)
+        {
+          solver->pcout << "  -Jacobian-free solver took : "
+                        << solver_control.last_step() << " steps "
+                        << std::endl;
+        }
+
+      double last_alpha              = 0.;
+      solver->local_evaluation_point = solver->present_solution;
+      for (double alpha = 1.0; alpha > 1e-3; alpha *= 0.5)
+        {
+          solver->local_evaluation_point.add(alpha - last_alpha,
+                                             solver->newton_update);
+          last_alpha = alpha;
+          solver->apply_constraints();
+          solver->evaluation_point = solver->local_evaluation_point;
+          solver->assemble_rhs(time_stepping_method);
+
+          current_res = solver->system_rhs.l2_norm();
+
+          if (this->params.verbosity != Parameters::Verbosity::quiet)
+            {
+              solver->pcout << "\t\talpha = " << std::setw(6) << alpha
+                            << std::setw(0) << " res = "
+                            << std::setprecision(this->params.display_precision)
+                            << current_res << std::endl;
+            }
+
+          if (current_res < 0.9 * last_res || last_res < this->params.tolerance)
+            {
+              break;
+            }
+        }
+
+      solver->present_solution = solver->evaluation_point;
+      last_res                 = current_res;
+      solver->accept_non_linear_iterate(time_stepping_method, current_res);
+      ++outer_iteration;
+      ++solver->solver_statistics.non_linear_iterations;
+    }
+}
+
+#endif
@@ -0,0 +1,330 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2019 - 2020 by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_krylov_recycling_h
+#define lethe_krylov_recycling_h
+
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace dealii;
+
+/**
+ * @brief RecyclingFGMRES. Flexible GMRES solver which keeps a recycled subspace
+ * between successive solutions of nearly identical linear systems, following
+ * the GCRO approach. The recycled subspace is spanned by the vectors U and
+ * their images C = A U, which are kept orthonormal.
+ *
+ * Each solution is first projected on the recycled subspace, which provides
+ * the initial guess x0 = U C^T b. The remaining residual is then reduced by
+ * a FGMRES solver applied to the projected operator (I - C C^T) A, which
+ * prevents the Krylov space from rebuilding the directions that are already
+ * known. The correction found by the solver is finally added to the recycled
+ * subspace, the oldest vector being dropped once the maximal dimension is
+ * reached.
+ *
+ * When the matrix has changed since the last solution, the images C are
+ * recomputed and orthonormalized, which costs one matrix-vector product per
+ * recycled vector.
+ */
+template <typename VectorType>
+class RecyclingFGMRES
+{
+public:
+  /**
+   * @brief Constructor for the RecyclingFGMRES.
+   *
+   * @param max_recycled_vectors Maximal dimension of the recycled subspace
+   *
+   * @param max_krylov_vectors Dimension of the Krylov subspace of the FGMRES
+   * solver before it restarts
+   */
+  RecyclingFGMRES(const unsigned int max_recycled_vectors,
+                  const unsigned int max_krylov_vectors = 30);
+
+  /**
+   * @brief Solve the linear system A x = b. The initial value of x is not
+   * used, the initial guess being the projection of the solution on the
+   * recycled subspace.
+   *
+   * @param matrix_changed Boolean variable which indicates that the matrix has
+   * changed since the last solution and that the recycled subspace has to be
+   * updated accordingly
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner,
+        SolverControl &           solver_control,
+        const bool                matrix_changed);
+
+  /**
+   * @brief Empties the recycled subspace. Must be called when the layout of
+   * the vectors changes.
+   */
+  void
+  clear();
+
+  /**
+   * @brief Returns the dimension of the recycled subspace used by the last
+   * solution
+   */
+  unsigned int
+  get_n_recycled_vectors() const
+  {
+    return n_used_vectors;
+  }
+
+  /**
+   * @brief Returns the ratio between the residual remaining after the
+   * projection on the recycled subspace and the right-hand side at the last
+   * solution. The smaller this ratio, the larger the savings in iterations.
+   */
+  double
+  get_deflation_ratio() const
+  {
+    return deflation_ratio;
+  }
+
+  /**
+   * @brief Returns the iterations saved by the last solution with respect to
+   * the baseline, which is the last solution done without recycled subspace.
+   * It is zero for a solution done without recycled subspace and negative if
+   * the recycled subspace made the solution slower.
+   */
+  int
+  get_saved_iterations() const
+  {
+    return saved_iterations;
+  }
+
+  /**
+   * @brief Returns the sum of the iterations saved by all the solutions since
+   * the construction of the solver
+   */
+  int
+  get_total_saved_iterations() const
+  {
+    return total_saved_iterations;
+  }
+
+private:
+  /**
+   * @brief Operator (I - C C^T) A on which the Krylov solver is applied
+   */
+  template <typename MatrixType>
+  class ProjectedOperator
+  {
+  public:
+    ProjectedOperator(const MatrixType &               A,
+                      const RecyclingFGMRES<VectorType> &recycler)
+      : A(A)
+      , recycler(recycler)
+    {}
+
+    void
+    vmult(VectorType &dst, const VectorType &src) const
+    {
+      A.vmult(dst, src);
+      recycler.project_out(dst, nullptr);
+    }
+
+  private:
+    const MatrixType &                 A;
+    const RecyclingFGMRES<VectorType> &recycler;
+  };
+
+  /**
+   * @brief Removes the components of v along the images C. The same
+   * combination of the vectors U is removed from u if it is provided.
+   */
+  void
+  project_out(VectorType &v, VectorType *u) const;
+
+  /**
+   * @brief Recomputes the images C = A U and orthonormalizes them
+   */
+  template <typename MatrixType>
+  void
+  update_images(const MatrixType &A);
+
+  // Recycled subspace and its images by the matrix
+  std::vector<VectorType> U;
+  std::vector<VectorType> C;
+
+  const unsigned int max_recycled_vectors;
+  const unsigned int max_krylov_vectors;
+  unsigned int       n_used_vectors;
+  double             deflation_ratio;
+
+  // Iterations of the last solution done without recycled subspace, and
+  // iterations saved with respect to them
+  unsigned int baseline_iterations;
+  int          saved_iterations;
+  int          total_saved_iterations;
+};
+
+template <typename VectorType>
+RecyclingFGMRES<VectorType>::RecyclingFGMRES(
+  const unsigned int max_recycled_vectors,
+  const unsigned int max_krylov_vectors)
+  : max_recycled_vectors(max_recycled_vectors)
+  , max_krylov_vectors(max_krylov_vectors)
+  , n_used_vectors(0)
+  , deflation_ratio(1.)
+  , baseline_iterations(0)
+  , saved_iterations(0)
+  , total_saved_iterations(0)
+{}
+
+template <typename VectorType>
+void
+RecyclingFGMRES<VectorType>::clear()
+{
+  U.clear();
+  C.clear();
+}
+
+template <typename VectorType>
+void
+RecyclingFGMRES<VectorType>::project_out(VectorType &v, VectorType *u) const
+{
+  // Modified Gram-Schmidt with respect to the orthonormal images
+  for (unsigned int i = 0; i < C.size(); ++i)
+    {
+      const double coefficient = C[i] * v;
+      v.add(-coefficient, C[i]);
+      if (u != nullptr)
+        u->add(-coefficient, U[i]);
+    }
+}
+
+template <typename VectorType>
+template <typename MatrixType>
+void
+RecyclingFGMRES<VectorType>::update_images(const MatrixType &A)
+{
+  std::vector<VectorType> old_U;
+  old_U.swap(U);
+  C.clear();
+
+  for (unsigned int i = 0; i < old_U.size(); ++i)
+    {
+      VectorType c(old_U[i]);
+      A.vmult(c, old_U[i]);
+      const double initial_norm = c.l2_norm();
+      project_out(c, &old_U[i]);
+
+      // Vectors which have become linearly dependent are dropped
+      const double norm = c.l2_norm();
+      if (norm <= 1e-12 * initial_norm || norm == 0.)
+        continue;
+
+      c /= norm;
+      old_U[i] /= norm;
+      C.push_back(c);
+      U.push_back(old_U[i]);
+    }
+}
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+RecyclingFGMRES<VectorType>::solve(const MatrixType &        A,
+                                   VectorType &              x,
+                                   const VectorType &        b,
+                                   const PreconditionerType &preconditioner,
+                                   SolverControl &           solver_control,
+                                   const bool                matrix_changed)
+{
+  // The recycled subspace is discarded if the vectors have been resized
+  if (!U.empty() && U[0].size() != b.size())
+    clear();
+
+  if (matrix_changed && !U.empty())
+    update_images(A);
+
+  n_used_vectors = U.size();
+
+  // Initial guess obtained by the projection on the recycled subspace and
+  // residual orthogonal to the images
+  VectorType residual(b);
+  x = 0;
+  for (unsigned int i = 0; i < C.size(); ++i)
+    {
+      const double coefficient = C[i] * residual;
+      residual.add(-coefficient, C[i]);
+      x.add(coefficient, U[i]);
+    }
+
+  const double rhs_norm = b.l2_norm();
+  deflation_ratio = rhs_norm > 0 ? residual.l2_norm() / rhs_norm : 0.;
+
+  // Correction in the complement of the recycled subspace
+  VectorType correction(b);
+  correction = 0;
+  ProjectedOperator<MatrixType> projected_operator(A, *this);
+  SolverFGMRES<VectorType>      solver(
+    solver_control,
+    typename SolverFGMRES<VectorType>::AdditionalData(max_krylov_vectors));
+  solver.solve(projected_operator, correction, residual, preconditioner);
+
+  if (n_used_vectors == 0)
+    {
+      baseline_iterations = solver_control.last_step();
+      saved_iterations    = 0;
+    }
+  else
+    saved_iterations = static_cast<int>(baseline_iterations) -
+                       static_cast<int>(solver_control.last_step());
+  total_saved_iterations += saved_iterations;
+
+  // The update of the solution is the correction from which its components
+  // along the recycled subspace are removed. Normalized, it becomes the
+  // newest recycled vector.
+  VectorType c(b);
+  A.vmult(c, correction);
+  const double initial_norm = c.l2_norm();
+  project_out(c, &correction);
+  x += correction;
+
+  if (max_recycled_vectors == 0)
+    return;
+
+  const double norm = c.l2_norm();
+  if (norm <= 1e-12 * initial_norm || norm == 0.)
+    return;
+
+  if (U.size() == max_recycled_vectors)
+    {
+      U.erase(U.begin());
+      C.erase(C.begin());
+    }
+  c /= norm;
+  correction /= norm;
+  C.push_back(c);
+  U.push_back(correction);
+}
+
+#endif
@@ -0,0 +1,114 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2020 -  by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_load_balance_report_h
+#define lethe_load_balance_report_h
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/mpi.h>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace dealii;
+
+/**
+ * @brief LoadBalanceStatistics. Distribution of a quantity, such as the wall
+ * time of a timer section or the number of locally owned cells, over the MPI
+ * ranks.
+ */
+struct LoadBalanceStatistics
+{
+  std::string  name;
+  double       min;
+  double       avg;
+  double       max;
+  unsigned int min_rank;
+  unsigned int max_rank;
+
+  /**
+   * @brief imbalance Ratio of the maximum to the average. The ranks wait for
+   * the slowest one, so a ratio of 1.25 means that a fifth of the time of the
+   * slowest rank is lost by the others. A quantity which is zero everywhere
+   * is balanced.
+   */
+  double
+  imbalance() const
+  {
+    return avg > 0 ? max / avg : 1.;
+  }
+};
+
+/**
+ * @brief compute_load_balance_statistics Calculates the distribution of
+ * quantities over the ranks. A quantity which is missing on a rank, such as a
+ * timer section which was never entered there, counts as zero on that rank.
+ *
+ * @param values_by_rank Values of the quantities on each rank, by name
+ *
+ * @return Statistics of each quantity, ordered by name
+ */
+std::vector<LoadBalanceStatistics>
+compute_load_balance_statistics(
+  const std::vector<std::map<std::string, double>> &values_by_rank);
+
+/**
+ * @brief write_load_balance_report Writes the distribution of the timer
+ * sections and of the workload as a table with the minimum, average and
+ * maximum over the ranks, the imbalance ratio and the ranks holding the
+ * extremes.
+ *
+ * @param output Stream to which the table is written
+ *
+ * @param n_ranks Number of ranks
+ *
+ * @param sections Statistics of the wall time of the timer sections
+ *
+ * @param workload Statistics of the workload indicators
+ */
+void
+write_load_balance_report(std::ostream &                            output,
+                          const unsigned int                        n_ranks,
+                          const std::vector<LoadBalanceStatistics> &sections,
+                          const std::vector<LoadBalanceStatistics> &workload);
+
+/**
+ * @brief print_load_balance_report Gathers the wall time of the timer
+ * sections and the workload indicators of all the ranks and prints their
+ * distribution. This function is collective over the communicator.
+ *
+ * @param section_times Wall time of each timer section on this rank, such as
+ * the summary of a TimerOutput
+ *
+ * @param workload Workload indicators of this rank, such as the number of
+ * locally owned cells
+ *
+ * @param mpi_communicator Communicator of the ranks
+ *
+ * @param pcout Stream to which the report is printed by the first rank
+ */
+void
+print_load_balance_report(const std::map<std::string, double> &section_times,
+                          const std::map<std::string, double> &workload,
+                          const MPI_Comm &                     mpi_communicator,
+                          ConditionalOStream &                 pcout);
+
+#endif
@@ -0,0 +1,154 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2020 -  by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_metrics_log_h
+#define lethe_metrics_log_h
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief The MetricsLog class writes one record of performance metrics per
+ * time step as a line of JSON (JSON lines format). The values of a record are
+ * added by key and the record is appended to the file when it is written, so
+ * the log can be read while the simulation is running and is complete up to
+ * the last time step if the simulation is interrupted.
+ *
+ * Cumulative quantities, such as the wall times of the timer sections, are
+ * logged as their increase since the previous record.
+ */
+class MetricsLog
+{
+public:
+  /**
+   * @brief Constructor of an empty log, which writes nothing
+   */
+  MetricsLog();
+
+  /**
+   * @brief Constructor for the MetricsLog
+   *
+   * @param filename Name of the file to which the records are written
+   *
+   * @param write_to_file Indicates if this process writes the file. The other
+   * processes drop the records when they are written.
+   *
+   * @param append Indicates if the records are appended to an existing file,
+   * for example when a simulation is restarted, instead of replacing it
+   */
+  MetricsLog(const std::string &filename,
+             const bool         write_to_file,
+             const bool         append);
+
+  /**
+   * @brief add Adds a number to the record. Integers are written exactly and
+   * the numbers which are not finite are written as null.
+   *
+   * @param key Name of the value
+   *
+   * @param value Value
+   */
+  template <typename Number>
+  void
+  add(const std::string &key, const Number value)
+  {
+    static_assert(std::is_arithmetic<Number>::value,
+                  "Only numbers can be added to the metrics log");
+    std::ostringstream field;
+    if (std::is_integral<Number>::value)
+      field << value;
+    else
+      write_number(field, static_cast<double>(value));
+    add_field(key, field.str());
+  }
+
+  /**
+   * @brief add Adds an array of integers to the record, such as the number of
+   * iterations of each linear solve of the time step
+   *
+   * @param key Name of the array
+   *
+   * @param values Values of the array
+   */
+  void
+  add(const std::string &key, const std::vector<unsigned int> &values);
+
+  /**
+   * @brief add_increments Adds an object of the increase of cumulative
+   * quantities since the previous record. A quantity which decreased, because
+   * it was reset, is logged with its present value.
+   *
+   * @param key Name of the object
+   *
+   * @param totals Present value of the cumulative quantities by name
+   */
+  void
+  add_increments(const std::string &                  key,
+                 const std::map<std::string, double> &totals);
+
+  /**
+   * @brief reset_increments Forgets the previous value of the cumulative
+   * quantities of an object, which must be called when they are reset, such
+   * as the timer summaries printed at every iteration
+   *
+   * @param key Name of the object
+   */
+  void
+  reset_increments(const std::string &key);
+
+  /**
+   * @brief write Appends the record to the file and starts a new one
+   */
+  void
+  write();
+
+private:
+  /**
+   * @brief Adds a value already formatted as JSON to the record
+   */
+  void
+  add_field(const std::string &key, const std::string &value);
+
+  /**
+   * @brief Writes a number with enough digits to be compared between records
+   */
+  static void
+  write_number(std::ostream &output, const double value);
+
+  /**
+   * @brief Returns a string as a JSON string, quotes included
+   */
+  static std::string
+  quote(const std::string &text);
+
+  std::unique_ptr<std::ofstream> output;
+
+  // Fields of the present record
+  std::string record;
+
+  // Previous value of the cumulative quantities of each object
+  std::map<std::string, std::map<std::string, double>> previous_totals;
+};
+
+#endif
@@ -90,7 +90,10 @@ NewtonNonLinearSolver<VectorType>::solve(
   while ((current_res > this->params.tolerance) &&
          outer_iteration < this->params.max_iterations)
     {
-      solver->evaluation_point = solver->present_solution;
+      // The evaluation point already holds the present solution after the
+      // first iteration, since it is where the line search left it
+      if (outer_iteration == 0)
+        solver->evaluation_point = solver->present_solution;
 
       solver->assemble_matrix_and_rhs(time_stepping_method);
 
@@ -98,6 +101,7 @@ NewtonNonLinearSolver<VectorType>::solve(
         {
           current_res = solver->system_rhs.l2_norm();
           last_res    = current_res;
+          solver->accept_non_linear_iterate(time_stepping_method, current_res);
         }
 
       if (this->params.verbosity != Parameters::Verbosity::quiet)
@@ -108,10 +112,16 @@ NewtonNonLinearSolver<VectorType>::solve(
 
       solver->solve_linear_system(first_step);
 
+      // The trial points of the line search are obtained by updating the
+      // local evaluation point in place with the difference between two
+      // successive relaxation factors instead of copying the present solution
+      double last_alpha              = 0.;
+      solver->local_evaluation_point = solver->present_solution;
       for (double alpha = 1.0; alpha > 1e-3; alpha *= 0.5)
         {
-          solver->local_evaluation_point = solver->present_solution;
-          solver->local_evaluation_point.add(alpha, solver->newton_update);
+          solver->local_evaluation_point.add(alpha - last_alpha,
+                                             solver->newton_update);
+          last_alpha = alpha;
           solver->apply_constraints();
           solver->evaluation_point = solver->local_evaluation_point;
           solver->assemble_rhs(time_stepping_method);
@@ -134,7 +144,9 @@ NewtonNonLinearSolver<VectorType>::solve(
 
       solver->present_solution = solver->evaluation_point;
       last_res                 = current_res;
+      solver->accept_non_linear_iterate(time_stepping_method, current_res);
       ++outer_iteration;
+      ++solver->solver_statistics.non_linear_iterations;
     }
 }
 
@@ -31,6 +31,7 @@
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/parsed_function.h>
+#include <deal.II/base/utilities.h>
 
 #ifndef lethe_parameters_h
 #  define lethe_parameters_h
@@ -96,6 +97,15 @@ namespace Parameters
     // Number of mesh adaptation (steady simulations)
     unsigned int number_mesh_adaptation;
 
+    // Pseudo-transient continuation of the steady non-linear solves
+    bool pseudo_transient;
+
+    // Initial CFL of the local pseudo-time step
+    double pseudo_cfl;
+
+    // Maximal CFL of the local pseudo-time step
+    double pseudo_max_cfl;
+
     // Folder for simulation output
     std::string output_folder;
 
@@ -123,6 +133,24 @@ namespace Parameters
     // Subdivisions of the results in the output
     unsigned int group_files;
 
+    // Write the results from a background thread while the simulation
+    // continues
+    bool asynchronous_output;
+
+    // Maximal size in megabytes of the results waiting to be written
+    unsigned int asynchronous_output_buffer;
+
+    // Format of the results. The vtu files are described by a pvd file and
+    // the hdf5 files by a xdmf file
+    enum class OutputFormat
+    {
+      vtu,
+      hdf5
+    } output_format;
+
+    // Compression of the hdf5 results
+    bool hdf5_compression;
+
     static void
     declare_parameters(ParameterHandler &prm);
     void
@@ -164,6 +192,17 @@ namespace Parameters
     };
 
     Type type;
+
+    // Enable the log of the performance metrics of each time step and prefix
+    // of its file
+    bool        write_metrics;
+    std::string metrics_output_name;
+
+    // Enable the report of the distribution of the timer sections and of the
+    // workload over the ranks and number of time steps between the reports
+    bool         report_load_balance;
+    unsigned int load_balance_frequency;
+
     static void
     declare_parameters(ParameterHandler &prm);
     void
@@ -241,6 +280,19 @@ namespace Parameters
     // Prefix for the enstrophy output
     std::string enstrophy_output_name;
 
+    // Enable the time-averaged statistics of the solution
+    bool calculate_time_averaged_statistics;
+
+    // Time from which the statistics are averaged
+    double statistics_initial_time;
+
+    // Frequency of the output of the statistics, which are otherwise only
+    // written at the end of the simulation
+    unsigned int statistics_output_frequency;
+
+    // Prefix for the statistics output
+    std::string statistics_output_name;
+
     static void
     declare_parameters(ParameterHandler &prm);
     void
@@ -269,6 +321,17 @@ namespace Parameters
     // Apply high order mapping everywhere
     bool qmapping_all;
 
+    // Renumbering of the degrees of freedom applied after their distribution.
+    // The automatic renumbering is the one each solver used to apply.
+    enum class DofRenumbering
+    {
+      automatic,
+      none,
+      cuthill_mckee,
+      hierarchical,
+      component_wise
+    } dof_renumbering;
+
     static void
     declare_parameters(ParameterHandler &prm);
     void
@@ -287,7 +350,9 @@ namespace Parameters
     {
       newton,
       skip_newton,
-      adaptative_newton
+      adaptative_newton,
+      picard,
+      jfnk
     };
 
     Verbosity verbosity;
@@ -307,6 +372,29 @@ namespace Parameters
     // Iterations to skip in the non-linear solver
     unsigned int skip_iterations;
 
+    // Policy used by the skip_newton solver to decide when the jacobian
+    // matrix and the preconditioner are rebuilt
+    enum class SkipPolicy
+    {
+      fixed,
+      adaptive
+    } skip_policy;
+
+    // Maximal residual contraction rate for which the jacobian matrix is kept
+    // with the adaptive skip policy
+    double skip_contraction_threshold;
+
+    // Number of previous iterates used by the Anderson acceleration of the
+    // picard solver
+    unsigned int anderson_depth;
+
+    // Relative tolerance of the Krylov solver of the jfnk solver
+    double jfnk_forcing_term;
+
+    // Non-linear iterations during which the jfnk solver keeps its
+    // preconditioner and the jacobian matrix from which it is built
+    unsigned int jfnk_preconditioner_lifetime;
+
     static void
     declare_parameters(ParameterHandler &prm);
     void
@@ -324,10 +412,30 @@ namespace Parameters
     {
       gmres,
       bicgstab,
-      amg
+      amg,
+      direct
     };
     SolverType solver;
 
+    // Amesos solver used by the direct method
+    std::string direct_solver_type;
+
+    // Maximal dimension of the Krylov subspace recycled between successive
+    // solutions. Recycling is disabled if it is zero
+    unsigned int krylov_recycling_vectors;
+
+    // Parallel vector used for the solution and the right-hand side
+    enum class VectorBackend
+    {
+      trilinos,
+      dealii
+    };
+    VectorBackend vector_backend;
+
+    // Select the solver and its preconditioner parameters by timing a few
+    // configurations on the first linear system
+    bool autotune;
+
     Verbosity verbosity;
 
     // Residual precision
@@ -342,6 +450,9 @@ namespace Parameters
     // Maximum number of iterations
     int max_iterations;
 
+    // Dimension of the Krylov subspace of the GMRES solvers before a restart
+    unsigned int max_krylov_vectors;
+
     // ILU or ILUT fill
     double ilu_precond_fill;
 
@@ -351,6 +462,17 @@ namespace Parameters
     // ILU or ILUT relative tolerance
     double ilu_precond_rtol;
 
+    // Floating point precision in which the ILU factors are stored
+    enum class Precision
+    {
+      double_precision,
+      single_precision
+    } ilu_precision;
+
+    // Off-diagonals added on each side of the diagonal to the pattern of the
+    // single precision ILU factors, which replace the levels of fill
+    unsigned int ilu_precond_off_diagonals;
+
     // ILU or ILUT fill
     double amg_precond_ilu_fill;
 
@@ -406,6 +528,13 @@ namespace Parameters
     // Initial refinement level of primitive mesh
     unsigned int initial_refinement;
 
+    // Enables the cache of the refined and partitioned mesh, which is loaded
+    // instead of reading and refining the mesh again when it is still valid
+    bool use_cache;
+
+    // Prefix of the files of the mesh cache
+    std::string cache_file_name;
+
     static void
     declare_parameters(ParameterHandler &prm);
     void
@@ -491,6 +620,15 @@ namespace Parameters
     bool         restart;
     bool         checkpoint;
     unsigned int frequency;
+
+    // Number of checkpoints kept, the oldest one being overwritten
+    unsigned int n_generations;
+
+    // Wall time allowed to the simulation in seconds, 0 for no limit, and
+    // time before this limit at which a checkpoint is written
+    double walltime;
+    double walltime_checkpoint_margin;
+
     static void
     declare_parameters(ParameterHandler &prm);
     void
@@ -523,5 +661,71 @@ namespace Parameters
     parse_parameters(ParameterHandler &prm);
   };
 
+
+  /**
+   * @brief Ensemble - Variants of a simulation which are solved in sequence
+   * on the same mesh and degrees of freedom. Each list contains one value per
+   * variant, an empty list keeping the value of the parameter file for all
+   * the variants.
+   */
+  struct Ensemble
+  {
+    // Kinematic viscosity of each variant
+    std::vector<double> viscosities;
+
+    // Factor applied to the velocity imposed by the function boundary
+    // conditions of each variant
+    std::vector<double> velocity_scales;
+
+    // Factor applied to the angular velocity of the velocity source of each
+    // variant
+    std::vector<double> angular_velocity_scales;
+
+    // Number of variants. No ensemble is solved if it is zero.
+    unsigned int n_variants;
+
+    static void
+    declare_parameters(ParameterHandler &prm);
+    void
+    parse_parameters(ParameterHandler &prm);
+  };
+
+  /**
+   * @brief Probes - Sampling of the velocity and the pressure at points, along
+   * lines and on planes. Each probe is described by the comma-separated values
+   * of its coordinates and numbers of samples, the probes being separated by
+   * semicolons. The number of coordinates of the points and vectors is the
+   * dimension of the problem.
+   */
+  struct Probes
+  {
+    // Enable the sampling of the probes
+    bool enable;
+
+    // Frequency of the sampling in iterations
+    unsigned int frequency;
+
+    // Prefix of the output files
+    std::string output_name;
+
+    // Number of digits of the sampled values
+    unsigned int precision;
+
+    // Points sampled individually: x, y (, z)
+    std::vector<std::vector<double>> points;
+
+    // Lines: start point, end point and number of samples
+    std::vector<std::vector<double>> lines;
+
+    // Planes: origin, first and second edge vectors and number of samples
+    // along each edge
+    std::vector<std::vector<double>> planes;
+
+    static void
+    declare_parameters(ParameterHandler &prm);
+    void
+    parse_parameters(ParameterHandler &prm);
+  };
+
 } // namespace Parameters
 #endif
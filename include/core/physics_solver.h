@@ -22,11 +22,48 @@
 
 #include <deal.II/lac/affine_constraints.h>
 
+#include "jfnk_non_linear_solver.h"
 #include "newton_non_linear_solver.h"
 #include "non_linear_solver.h"
 #include "parameters.h"
+#include "picard_non_linear_solver.h"
 #include "skip_newton_non_linear_solver.h"
 
+#include <vector>
+
+/**
+ * @brief SolverStatistics. Work done by the non-linear and linear solvers of
+ * a physics solver since the statistics were last reset, which is reported by
+ * the metrics log of the simulation.
+ */
+struct SolverStatistics
+{
+  SolverStatistics()
+  {
+    reset();
+  }
+
+  void
+  reset()
+  {
+    non_linear_iterations = 0;
+    linear_iterations.clear();
+    preconditioner_setups = 0;
+    preconditioner_reuses = 0;
+  }
+
+  // Iterations of the non-linear solver
+  unsigned int non_linear_iterations;
+
+  // Iterations of each solve with an iterative linear solver
+  std::vector<unsigned int> linear_iterations;
+
+  // Number of linear solves for which the preconditioner, or the
+  // factorization of a direct solver, was built or reused
+  unsigned int preconditioner_setups;
+  unsigned int preconditioner_reuses;
+};
+
 /**
  * This interface class is used to house all the common elements of physics
  * solver. A physics solver is an implementation of a linear or non-linear set
@@ -95,12 +132,109 @@ public:
     const bool first_iteration,
     const bool force_matrix_renewal);
 
+  /**
+   * @brief Called before each solution of the non-linear system of equations,
+   * before the initial residual is assembled
+   *
+   * @param time_stepping_method Time-Stepping method of the solution
+   */
+  virtual void
+  start_non_linear_solve(const Parameters::SimulationControl::TimeSteppingMethod
+                         /*time_stepping_method*/)
+  {}
+
+  /**
+   * @brief Called by the non-linear solvers once for the initial guess and
+   * once for each accepted iterate, with the present solution and its
+   * residual in system_rhs. The trial points of the line searches and the
+   * residuals evaluated by the jacobian-free products are not accepted
+   * iterates.
+   *
+   * @param time_stepping_method Time-Stepping method of the solution
+   *
+   * @param residual Norm of the residual of the accepted iterate
+   */
+  virtual void
+  accept_non_linear_iterate(
+    const Parameters::SimulationControl::TimeSteppingMethod
+    /*time_stepping_method*/,
+    const double /*residual*/)
+  {}
+
   virtual void
   apply_constraints()
   {
     nonzero_constraints.distribute(local_evaluation_point);
   }
 
+  /**
+   * @brief Builds the preconditioner of the linear system from the last
+   * assembled matrix. This is used by the jacobian-free non-linear solvers,
+   * which do not call solve_linear_system.
+   */
+  virtual void
+  setup_preconditioner()
+  {}
+
+  /**
+   * @brief Releases the storage of the assembled matrix once
+   * setup_preconditioner has built a preconditioner which does not refer to
+   * it. This is used by the jacobian-free non-linear solvers, which never
+   * multiply by the matrix. The matrix is allocated again by the next call to
+   * assemble_matrix_and_rhs.
+   */
+  virtual void
+  release_system_matrix()
+  {}
+
+  /**
+   * @brief Applies the preconditioner built by setup_preconditioner to a vector.
+   * The default preconditioner is the identity.
+   *
+   * @param dst Preconditioned vector
+   *
+   * @param src Vector to which the preconditioner is applied
+   */
+  virtual void
+  apply_preconditioner(VectorType &dst, const VectorType &src)
+  {
+    dst = src;
+  }
+
+  /**
+   * @brief Indicates if a preconditioner built by setup_preconditioner is
+   * available for the present degrees of freedom. Physics solvers that clear
+   * their preconditioner when the mesh changes return false until it is
+   * rebuilt.
+   */
+  virtual bool
+  is_preconditioner_available() const
+  {
+    return true;
+  }
+
+  /**
+   * @brief Maximal number of iterations of the Krylov solvers of the
+   * jacobian-free non-linear solvers. The physics solvers return the setting
+   * of their linear solver.
+   */
+  virtual unsigned int
+  get_krylov_max_iterations() const
+  {
+    return 1000;
+  }
+
+  /**
+   * @brief Dimension of the Krylov subspace of the GMRES solvers of the
+   * jacobian-free non-linear solvers before they restart. The physics solvers
+   * return the setting of their linear solver.
+   */
+  virtual unsigned int
+  get_krylov_max_vectors() const
+  {
+    return 30;
+  }
+
   // TODO std::unique or std::shared pointer
   NonLinearSolver<VectorType> *non_linear_solver;
 
@@ -112,6 +246,15 @@ public:
 
   AffineConstraints<double> nonzero_constraints;
 
+  SolverStatistics solver_statistics;
+
+  // Set by the fixed-point non-linear solvers while they call
+  // assemble_matrix_and_rhs. The matrix is then the Picard linearization of
+  // the equations instead of their jacobian matrix: for the Navier-Stokes
+  // equations, the present iterate is the advecting velocity and the
+  // derivative of the advection with respect to it is dropped (Oseen).
+  bool picard_linearization;
+
   ConditionalOStream pcout;
 };
 
@@ -119,6 +262,7 @@ template <typename VectorType>
 PhysicsSolver<VectorType>::PhysicsSolver(
   NonLinearSolver<VectorType> *non_linear_solver)
   : non_linear_solver(non_linear_solver) // Default copy ctor
+  , picard_linearization(false)
   , pcout({std::cout, Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0})
 {}
 
@@ -127,7 +271,8 @@ PhysicsSolver<VectorType>::PhysicsSolver(
 template <typename VectorType>
 PhysicsSolver<VectorType>::PhysicsSolver(
   Parameters::NonLinearSolver non_linear_solver_parameters)
-  : pcout({std::cout, Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0})
+  : picard_linearization(false)
+  , pcout({std::cout, Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0})
 {
   switch (non_linear_solver_parameters.solver)
     {
@@ -140,6 +285,16 @@ PhysicsSolver<VectorType>::PhysicsSolver(
         non_linear_solver = new SkipNewtonNonLinearSolver<VectorType>(
           this, non_linear_solver_parameters);
         break;
+      case Parameters::NonLinearSolver::SolverType::jfnk:
+        non_linear_solver =
+          new JFNKNonLinearSolver<VectorType>(this,
+                                              non_linear_solver_parameters);
+        break;
+      case Parameters::NonLinearSolver::SolverType::picard:
+        non_linear_solver =
+          new PicardNonLinearSolver<VectorType>(this,
+                                                non_linear_solver_parameters);
+        break;
       default:
         break;
     }
@@ -152,6 +307,7 @@ PhysicsSolver<VectorType>::solve_non_linear_system(
   const bool                                              first_iteration,
   const bool                                              force_matrix_renewal)
 {
+  start_non_linear_solve(time_stepping_method);
   this->non_linear_solver->solve(time_stepping_method,
                                  first_iteration,
                                  force_matrix_renewal);
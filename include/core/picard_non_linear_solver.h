@@ -0,0 +1,344 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2019 - 2020 by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_picard_non_linear_solver_h
+#define lethe_picard_non_linear_solver_h
+
+#include <deal.II/lac/full_matrix.h>
+
+#include "non_linear_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief PicardNonLinearSolver. Non-linear solver for non-linear systems of equations which uses a
+ * fixed-point (Picard) iteration accelerated by Anderson mixing. At every
+ * iteration, the operator is the Picard linearization of the equations at the
+ * present iterate, which the physics solver assembles when its
+ * picard_linearization flag is set. For the Navier-Stokes equations, this is
+ * the Oseen operator in which the present iterate advects the velocity,
+ * without the derivative of the advection with respect to the advecting
+ * velocity. Its fixed-point iteration converges from a much larger set of
+ * initial guesses than the Newton method, linearly, and the Anderson mixing
+ * of the previous iterates recovers a faster convergence.
+ *
+ * When an accelerated iterate does not decrease the residual, it is replaced
+ * by a relaxed fixed-point step and the history is cleared.
+ */
+template <typename VectorType>
+class PicardNonLinearSolver : public NonLinearSolver<VectorType>
+{
+public:
+  /**
+   * @brief Constructor for the PicardNonLinearSolver.
+   *
+   * @param physics_solver A pointer to the physics solver to which the non-linear solver is attached
+   *
+   * @param param Non-linear solver parameters. The anderson_depth parameter
+   * controls the number of previous iterates used for the acceleration. A
+   * depth of zero leads to an unaccelerated fixed-point iteration.
+   *
+   */
+  PicardNonLinearSolver(PhysicsSolver<VectorType> *        physics_solver,
+                        const Parameters::NonLinearSolver &param);
+
+  /**
+   * @brief Solve the non-linear system of equation.
+   *
+   * @param time_stepping_method Time stepping method being used. This is
+   * required since the jacobian of the matrix is going to depend on the method
+   * used
+   *
+   * @param is_initial_step Boolean variable that controls which constraints are
+   * going to be applied to the equations
+   */
+  void
+  solve(const Parameters::SimulationControl::TimeSteppingMethod
+                   time_stepping_method,
+        const bool is_initial_step,
+        const bool force_matrix_renewal = true) override;
+
+private:
+  /**
+   * @brief Assembles the Picard linearization of the equations at the
+   * evaluation point and their right-hand side
+   *
+   * @param time_stepping_method Time stepping method being used
+   */
+  void
+  assemble_picard_matrix_and_rhs(
+    const Parameters::SimulationControl::TimeSteppingMethod
+      time_stepping_method);
+
+  /**
+   * @brief Calculates the Anderson mixing coefficients
+   * The coefficients minimize || update - sum_i gamma_i delta_f_i ||. The
+   * least-squares problem is solved through its normal equations using a
+   * Cholesky factorization in which the history entries that are linearly
+   * dependent on more recent ones are discarded (their coefficient is zero).
+   *
+   * @param update The fixed-point update of the present iteration
+   */
+  std::vector<double>
+  calculate_anderson_coefficients(const VectorType &update) const;
+
+  // History of the differences between successive iterates and between
+  // successive fixed-point updates. The most recent entry is stored first.
+  std::vector<VectorType> delta_x;
+  std::vector<VectorType> delta_f;
+  unsigned int            n_history;
+
+  // Iterate and fixed-point update of the previous iteration
+  VectorType previous_solution;
+  VectorType previous_update;
+};
+
+template <typename VectorType>
+PicardNonLinearSolver<VectorType>::PicardNonLinearSolver(
+  PhysicsSolver<VectorType> *        physics_solver,
+  const Parameters::NonLinearSolver &params)
+  : NonLinearSolver<VectorType>(physics_solver, params)
+  , n_history(0)
+{}
+
+template <typename VectorType>
+void
+PicardNonLinearSolver<VectorType>::assemble_picard_matrix_and_rhs(
+  const Parameters::SimulationControl::TimeSteppingMethod time_stepping_method)
+{
+  PhysicsSolver<VectorType> *solver = this->physics_solver;
+  solver->picard_linearization      = true;
+  solver->assemble_matrix_and_rhs(time_stepping_method);
+  solver->picard_linearization = false;
+}
+
+template <typename VectorType>
+std::vector<double>
+PicardNonLinearSolver<VectorType>::calculate_anderson_coefficients(
+  const VectorType &update) const
+{
+  const unsigned int m = n_history;
+
+  FullMatrix<double>  normal_matrix(m, m);
+  std::vector<double> rhs(m);
+  for (unsigned int i = 0; i < m; ++i)
+    {
+      for (unsigned int j = 0; j <= i; ++j)
+        {
+          normal_matrix(i, j) = delta_f[i] * delta_f[j];
+          normal_matrix(j, i) = normal_matrix(i, j);
+        }
+      rhs[i] = delta_f[i] * update;
+    }
+
+  // Cholesky factorization with dropping of the dependent entries
+  FullMatrix<double> L(m, m);
+  std::vector<bool>  kept(m, false);
+  for (unsigned int j = 0; j < m; ++j)
+    {
+      double diagonal = normal_matrix(j, j);
+      for (unsigned int k = 0; k < j; ++k)
+        if (kept[k])
+          diagonal -= L(j, k) * L(j, k);
+
+      if (diagonal <= 1e-10 * normal_matrix(j, j))
+        continue;
+
+      kept[j] = true;
+      L(j, j) = std::sqrt(diagonal);
+      for (unsigned int i = j + 1; i < m; ++i)
+        {
+          double value = normal_matrix(i, j);
+          for (unsigned int k = 0; k < j; ++k)
+            if (kept[k])
+              value -= L(i, k) * L(j, k);
+          L(i, j) = value / L(j, j);
+        }
+    }
+
+  // Forward and backward substitutions on the kept entries
+  std::vector<double> y(m, 0.);
+  for (unsigned int i = 0; i < m; ++i)
+    {
+      if (!kept[i])
+        continue;
+      double value = rhs[i];
+      for (unsigned int k = 0; k < i; ++k)
+        if (kept[k])
+          value -= L(i, k) * y[k];
+      y[i] = value / L(i, i);
+    }
+
+  std::vector<double> gamma(m, 0.);
+  for (unsigned int i = m; i-- > 0;)
+    {
+      if (!kept[i])
+        continue;
+      double value = y[i];
+      for (unsigned int k = i + 1; k < m; ++k)
+        if (kept[k])
+          value -= L(k, i) * gamma[k];
+      gamma[i] = value / L(i, i);
+    }
+
+  return gamma;
+}
+
+template <typename VectorType>
+void
+PicardNonLinearSolver<VectorType>::solve(
+  const Parameters::SimulationControl::TimeSteppingMethod time_stepping_method,
+  const bool                                              is_initial_step,
+  const bool)
+{
+  double       current_res;
+  double       last_res;
+  bool         first_step      = is_initial_step;
+  unsigned int outer_iteration = 0;
+  last_res                     = 1.0;
+  current_res                  = 1.0;
+
+  PhysicsSolver<VectorType> *solver = this->physics_solver;
+
+  // The history is sized on the present layout of the solution, which may
+  // have changed since the last call because of mesh adaptation
+  const unsigned int depth = this->params.anderson_depth;
+  delta_x.resize(depth);
+  delta_f.resize(depth);
+  for (unsigned int i = 0; i < depth; ++i)
+    {
+      delta_x[i].reinit(solver->newton_update);
+      delta_f[i].reinit(solver->newton_update);
+    }
+  previous_solution.reinit(solver->newton_update);
+  previous_update.reinit(solver->newton_update);
+  n_history = 0;
+
+  bool previous_available = false;
+
+  solver->evaluation_point       = solver->present_solution;
+  solver->local_evaluation_point = solver->present_solution;
+
+  while ((current_res > this->params.tolerance) &&
+         outer_iteration < this->params.max_iterations)
+    {
+      // The operator depends on the present iterate, which advects the
+      // velocity, so it is assembled at every iteration
+      assemble_picard_matrix_and_rhs(time_stepping_method);
+
+      if (outer_iteration == 0)
+        {
+          current_res = solver->system_rhs.l2_norm();
+          last_res    = current_res;
+          solver->accept_non_linear_iterate(time_stepping_method, current_res);
+        }
+
+      if (this->params.verbosity != Parameters::Verbosity::quiet)
+        {
+          solver->pcout << "Picard iteration: " << outer_iteration
+                        << "  - Residual:  " << current_res << std::endl;
+        }
+
+      solver->solve_linear_system(first_step, true);
+
+      // Store the differences with the previous iteration in the history,
+      // recycling the storage of the oldest entry
+      if (depth > 0 && previous_available)
+        {
+          std::rotate(delta_x.begin(), delta_x.end() - 1, delta_x.end());
+          std::rotate(delta_f.begin(), delta_f.end() - 1, delta_f.end());
+          delta_x[0] = solver->local_evaluation_point;
+          delta_x[0] -= previous_solution;
+          delta_f[0] = solver->newton_update;
+          delta_f[0] -= previous_update;
+          n_history = std::min(n_history + 1, depth);
+        }
+      previous_solution  = solver->local_evaluation_point;
+      previous_update    = solver->newton_update;
+      previous_available = true;
+
+      // Anderson mixing of the fixed-point update with the history
+      const std::vector<double> gamma =
+        calculate_anderson_coefficients(solver->newton_update);
+
+      solver->local_evaluation_point.add(1.0, solver->newton_update);
+      for (unsigned int i = 0; i < n_history; ++i)
+        {
+          solver->local_evaluation_point.add(-gamma[i], delta_x[i]);
+          solver->local_evaluation_point.add(-gamma[i], delta_f[i]);
+        }
+      solver->apply_constraints();
+      solver->evaluation_point = solver->local_evaluation_point;
+      solver->assemble_rhs(time_stepping_method);
+
+      current_res = solver->system_rhs.l2_norm();
+
+      if (this->params.verbosity != Parameters::Verbosity::quiet)
+        {
+          solver->pcout << "\t\tanderson depth = " << n_history << " res = "
+                        << std::setprecision(this->params.display_precision)
+                        << current_res << std::endl;
+        }
+
+      // If the accelerated iterate does not decrease the residual, fall back
+      // on a relaxed fixed-point step and restart the acceleration
+      if (current_res >= last_res && last_res > this->params.tolerance)
+        {
+          double last_alpha              = 0.;
+          solver->local_evaluation_point = previous_solution;
+          for (double alpha = 1.0; alpha > 1e-3; alpha *= 0.5)
+            {
+              solver->local_evaluation_point.add(alpha - last_alpha,
+                                                 previous_update);
+              last_alpha = alpha;
+              solver->apply_constraints();
+              solver->evaluation_point = solver->local_evaluation_point;
+              solver->assemble_rhs(time_stepping_method);
+
+              current_res = solver->system_rhs.l2_norm();
+
+              if (this->params.verbosity != Parameters::Verbosity::quiet)
+                {
+                  solver->pcout
+                    << "\t\talpha = " << std::setw(6) << alpha << std::setw(0)
+                    << " res = "
+                    << std::setprecision(this->params.display_precision)
+                    << current_res << std::endl;
+                }
+
+              if (current_res < 0.9 * last_res)
+                break;
+            }
+          // The relaxed step is not an iterate of the fixed-point map, so
+          // the differences with it are not used by the acceleration
+          n_history          = 0;
+          previous_available = false;
+        }
+
+      solver->present_solution = solver->evaluation_point;
+      last_res                 = current_res;
+      solver->accept_non_linear_iterate(time_stepping_method, current_res);
+      ++outer_iteration;
+      ++solver->solver_statistics.non_linear_iterations;
+    }
+}
+
+#endif
@@ -40,6 +40,14 @@ public:
   void
   save(std::string filename);
 
+  /**
+   * @brief save Writes the content of the pvd times_and_names to a stream
+   *
+   * @param output Stream to which the PVDHandler content is written
+   */
+  void
+  save(std::ostream &output) const;
+
   /**
    * @brief read Reads the content of a pvd times_and_names checpoint
    *
@@ -264,6 +264,14 @@ public:
 
   void
   save(std::string filename);
+
+  /**
+   * @brief save Writes the state of the simulation control to a stream, which
+   * is the content of the file written by save(filename)
+   */
+  void
+  save(std::ostream &output) const;
+
   void
   read(std::string filename);
 };
@@ -7,7 +7,9 @@
  * @brief SkipNewtonNonlinearSolver. Non-linear solver for non-linear systems of equations which uses a Newton
  * method with \alpha relaxation to ensure that the residual is monotonically
  * decreasing. This non-linear solver only recalculates the jacobian matrix at a
- * given frequency.
+ * given frequency. With the adaptive skip policy, the jacobian matrix is
+ * instead kept as long as the residual contracts fast enough and is
+ * recalculated as soon as convergence stalls or the line search is needed.
  */
 template <typename VectorType>
 class SkipNewtonNonLinearSolver : public NonLinearSolver<VectorType>
@@ -39,6 +41,10 @@ public:
 private:
   const Parameters::NonLinearSolver parameters;
   unsigned int                      consecutive_iters;
+
+  // Set by the adaptive skip policy when the last non-linear iteration asked
+  // for the jacobian matrix to be recalculated
+  bool jacobian_renewal_requested;
 };
 
 template <typename VectorType>
@@ -48,6 +54,7 @@ SkipNewtonNonLinearSolver<VectorType>::SkipNewtonNonLinearSolver(
   : NonLinearSolver<VectorType>(physics_solver, params)
   , parameters(params)
   , consecutive_iters(0)
+  , jacobian_renewal_requested(true)
 {}
 
 template <typename VectorType>
@@ -64,15 +71,24 @@ SkipNewtonNonLinearSolver<VectorType>::solve(
   last_res                     = 1.0;
   current_res                  = 1.0;
 
-  bool assembly_needed =
-    consecutive_iters == 0 || is_initial_step || force_matrix_renewal;
+  const bool adaptive_skip =
+    parameters.skip_policy == Parameters::NonLinearSolver::SkipPolicy::adaptive;
+
+  bool assembly_needed = is_initial_step || force_matrix_renewal;
+  if (adaptive_skip)
+    assembly_needed = assembly_needed || jacobian_renewal_requested;
+  else
+    assembly_needed = assembly_needed || consecutive_iters == 0;
 
   PhysicsSolver<VectorType> *solver = this->physics_solver;
 
   while ((current_res > this->params.tolerance) &&
          outer_iteration < this->params.max_iterations)
     {
-      solver->evaluation_point = solver->present_solution;
+      // After the first iteration, the line search has already left the
+      // present solution in the evaluation point
+      if (outer_iteration == 0)
+        solver->evaluation_point = solver->present_solution;
 
       if (assembly_needed)
         solver->assemble_matrix_and_rhs(time_stepping_method);
@@ -84,6 +100,7 @@ SkipNewtonNonLinearSolver<VectorType>::solve(
         {
           current_res = solver->system_rhs.l2_norm();
           last_res    = current_res;
+          solver->accept_non_linear_iterate(time_stepping_method, current_res);
         }
 
       if (this->params.verbosity != Parameters::Verbosity::quiet)
@@ -94,10 +111,16 @@ SkipNewtonNonLinearSolver<VectorType>::solve(
 
       solver->solve_linear_system(first_step, assembly_needed);
 
+      // Line search trial points are updated in place
+      double last_alpha              = 0.;
+      bool   line_search_used        = false;
+      solver->local_evaluation_point = solver->present_solution;
       for (double alpha = 1.0; alpha > 1e-3; alpha *= 0.5)
         {
-          solver->local_evaluation_point = solver->present_solution;
-          solver->local_evaluation_point.add(alpha, solver->newton_update);
+          solver->local_evaluation_point.add(alpha - last_alpha,
+                                             solver->newton_update);
+          last_alpha       = alpha;
+          line_search_used = alpha < 1.0;
           solver->apply_constraints();
           solver->evaluation_point = solver->local_evaluation_point;
           solver->assemble_rhs(time_stepping_method);
@@ -118,12 +141,41 @@ SkipNewtonNonLinearSolver<VectorType>::solve(
             }
         }
 
+      // With the adaptive policy, the jacobian matrix is kept for the next
+      // iteration only if the present one contracted the residual enough
+      // without the help of the line search
+      if (adaptive_skip)
+        {
+          // A zero residual is already converged and contracts infinitely
+          const double contraction_rate =
+            last_res > 0 ? current_res / last_res : 0.;
+          jacobian_renewal_requested =
+            line_search_used ||
+            contraction_rate > parameters.skip_contraction_threshold;
+
+          if (this->params.verbosity != Parameters::Verbosity::quiet)
+            {
+              solver->pcout << "\t\tcontraction rate = "
+                            << std::setprecision(this->params.display_precision)
+                            << contraction_rate;
+              if (line_search_used)
+                solver->pcout << " - line search used, jacobian renewed";
+              else if (jacobian_renewal_requested)
+                solver->pcout << " - convergence stalled, jacobian renewed";
+              else
+                solver->pcout << " - jacobian kept";
+              solver->pcout << std::endl;
+            }
+        }
+
       solver->present_solution = solver->evaluation_point;
       last_res                 = current_res;
+      solver->accept_non_linear_iterate(time_stepping_method, current_res);
       ++outer_iteration;
-      assembly_needed = false;
+      ++solver->solver_statistics.non_linear_iterations;
+      assembly_needed = adaptive_skip && jacobian_renewal_requested;
     }
-  if (!force_matrix_renewal)
+  if (!force_matrix_renewal && !adaptive_skip)
     {
       consecutive_iters++;
       consecutive_iters = consecutive_iters % parameters.skip_iterations;
@@ -25,7 +25,9 @@
 
 
 // Lethe includes
+#include <core/async_output_writer.h>
 #include <core/pvd_handler.h>
+#include <core/xdmf_handler.h>
 
 using namespace dealii;
 
@@ -66,6 +68,80 @@ write_vtu_and_pvd(PVDHandler &                           pvd_handler,
                   const MPI_Comm &                       mpi_communicator,
                   const unsigned int                     digits = 4);
 
+/**
+ * @brief Output the data out to one vtu file per process, with a pvtu file and a pvd to store the timing, through an asynchronous writer
+ * The content of the files is produced in memory and the files are written by
+ * the background thread of the output writer, which allows the simulation to
+ * continue while they are written. Since the background thread does not
+ * communicate, every process writes its own vtu file instead of grouping the
+ * files with MPI-IO.
+ *
+ * @param output_writer The AsyncOutputWriter which writes the files
+ *
+ * @param pvd_handler a PVDHandler to store the information about the file name and time associated with it
+ *
+ * @param data_out the DataOut class to which the data has been attached
+ *
+ * @param folder a string that contains the path where the results are to be saved
+ *
+ * @param file_prefix a string that stores the name of the file without the iteration number and the extension
+ *
+ * @param time the time associated with the file
+ *
+ * @param iter the iteration number associated with the file
+ *
+ * @param mpi_communicator The mpi communicator
+ *
+ * @param digits An optional parameter that specifies the amount of digit used to store iteration number in the file name
+ */
+template <int dim, int spacedim = dim>
+void
+write_vtu_and_pvd(AsyncOutputWriter &                    output_writer,
+                  PVDHandler &                           pvd_handler,
+                  const DataOutInterface<dim, spacedim> &data_out,
+                  const std::string                      folder,
+                  const std::string                      file_prefix,
+                  const double                           time,
+                  const unsigned int                     iter,
+                  const MPI_Comm &                       mpi_communicator,
+                  const unsigned int                     digits = 4);
+
+/**
+ * @brief Output the data out to a single hdf5 file, with a xdmf file to store the timing
+ * This function outputs the data out of all the processes to a single hdf5
+ * file with collective MPI-IO. The xdmf file describes the hdf5 file of every
+ * output of the time series.
+ *
+ * @param xdmf_handler a XDMFHandler to store the description of the hdf5 files
+ *
+ * @param data_out the DataOut class to which the data has been attached. Its hdf5 flags are set to enable the compression
+ *
+ * @param folder a string that contains the path where the results are to be saved
+ *
+ * @param file_prefix a string that stores the name of the file without the iteration number and the extension
+ *
+ * @param time the time associated with the file
+ *
+ * @param iter the iteration number associated with the file
+ *
+ * @param compression Enables the compression of the hdf5 file
+ *
+ * @param mpi_communicator The mpi communicator
+ *
+ * @param digits An optional parameter that specifies the amount of digit used to store iteration number in the file name
+ */
+template <int dim, int spacedim = dim>
+void
+write_hdf5_and_xdmf(XDMFHandler &                    xdmf_handler,
+                    DataOutInterface<dim, spacedim> &data_out,
+                    const std::string                folder,
+                    const std::string                file_prefix,
+                    const double                     time,
+                    const unsigned int               iter,
+                    const bool                       compression,
+                    const MPI_Comm &                 mpi_communicator,
+                    const unsigned int               digits = 4);
+
 /**
  * @brief Output the Data Out Faces to a single vtu file
  * This function outputs the DataOutFaces to a vtu file.
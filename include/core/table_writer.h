@@ -0,0 +1,141 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2020 -  by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_table_writer_h
+#define lethe_table_writer_h
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The TableWriter class writes a table of post-processing values to a
+ * text file in an append-only fashion. The rows are buffered and only the rows
+ * which were added since the last flush are appended to the file, after which
+ * they are dropped from memory. The cost of writing the table is thus
+ * proportional to the number of new rows instead of growing with the length of
+ * the simulation.
+ *
+ * The number of rows written to the file can be saved in a checkpoint. When a
+ * simulation is restarted, the rows written after the checkpoint are removed
+ * from the file and the new rows are appended after the ones of the
+ * checkpoint.
+ */
+class TableWriter
+{
+public:
+  /**
+   * @brief Constructor of an empty writer, which must be assigned a writer
+   * with a file before rows are added
+   */
+  TableWriter();
+
+  /**
+   * @brief Constructor for the TableWriter
+   *
+   * @param filename Name of the file to which the table is written
+   *
+   * @param column_names Name of the columns, written as the header of the file
+   *
+   * @param precision Number of digits of the values
+   *
+   * @param write_to_file Indicates if this process writes the file. The other
+   * processes drop the rows when they are flushed.
+   *
+   * @param max_buffered_rows Number of buffered rows after which the rows are
+   * flushed to the file
+   */
+  TableWriter(const std::string &             filename,
+              const std::vector<std::string> &column_names,
+              const unsigned int              precision,
+              const bool                      write_to_file,
+              const unsigned int              max_buffered_rows = 1000);
+
+  /**
+   * @brief add_row Adds a row to the table. The row is written to the file
+   * at the next flush
+   *
+   * @param values Values of the row, one for each column
+   */
+  void
+  add_row(const std::vector<double> &values);
+
+  /**
+   * @brief flush Appends the buffered rows to the file and drops them from
+   * memory. The header is written when the file is created.
+   */
+  void
+  flush();
+
+  /**
+   * @brief save Flushes the buffered rows and saves the number of rows of the
+   * file to a checkpoint
+   *
+   * @param prefix Prefix of the checkpoint file
+   */
+  void
+  save(const std::string &prefix);
+
+  /**
+   * @brief save Flushes the buffered rows and writes the number of rows of the
+   * file to a stream, which is the content of the checkpoint file
+   *
+   * @param output Stream to which the number of rows is written
+   */
+  void
+  save(std::ostream &output);
+
+  /**
+   * @brief read Reads the number of rows of a checkpoint and removes the rows
+   * which were written after the checkpoint from the file. The following rows
+   * are appended to the ones of the checkpoint. If the checkpoint does not
+   * hold the number of rows, the following rows are appended to the file as
+   * it is.
+   *
+   * @param prefix Prefix of the checkpoint file
+   */
+  void
+  read(const std::string &prefix);
+
+  /**
+   * @brief Returns the number of rows written to the file
+   */
+  unsigned int
+  n_written_rows() const
+  {
+    return written_rows;
+  }
+
+private:
+  std::string              filename;
+  std::vector<std::string> column_names;
+  unsigned int             precision;
+  bool                     write_to_file;
+  unsigned int             max_buffered_rows;
+
+  // Rows which were added since the last flush
+  std::vector<std::vector<double>> buffered_rows;
+
+  // Number of rows of the file. The file and its header are created by the
+  // first flush when it does not contain any row.
+  unsigned int written_rows;
+  bool         file_created;
+};
+
+#endif
@@ -0,0 +1,95 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2020 -  by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_xdmf_handler_h
+#define lethe_xdmf_handler_h
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace dealii;
+
+/**
+ * @brief The XDMFHandler class manages the storage of the information required
+ * to write the xdmf file of hdf5 results. Like the PVDHandler, it is
+ * serialized with the checkpoints so that the xdmf output continues after a
+ * restart.
+ *
+ * The xdmf file is written completely only once. The entries of the
+ * following outputs are appended to it, which keeps the cost of an output
+ * independent of the number of outputs which preceded it.
+ */
+class XDMFHandler
+{
+public:
+  XDMFHandler();
+
+  /**
+   * @brief write_xdmf_file Writes the entries which are not yet in the xdmf
+   * file. The whole file is written by the first call and after a restart,
+   * since the file may then hold the entries of outputs which followed the
+   * checkpoint. Only the first process writes the file.
+   *
+   * @param filename Name of the xdmf file
+   *
+   * @param mpi_communicator Communicator of the processes which write the
+   * results
+   */
+  void
+  write_xdmf_file(const std::string &filename,
+                  const MPI_Comm &   mpi_communicator);
+
+  /**
+   * @brief save Saves the xdmf entries to a file
+   *
+   * @param prefix Prefix of the file to which the XDMFHandler content is saved
+   */
+  void
+  save(const std::string &prefix) const;
+
+  /**
+   * @brief save Writes the xdmf entries to a stream
+   *
+   * @param output Stream to which the XDMFHandler content is written
+   */
+  void
+  save(std::ostream &output) const;
+
+  /**
+   * @brief read Reads the xdmf entries of a checkpoint
+   *
+   * @param prefix Prefix of the file from which the XDMFHandler content is
+   * read
+   */
+  void
+  read(const std::string &prefix);
+
+  // Description of the hdf5 file of each output
+  std::vector<XDMFEntry> entries;
+
+private:
+  // Number of entries already written to the xdmf file
+  unsigned int n_written_entries;
+};
+
+#endif
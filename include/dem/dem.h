@@ -30,7 +30,11 @@
 #include <deal.II/particles/particle_handler.h>
 #include <deal.II/particles/property_pool.h>
 
+#include <core/async_output_writer.h>
+#include <core/load_balance_report.h>
+#include <core/metrics_log.h>
 #include <core/pvd_handler.h>
+#include <core/xdmf_handler.h>
 #include <dem/dem_properties.h>
 #include <dem/dem_solver_parameters.h>
 #include <dem/explicit_euler_integrator.h>
@@ -250,6 +254,24 @@ private:
   void
   write_output_results();
 
+  /**
+   * @brief write_metrics
+   * Writes the performance metrics of the time step to the metrics log: the
+   * number of particles and contacts and the wall time spent in each timer
+   * section during the time step
+   */
+  void
+  write_metrics();
+
+  /**
+   * @brief report_load_balance
+   * Prints the minimum, average and maximum over the ranks of the wall time
+   * of the timer sections and of the number of locally owned cells, particles
+   * and contacts
+   */
+  void
+  report_load_balance();
+
   MPI_Comm                                  mpi_communicator;
   const unsigned int                        n_mpi_processes;
   const unsigned int                        this_mpi_process;
@@ -309,10 +331,19 @@ private:
   std::shared_ptr<PPContactForce<dim>> pp_contact_force_object;
   std::shared_ptr<PWContactForce<dim>> pw_contact_force_object;
   PVDHandler                           particles_pvdhandler;
+  XDMFHandler                          particles_xdmf_handler;
 
   // Information for parallel grid processing
   DoFHandler<dim> background_dh;
   PVDHandler      grid_pvdhandler;
+  XDMFHandler     grid_xdmf_handler;
+
+  // Writes the results from a background thread when the asynchronous output
+  // is enabled
+  std::unique_ptr<AsyncOutputWriter> output_writer;
+
+  // Performance metrics of each time step, written when they are enabled
+  MetricsLog metrics_log;
 };
 
 #endif
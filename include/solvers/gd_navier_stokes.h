@@ -22,8 +22,13 @@
 
 #include <deal.II/lac/trilinos_block_sparse_matrix.h>
 
+#include <Amesos.h>
+#include <Epetra_LinearProblem.h>
+
 #include "core/bdf.h"
+#include "core/krylov_recycling.h"
 #include "navier_stokes_base.h"
+#include "single_precision_ilu.h"
 
 using namespace dealii;
 
@@ -51,6 +56,10 @@ private:
   const TrilinosWrappers::SparseMatrix &     pressure_mass_matrix;
   const BSPreconditioner *                   amat_preconditioner;
   const BSPreconditioner *                   pmass_preconditioner;
+
+  // Temporary velocity vector used by vmult. It is allocated once with the
+  // preconditioner instead of at every application of the preconditioner
+  mutable TrilinosWrappers::MPI::Vector utmp;
 };
 
 /**
@@ -79,6 +88,10 @@ public:
   void
   solve();
 
+protected:
+  virtual void
+  setup_dofs();
+
 private:
   void
   assemble_matrix_and_rhs(
@@ -97,9 +110,6 @@ private:
   void
   assemble_L2_projection();
 
-  virtual void
-  setup_dofs();
-
   void
   set_initial_condition(Parameters::InitialConditionType initial_condition_type,
                         bool                             restart = false);
@@ -140,6 +150,30 @@ private:
                    const double minimum_residual,
                    const bool   renewed_matrix);
 
+  /**
+   * Sparse direct solver. The factorization is only recomputed when the
+   * matrix has been renewed
+   */
+  void
+  solve_system_direct(const bool initial_step, const bool renewed_matrix);
+
+  /**
+   * Set-up the factorization of the direct solver. The blocks of the system
+   * matrix are copied in a monolithic matrix, which Amesos can factor. The
+   * symbolic factorization is kept until the sparsity pattern changes and
+   * only the numeric factorization is recomputed
+   */
+  void
+  setup_direct();
+
+  /**
+   * Solve with the factorization of the direct solver. The block vectors are
+   * copied to and from monolithic vectors
+   */
+  void
+  solve_direct(TrilinosWrappers::MPI::BlockVector &      dst,
+               const TrilinosWrappers::MPI::BlockVector &src);
+
   /**
    * Set-up AMG preconditioner
    */
@@ -152,6 +186,23 @@ private:
   void
   setup_ILU();
 
+  /**
+   * Set-up the preconditioner selected in the linear solver parameters from
+   * the last assembled matrix. Used by the jacobian-free non-linear solvers
+   */
+  void
+  setup_preconditioner() override;
+
+  /**
+   * Apply the preconditioner selected in the linear solver parameters
+   */
+  void
+  apply_preconditioner(TrilinosWrappers::MPI::BlockVector &      dst,
+                       const TrilinosWrappers::MPI::BlockVector &src) override;
+
+  bool
+  is_preconditioner_available() const override;
+
 
 
   /**
@@ -163,21 +214,35 @@ private:
 
   std::vector<types::global_dof_index> dofs_per_block;
 
-  std::shared_ptr<TrilinosWrappers::PreconditionILU>
+  // The ILU preconditioners are either Trilinos or single precision ILU
+  std::shared_ptr<TrilinosWrappers::PreconditionBase>
     velocity_ilu_preconditioner;
   std::shared_ptr<TrilinosWrappers::PreconditionAMG>
     velocity_amg_preconditioner;
-  std::shared_ptr<TrilinosWrappers::PreconditionILU>
+  std::shared_ptr<TrilinosWrappers::PreconditionBase>
     pressure_ilu_preconditioner;
   std::shared_ptr<TrilinosWrappers::PreconditionAMG>
     pressure_amg_preconditioner;
 
-  std::shared_ptr<BlockSchurPreconditioner<TrilinosWrappers::PreconditionILU>>
+  std::shared_ptr<BlockSchurPreconditioner<TrilinosWrappers::PreconditionBase>>
     system_ilu_preconditioner;
 
   std::shared_ptr<BlockSchurPreconditioner<TrilinosWrappers::PreconditionAMG>>
     system_amg_preconditioner;
 
+  // Krylov solver which recycles a subspace between successive solutions
+  RecyclingFGMRES<TrilinosWrappers::MPI::BlockVector> krylov_recycler;
+
+  // Monolithic copy of the system matrix factored by the direct method, with
+  // the vectors its solutions are copied through. They are only allocated
+  // when the direct method is used. The Amesos solver refers to the linear
+  // problem, which refers to the monolithic matrix
+  TrilinosWrappers::SparseMatrix        monolithic_matrix;
+  TrilinosWrappers::MPI::Vector         monolithic_lhs;
+  TrilinosWrappers::MPI::Vector         monolithic_rhs;
+  std::unique_ptr<Epetra_LinearProblem> direct_linear_problem;
+  std::unique_ptr<Amesos_BaseSolver>    direct_solver;
+
   const double gamma = 1;
 };
 
@@ -204,6 +269,8 @@ BlockSchurPreconditioner<BSPreconditioner>::BlockSchurPreconditioner(
   , pressure_mass_matrix(P)
   , amat_preconditioner(p_amat_preconditioner)
   , pmass_preconditioner(p_pmass_preconditioner)
+  , utmp(S.block(0, 0).locally_owned_range_indices(),
+         S.block(0, 0).get_mpi_communicator())
 {}
 
 template <class BSPreconditioner>
@@ -216,7 +283,6 @@ BlockSchurPreconditioner<BSPreconditioner>::vmult(
   //                                TimerOutput::summary,
   //                                TimerOutput::wall_times);
 
-  TrilinosWrappers::MPI::Vector utmp(src.block(0));
   {
     //        computing_timer.enter_section("Pressure");
     SolverControl solver_control(
@@ -239,8 +305,7 @@ BlockSchurPreconditioner<BSPreconditioner>::vmult(
   {
     //        computing_timer.enter_section("Operations");
     stokes_matrix.block(0, 1).vmult(utmp, dst.block(1));
-    utmp *= -1.0;
-    utmp += src.block(0);
+    utmp.sadd(-1.0, src.block(0));
     //        computing_timer.exit_section("Operations");
   }
   {
@@ -20,7 +20,13 @@
 #ifndef lethe_gls_navier_stokes_h
 #define lethe_gls_navier_stokes_h
 
+#include <Amesos.h>
+#include <Epetra_LinearProblem.h>
+#include <Epetra_Vector.h>
+
+#include "core/krylov_recycling.h"
 #include "navier_stokes_base.h"
+#include "single_precision_ilu.h"
 
 using namespace dealii;
 
@@ -30,13 +36,17 @@ using namespace dealii;
  * @tparam dim An integer that denotes the dimension of the space in which
  * the flow is solved
  *
+ * @tparam VectorType The parallel vector used for the solution and the
+ * right-hand side. Either the Trilinos vector or the deal.II distributed
+ * vector, whose operations are threaded and vectorized. The matrix and the
+ * preconditioners are the Trilinos ones in both cases.
+ *
  * @ingroup solvers
  * @author Bruno Blais, 2019
  */
 
-template <int dim>
-class GLSNavierStokesSolver
-  : public NavierStokesBase<dim, TrilinosWrappers::MPI::Vector, IndexSet>
+template <int dim, typename VectorType = TrilinosWrappers::MPI::Vector>
+class GLSNavierStokesSolver : public NavierStokesBase<dim, VectorType, IndexSet>
 {
 public:
   GLSNavierStokesSolver(NavierStokesSolverParameters<dim> &nsparam,
@@ -58,6 +68,20 @@ protected:
   set_solution_vector(double value);
 
 private:
+  /**
+   * @brief Solves the time steps of the simulation from the present initial
+   * condition and finishes it
+   */
+  void
+  run_time_loop();
+
+  /**
+   * @brief Solves the variants of the ensemble parameters in sequence on the
+   * mesh and degrees of freedom of the reference simulation
+   */
+  void
+  solve_ensemble();
+
   template <bool                                              assemble_matrix,
             Parameters::SimulationControl::TimeSteppingMethod scheme,
             Parameters::VelocitySource::VelocitySourceType    velocity_source>
@@ -112,6 +136,29 @@ private:
                    const double relative_residual,
                    const bool   renewed_matrix);
 
+  /**
+   * Sparse direct solver. The factorization is only recomputed when the
+   * matrix has been renewed
+   */
+  void
+  solve_system_direct(const bool initial_step, const bool renewed_matrix);
+
+  /**
+   * Set-up the factorization of the direct solver. The symbolic factorization
+   * is kept until the sparsity pattern changes and only the numeric
+   * factorization is recomputed
+   */
+  void
+  setup_direct();
+
+  /**
+   * Solve with the factorization of the direct solver. The vectors are
+   * wrapped in Epetra views of their locally owned values so that the direct
+   * solver can be used with every vector type
+   */
+  void
+  solve_direct(VectorType &dst, const VectorType &src);
+
   /**
    * Set-up AMG preconditioner
    */
@@ -124,6 +171,35 @@ private:
   void
   setup_ILU();
 
+  /**
+   * Set-up the preconditioner selected in the linear solver parameters from
+   * the last assembled matrix. Used by the jacobian-free non-linear solvers
+   */
+  void
+  setup_preconditioner() override;
+
+  /**
+   * Apply the preconditioner selected in the linear solver parameters
+   */
+  void
+  apply_preconditioner(VectorType &dst, const VectorType &src) override;
+
+  bool
+  is_preconditioner_available() const override;
+
+  /**
+   * Release the system matrix when the preconditioner does not refer to it,
+   * which is the case of the single precision ILU. Used by the jacobian-free
+   * non-linear solvers
+   */
+  void
+  release_system_matrix() override;
+
+  /**
+   * Build the sparsity pattern of the system matrix and allocate it
+   */
+  void
+  setup_system_matrix();
 
   /**
    * Members
@@ -131,8 +207,16 @@ private:
 private:
   SparsityPattern                                    sparsity_pattern;
   TrilinosWrappers::SparseMatrix                     system_matrix;
-  std::shared_ptr<TrilinosWrappers::PreconditionILU> ilu_preconditioner;
-  std::shared_ptr<TrilinosWrappers::PreconditionAMG> amg_preconditioner;
+  std::shared_ptr<TrilinosWrappers::PreconditionBase> ilu_preconditioner;
+  std::shared_ptr<TrilinosWrappers::PreconditionAMG>  amg_preconditioner;
+
+  // Linear problem and Amesos solver of the direct method. The solver refers
+  // to the linear problem, which refers to the system matrix
+  std::unique_ptr<Epetra_LinearProblem> direct_linear_problem;
+  std::unique_ptr<Amesos_BaseSolver>    direct_solver;
+
+  // Krylov solver which recycles a subspace between successive solutions
+  RecyclingFGMRES<VectorType> krylov_recycler;
 
   const bool   SUPG        = true;
   const double GLS_u_scale = 1;
@@ -36,6 +36,7 @@
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/precondition_block.h>
 #include <deal.II/lac/solver_bicgstab.h>
 #include <deal.II/lac/solver_cg.h>
@@ -87,21 +88,35 @@
 #include <deal.II/distributed/grid_refinement.h>
 #include <deal.II/distributed/solution_transfer.h>
 
+// Boost
+#include <boost/signals2/connection.hpp>
+
 
 // Lethe Includes
+#include <core/async_output_writer.h>
 #include <core/bdf.h>
 #include <core/boundary_conditions.h>
+#include <core/checkpoint_control.h>
+#include <core/load_balance_report.h>
 #include <core/manifolds.h>
+#include <core/metrics_log.h>
 #include <core/newton_non_linear_solver.h>
 #include <core/parameters.h>
 #include <core/physics_solver.h>
 #include <core/pvd_handler.h>
 #include <core/simulation_control.h>
+#include <core/table_writer.h>
+#include <core/xdmf_handler.h>
 
 #include "navier_stokes_solver_parameters.h"
 #include "post_processors.h"
+#include "postprocessing_force.h"
+#include "postprocessing_volume.h"
+#include "probes.h"
 
 // Std
+#include <array>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 
@@ -132,15 +147,49 @@ protected:
                    const unsigned int                 degreePressure);
 
   virtual ~NavierStokesBase()
-  {}
+  {
+    boundary_faces_connection.disconnect();
+  }
+
+  /**
+   * @brief get_krylov_max_iterations
+   * The Krylov solvers of the jacobian-free non-linear solvers use the
+   * maximal number of iterations of the linear solver
+   */
+  unsigned int
+  get_krylov_max_iterations() const override
+  {
+    return nsparam.linear_solver.max_iterations;
+  }
+
+  /**
+   * @brief get_krylov_max_vectors
+   * The GMRES solvers of the jacobian-free non-linear solvers use the
+   * dimension of the Krylov subspace of the linear solver
+   */
+  unsigned int
+  get_krylov_max_vectors() const override
+  {
+    return nsparam.linear_solver.max_krylov_vectors;
+  }
 
   /**
-   * @brief calculate_forces
+   * @brief postprocessing_forces_and_torques
    * Post-processing function
-   * Calculate forces acting on each boundary condition
+   * Calculate the forces and the torques acting on each boundary condition in
+   * a single pass over the boundary faces
    */
   void
-  postprocessing_forces(const VectorType &evaluation_point);
+  postprocessing_forces_and_torques(const VectorType &evaluation_point);
+
+  /**
+   * @brief postprocessing_forces
+   * Post-processing function
+   * Displays the forces acting on each boundary condition and adds them to
+   * the force tables
+   */
+  void
+  postprocessing_forces();
 
   /**
    * @brief calculate_L2_error
@@ -152,12 +201,13 @@ protected:
   calculate_L2_error(const VectorType &evaluation_point);
 
   /**
-   * @brief calculate_torques
+   * @brief postprocessing_torques
    * Post-processing function
-   * Calculate torque acting on each boundary condition
+   * Displays the torques acting on each boundary condition and adds them to
+   * the torque tables
    */
   void
-  postprocessing_torques(const VectorType &evaluation_point);
+  postprocessing_torques();
 
   /**
    * @brief finish_time_step
@@ -167,6 +217,24 @@ protected:
   void
   finish_time_step();
 
+  /**
+   * @brief write_metrics
+   * Writes the performance metrics of the time step to the metrics log: the
+   * size of the problem, the iterations of the solvers and the wall time
+   * spent in each timer section during the time step
+   */
+  void
+  write_metrics();
+
+  /**
+   * @brief report_load_balance
+   * Prints the minimum, average and maximum over the ranks of the wall time
+   * of the timer sections and of the number of locally owned cells, ghost
+   * cells and locally owned DoFs
+   */
+  void
+  report_load_balance();
+
   /**
    * @brief finish_simulation
    * Finishes the simulation by calling all
@@ -175,6 +243,119 @@ protected:
   void
   finish_simulation();
 
+  /**
+   * @brief rotate_solution_history
+   * Shifts the previous solutions by one time step (m3 <- m2 <- m1) and
+   * stores the present solution in solution_m1
+   */
+  void
+  rotate_solution_history();
+
+  /**
+   * @brief create_simulation_control
+   * Creates the simulation control matching the time stepping method and the
+   * output control of the simulation control parameters
+   */
+  void
+  create_simulation_control();
+
+  /**
+   * @brief create_table_writers
+   * Creates the writers of the enstrophy, kinetic energy, force and torque
+   * tables from the names of the post-processing parameters
+   */
+  void
+  create_table_writers();
+
+  /**
+   * @brief create_probes
+   * Creates the probes from the probe parameters when they are enabled
+   */
+  void
+  create_probes();
+
+  /**
+   * @brief setup_ensemble_variant
+   * Sets up a variant of an ensemble of simulations solved on the same mesh
+   * and degrees of freedom. The physical properties and boundary conditions of
+   * the variant are derived from the reference parameters, its outputs are
+   * suffixed by its number and its time stepping and post-processing tables
+   * start over.
+   *
+   * @param variant Number of the variant in the ensemble
+   *
+   * @param reference_parameters Parameters of the simulation from which the
+   * variants are derived
+   *
+   * @param reference_constraints Nonzero constraints of the reference
+   * boundary conditions
+   */
+  void
+  setup_ensemble_variant(
+    const unsigned int                       variant,
+    const NavierStokesSolverParameters<dim> &reference_parameters,
+    const AffineConstraints<double> &        reference_constraints);
+
+  /**
+   * @brief reset_pseudo_transient_continuation
+   * Restarts the pseudo-time stepping of a steady solve from the initial
+   * pseudo CFL
+   */
+  void
+  reset_pseudo_transient_continuation();
+
+  /**
+   * @brief update_pseudo_transient_continuation
+   * Updates the pseudo CFL from the norm of the residual of an accepted
+   * iterate using the switched evolution relaxation rule
+   * CFL = CFL_0 * ||R_0|| / ||R||, bounded by the maximal pseudo CFL. The
+   * first residual of the solve is the reference ||R_0||.
+   *
+   * @param residual Norm of the residual of the accepted iterate
+   */
+  void
+  update_pseudo_transient_continuation(const double residual);
+
+  /**
+   * @brief start_non_linear_solve
+   * Restarts the pseudo-transient continuation at the beginning of each
+   * steady solve, including those of the mesh adaptation cycles
+   */
+  virtual void
+  start_non_linear_solve(
+    const Parameters::SimulationControl::TimeSteppingMethod
+      time_stepping_method) override;
+
+  /**
+   * @brief accept_non_linear_iterate
+   * Updates the pseudo CFL of steady solves once per accepted iterate
+   */
+  virtual void
+  accept_non_linear_iterate(
+    const Parameters::SimulationControl::TimeSteppingMethod
+                 time_stepping_method,
+    const double residual) override;
+
+  /**
+   * @brief autotune_linear_solver
+   * Solves the present linear system with a small set of linear solver
+   * configurations and keeps the fastest one, preconditioner set-up included,
+   * for the rest of the simulation. The solver type is selected first, then
+   * the parameters of its preconditioner are tuned one at a time. The
+   * selected parameters are written to a parameter file that can be reused.
+   * The solution of the fastest configuration is left in the newton update,
+   * so the linear system does not have to be solved again.
+   *
+   * @param initial_step Indicates if the nonzero constraints are applied to
+   * the solution of the linear system
+   *
+   * @param solver_types The linear solvers available in the physics solver
+   */
+  void
+  autotune_linear_solver(
+    const bool                                               initial_step,
+    const std::vector<Parameters::LinearSolver::SolverType> &solver_types);
+
   /**
    * @brief iterate
    * Do a regular CFD iteration
@@ -236,6 +417,19 @@ protected:
   virtual void
   setup_dofs() = 0;
 
+  /**
+   * @brief renumber_dofs
+   * Renumbers the degrees of freedom with the strategy selected in the FEM
+   * parameters. It must be called right after the distribution of the dofs so
+   * that the constraints, the sparsity pattern and the vectors all use the
+   * new numbering
+   *
+   * @param automatic_renumbering Renumbering applied when the automatic
+   * renumbering is selected, which is the historical choice of the solver
+   */
+  void
+  renumber_dofs(const Parameters::FEM::DofRenumbering automatic_renumbering);
+
   /**
    * @brief write_checkpoint
    */
@@ -249,6 +443,73 @@ protected:
   void
   write_output_results(const VectorType &solution);
 
+  /**
+   * @brief update_time_averaged_statistics
+   * Adds the present solution to the time averages of the solution, of the
+   * squares of its components and of the products of the velocity components
+   * at the same support point. The averages are weighted by the time step and
+   * are updated by vector operations only.
+   */
+  void
+  update_time_averaged_statistics();
+
+  /**
+   * @brief time_averaged_statistics
+   * Returns the locally owned mean of the solution, the variances <u'u'> =
+   * <uu> - <u><u> of its components and the shear Reynolds stresses <u'v'> =
+   * <uv> - <u><v>, which are stored in the dofs of u, v and w like the
+   * products of shift_velocity_components
+   */
+  std::vector<VectorType>
+  time_averaged_statistics();
+
+  /**
+   * @brief write_output_time_averaged_statistics
+   * Writes the mean velocity and pressure, the variances of the velocity and
+   * pressure fluctuations and the shear Reynolds stresses as parallel VTU
+   * files. The statistics are written at the end of the simulation and can be
+   * written at any time step on demand.
+   */
+  void
+  write_output_time_averaged_statistics();
+
+  /**
+   * @brief ghosted_time_averaged_statistics
+   * Returns ghosted copies of the averages of the solution, of its squares and
+   * of the velocity products, which are carried through the mesh refinement
+   * and the checkpoints. The copies are zero before the averaging has started.
+   */
+  std::vector<VectorType>
+  ghosted_time_averaged_statistics() const;
+
+  /**
+   * @brief set_time_averaged_statistics
+   * Sets the averages from the vectors returned by
+   * ghosted_time_averaged_statistics once they have been transferred to the
+   * new dofs. Nothing is done if the vectors are empty.
+   *
+   * @param statistics The transferred averages
+   */
+  void
+  set_time_averaged_statistics(const std::vector<VectorType> &statistics);
+
+  /**
+   * @brief shift_velocity_components
+   * Stores in the velocity dofs of each support point of a vector the next
+   * velocity component of the same support point in another vector, that is
+   * v in the dof of u, w in the dof of v and u in the dof of w in 3D. The
+   * pressure dofs are set to zero. The product of the shifted vector with the
+   * original one contains the off-diagonal products u v, v w and w u.
+   *
+   * @param solution The vector of which the velocity components are shifted
+   *
+   * @param shifted_solution The locally owned vector receiving the shifted
+   * components
+   */
+  void
+  shift_velocity_components(const VectorType &solution,
+                            VectorType &      shifted_solution);
+
   /**
    * @brief write_output_forces
    * Writes the forces per boundary condition to a text file output
@@ -279,6 +540,11 @@ protected:
 
   NavierStokesSolverParameters<dim> nsparam;
   PVDHandler                        pvdhandler;
+  XDMFHandler                       xdmf_handler;
+
+  // Writes the results from a background thread when the asynchronous output
+  // is enabled
+  std::unique_ptr<AsyncOutputWriter> output_writer;
 
 
   Function<dim> *exact_solution;
@@ -301,17 +567,67 @@ protected:
   std::shared_ptr<SimulationControl> simulationControl;
   // SimulationControl simulationControl;
 
-  // Post-processing variables
-  TableHandler enstrophy_table;
-  TableHandler kinetic_energy_table;
+  // Pseudo-transient continuation of steady solves. The pseudo CFL scales the
+  // local pseudo-time term added to the jacobian matrix
+  double pseudo_cfl;
+  double pseudo_initial_residual;
+
+  // Indicates that the autotune of the linear solver has been done
+  bool linear_solver_autotuned;
+
+  // Post-processing variables. The rows of the tables are appended to their
+  // files and dropped from memory when they are written
+  TableWriter enstrophy_table;
+  TableWriter kinetic_energy_table;
   // Convergence Analysis
   ConvergenceTable error_table;
 
   // Force analysis
   std::vector<Tensor<1, dim>> forces_on_boundaries;
   std::vector<Tensor<1, 3>>   torques_on_boundaries;
-  std::vector<TableHandler>   forces_tables;
-  std::vector<TableHandler>   torques_tables;
+  std::vector<TableWriter>    forces_tables;
+  std::vector<TableWriter>    torques_tables;
+
+  // Boundary faces of each boundary condition. They are gathered again after
+  // the triangulation has changed
+  BoundaryFaces<dim>          boundary_faces;
+  bool                        boundary_faces_outdated;
+  boost::signals2::connection boundary_faces_connection;
+
+  // Sampling of the solution at points, along lines and on planes
+  std::unique_ptr<Probes<dim, VectorType>> probes;
+
+  // Time-averaged statistics. The locally owned vectors hold the averages of
+  // the solution, of the squares of its components and of the products of the
+  // velocity components at the same support point over the averaging time
+  VectorType average_solution;
+  VectorType average_squared_solution;
+  VectorType average_velocity_products;
+  double     averaging_time;
+  PVDHandler statistics_pvdhandler;
+
+  // Locally owned dofs of the velocity components of each support point
+  std::vector<std::array<types::global_dof_index, dim>> velocity_support_dofs;
+
+  // Indicates that the dofs have been distributed again since the velocity
+  // support dofs were gathered
+  bool velocity_support_dofs_outdated;
+
+  // CFL calculated by the volume post-processing of the time step. It is used
+  // by finish_time_step instead of calculating the CFL a second time
+  double postprocessed_cfl;
+  bool   postprocessed_cfl_available;
+
+  // Rotation of the checkpoints over their generations and validation of
+  // their files by checksums
+  CheckpointControl checkpoint_control;
+
+  // Start of the simulation, from which the walltime is measured
+  std::chrono::steady_clock::time_point start_wall_time;
+  bool                                  walltime_checkpoint_written;
+
+  // Performance metrics of each time step, written when they are enabled
+  MetricsLog metrics_log;
 };
 
 #endif
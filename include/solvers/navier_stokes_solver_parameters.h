@@ -28,6 +28,8 @@
 #include "initial_conditions.h"
 #include "source_terms.h"
 
+#include <stdexcept>
+
 template <int dim>
 class NavierStokesSolverParameters
 {
@@ -50,6 +52,8 @@ public:
   AnalyticalSolutions::NSAnalyticalSolution<dim> *analytical_solution;
   SourceTerms::NSSourceTerm<dim> *                sourceTerm;
   Parameters::VelocitySource                      velocitySource;
+  Parameters::Ensemble                            ensemble;
+  Parameters::Probes                              probes;
 
   void
   declare(ParameterHandler &prm)
@@ -80,6 +84,8 @@ public:
     Parameters::Testing::declare_parameters(prm);
 
     Parameters::VelocitySource::declare_parameters(prm);
+    Parameters::Ensemble::declare_parameters(prm);
+    Parameters::Probes::declare_parameters(prm);
   }
 
   void
@@ -103,6 +109,18 @@ public:
     sourceTerm->parse_parameters(prm);
     simulation_control.parse_parameters(prm);
     velocitySource.parse_parameters(prm);
+    ensemble.parse_parameters(prm);
+    probes.parse_parameters(prm);
+
+    // The jacobian-free products are derivatives of the residual, which has
+    // no pseudo-time term. Only the preconditioner would be continued.
+    if (simulation_control.pseudo_transient &&
+        non_linear_solver.solver ==
+          Parameters::NonLinearSolver::SolverType::jfnk)
+      throw(std::runtime_error(
+        "The pseudo-transient continuation cannot be combined with the jfnk "
+        "non-linear solver, whose jacobian-free products do not include the "
+        "pseudo-time term"));
   }
 };
 
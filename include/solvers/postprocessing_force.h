@@ -73,4 +73,63 @@ calculate_forces(
   const BoundaryConditions::NSBoundaryConditions<dim> &boundary_conditions,
   const MPI_Comm &                                     mpi_communicator);
 
+/**
+ * @brief Locally owned boundary faces of each boundary condition, stored as
+ * pairs of a cell and of the number of the face within the cell
+ */
+template <int dim>
+using BoundaryFaces = std::vector<std::vector<
+  std::pair<typename DoFHandler<dim>::active_cell_iterator, unsigned int>>>;
+
+/**
+ * @brief Gathers the locally owned boundary faces of each boundary condition.
+ * The list remains valid as long as the triangulation does not change.
+ *
+ * @param dof_handler The dof_handler used for the calculation
+ *
+ * @param boundary_conditions The boundary conditions object
+ */
+template <int dim>
+BoundaryFaces<dim>
+gather_boundary_faces(
+  const DoFHandler<dim> &                            dof_handler,
+  const BoundaryConditions::BoundaryConditions<dim> &boundary_conditions);
+
+/**
+ * @brief Calculates the forces and the torques due to the fluid motion on
+ * every boundary condition in a single pass over the boundary faces. The
+ * stress is evaluated once per face and used by both the force and the torque,
+ * which are reduced over the processes with a single communication.
+ *
+ * @param dof_handler The dof_handler used for the calculation
+ *
+ * @param boundary_faces The boundary faces of each boundary condition
+ *
+ * @param evaluation_point The solution at which the forces are calculated
+ *
+ * @param physical_properties The parameters containing the required physical properties
+ *
+ * @param fem_parameters The fem_parameters of the simulation
+ *
+ * @param boundary_conditions The boundary conditions object
+ *
+ * @param mpi_communicator The mpi communicator. It is used to reduce the force and torque calculation
+ *
+ * @param forces The force on each boundary condition
+ *
+ * @param torques The torque on each boundary condition
+ */
+template <int dim, typename VectorType>
+void
+calculate_forces_and_torques(
+  const DoFHandler<dim> &                              dof_handler,
+  const BoundaryFaces<dim> &                           boundary_faces,
+  const VectorType &                                   evaluation_point,
+  const Parameters::PhysicalProperties &               physical_properties,
+  const Parameters::FEM &                              fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<dim> &boundary_conditions,
+  const MPI_Comm &                                     mpi_communicator,
+  std::vector<Tensor<1, dim>> &                        forces,
+  std::vector<Tensor<1, 3>> &                          torques);
+
 #endif
@@ -0,0 +1,100 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2019 -  by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_postprocessing_volume_h
+#define lethe_postprocessing_volume_h
+
+// Base
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+// Dofs
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+// Fe
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+// Lethe includes
+#include <core/parameters.h>
+
+
+using namespace dealii;
+
+/**
+ * @brief Quantities calculated by the volume post-processing. The quantities
+ * which were not requested are zero.
+ */
+struct VolumeQuantities
+{
+  double cfl               = 0;
+  double kinetic_energy    = 0;
+  double enstrophy         = 0;
+  double l2_error_velocity = 0;
+  double l2_error_pressure = 0;
+};
+
+/**
+ * @brief Calculates the requested volume quantities in a single pass over the
+ * cells
+ * @return The CFL, the average kinetic energy and enstrophy and the L2 norm of
+ * the error on the velocity and on the pressure
+ * Post-processing function
+ * This function shares the cell loop and the mapping between the CFL, the
+ * kinetic energy, the enstrophy and the L2 error, which each keep their own
+ * quadrature so that their values are those of the separate calculations. The
+ * sums of all the quantities are reduced with a single communication.
+ *
+ * @param dof_handler The dof_handler used for the calculation
+ *
+ * @param evaluation_point The solution at which the quantities are calculated
+ *
+ * @param fem_parameters The fem_parameters of the simulation
+ *
+ * @param calculate_cfl Enables the calculation of the CFL
+ *
+ * @param time_step The time step used for the CFL
+ *
+ * @param calculate_kinetic_energy Enables the calculation of the kinetic energy
+ *
+ * @param calculate_enstrophy Enables the calculation of the enstrophy
+ *
+ * @param exact_solution The exact solution with which the L2 error is calculated. No error is calculated if it is a nullptr
+ *
+ * @param error_quadrature_points Number of quadrature points per direction of the error calculation
+ *
+ * @param mpi_communicator The mpi communicator. It is used to reduce the quantities
+ */
+template <int dim, typename VectorType>
+VolumeQuantities
+calculate_volume_quantities(const DoFHandler<dim> &dof_handler,
+                            const VectorType &     evaluation_point,
+                            const Parameters::FEM &fem_parameters,
+                            const bool             calculate_cfl,
+                            const double           time_step,
+                            const bool             calculate_kinetic_energy,
+                            const bool             calculate_enstrophy,
+                            const Function<dim> *  exact_solution,
+                            const unsigned int     error_quadrature_points,
+                            const MPI_Comm &       mpi_communicator);
+
+#endif
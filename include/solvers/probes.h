@@ -0,0 +1,169 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2020 -  by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_probes_h
+#define lethe_probes_h
+
+// Base
+#include <deal.II/base/point.h>
+
+// Dofs
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+// Fe
+#include <deal.II/fe/mapping_q.h>
+
+// Lethe includes
+#include <core/parameters.h>
+#include <core/table_writer.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <vector>
+
+
+using namespace dealii;
+
+/**
+ * @brief The Probes class samples the velocity and the pressure at points,
+ * along lines and on planes. Each probe writes a time series with one row per
+ * sampling and the values of all its samples, from the first process, instead
+ * of the full-field output of the solution.
+ *
+ * The cell containing each sample and the values of the shape functions at
+ * the sample are found once and reused until the triangulation changes. Each
+ * sample is evaluated by the process owning its cell and the values are
+ * reduced on the first process. The samples which are not in the domain are
+ * written as nan.
+ */
+template <int dim, typename VectorType>
+class Probes
+{
+public:
+  /**
+   * @brief Constructor for the Probes. Writes the coordinates of the samples
+   * of each probe
+   *
+   * @param parameters The parameters of the probes
+   *
+   * @param dof_handler The dof_handler of the solution
+   *
+   * @param velocity_fem_degree Degree of the velocity, used as the degree of
+   * the mapping
+   *
+   * @param fem_parameters The fem_parameters of the simulation
+   *
+   * @param mpi_communicator The mpi communicator
+   */
+  Probes(const Parameters::Probes &parameters,
+         const DoFHandler<dim> &   dof_handler,
+         const unsigned int        velocity_fem_degree,
+         const Parameters::FEM &   fem_parameters,
+         const MPI_Comm &          mpi_communicator);
+
+  ~Probes();
+
+  Probes(const Probes &) = delete;
+  Probes &
+  operator=(const Probes &) = delete;
+
+  /**
+   * @brief sample Samples the probes and adds a row to their time series
+   *
+   * @param solution The solution which is sampled
+   *
+   * @param time The time of the solution
+   */
+  void
+  sample(const VectorType &solution, const double time);
+
+  /**
+   * @brief flush Writes the rows of the time series to their files
+   */
+  void
+  flush();
+
+  /**
+   * @brief save Flushes the time series and saves their number of rows
+   *
+   * @param prefix Prefix of the checkpoint files
+   */
+  void
+  save(const std::string &prefix);
+
+  /**
+   * @brief save Flushes the time series of a probe and writes its number of
+   * rows to a stream
+   *
+   * @param probe Index of the probe
+   *
+   * @param output Stream to which the number of rows is written
+   */
+  void
+  save(const unsigned int probe, std::ostream &output);
+
+  /**
+   * @brief read Reads the number of rows of the time series of a checkpoint
+   *
+   * @param prefix Prefix of the checkpoint files
+   */
+  void
+  read(const std::string &prefix);
+
+private:
+  /**
+   * @brief Finds the cell and the shape function values of the samples owned
+   * by this process
+   */
+  void
+  locate_samples();
+
+  // Sample located in a locally owned cell
+  struct LocatedSample
+  {
+    unsigned int                                   sample;
+    typename DoFHandler<dim>::active_cell_iterator cell;
+    // Value of each shape function of the cell at the sample
+    std::vector<double> shape_values;
+  };
+
+  const DoFHandler<dim> &dof_handler;
+  const MappingQ<dim>    mapping;
+  const MPI_Comm         mpi_communicator;
+  const unsigned int     this_mpi_process;
+
+  // Coordinates of the samples of all the probes. The samples of probe i are
+  // the ones from probe_first_sample[i] to probe_first_sample[i+1]
+  std::vector<Point<dim>>   sample_points;
+  std::vector<unsigned int> probe_first_sample;
+
+  // Time series of each probe
+  std::vector<TableWriter> tables;
+
+  // Samples located in the locally owned cells and indicator of the samples
+  // located in the domain by any process
+  std::vector<LocatedSample> located_samples;
+  std::vector<bool>          sample_found;
+  bool                       samples_outdated;
+
+  boost::signals2::connection triangulation_connection;
+};
+
+#endif
@@ -0,0 +1,165 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2019 - 2020 by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#ifndef lethe_single_precision_ilu_h
+#define lethe_single_precision_ilu_h
+
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/trilinos_precondition.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <Epetra_Map.h>
+#include <Epetra_Operator.h>
+
+using namespace dealii;
+
+/**
+ * @brief SinglePrecisionILU. Incomplete LU preconditioner whose factors are
+ * stored in single precision. Like the Trilinos ILU preconditioner without
+ * overlap, it factorizes the block of the matrix which couples the locally
+ * owned degrees of freedom of each process (block Jacobi). Since the
+ * application of the preconditioner is limited by the memory bandwidth,
+ * storing the factors in single precision halves both their memory footprint
+ * and the data read at every application, while the outer Krylov solver
+ * still works in double precision.
+ *
+ * The preconditioner derives from the Trilinos PreconditionBase so that it can
+ * be used with the Trilinos solvers in place of a PreconditionILU.
+ */
+class SinglePrecisionILU : public TrilinosWrappers::PreconditionBase
+{
+public:
+  struct AdditionalData
+  {
+    /**
+     * @brief Constructor
+     *
+     * @param extra_off_diagonals Number of off-diagonals added to the sparsity
+     * pattern of the factors on each side of the diagonal
+     *
+     * @param ilu_atol Absolute threshold added to the diagonal entries before
+     * the factorization, with the sign of the entry, as in the Trilinos ILU
+     *
+     * @param ilu_rtol Relative threshold by which the diagonal entries are
+     * scaled before the factorization, as in the Trilinos ILU
+     */
+    AdditionalData(const unsigned int extra_off_diagonals = 0,
+                   const double       ilu_atol            = 0.,
+                   const double       ilu_rtol            = 1.)
+      : extra_off_diagonals(extra_off_diagonals)
+      , ilu_atol(ilu_atol)
+      , ilu_rtol(ilu_rtol)
+    {}
+
+    unsigned int extra_off_diagonals;
+    double       ilu_atol;
+    double       ilu_rtol;
+  };
+
+  /**
+   * @brief Computes the single precision factorization of the locally owned
+   * block of the matrix
+   */
+  void
+  initialize(const TrilinosWrappers::SparseMatrix &matrix,
+             const AdditionalData &additional_data = AdditionalData());
+
+private:
+  /**
+   * @brief Epetra operator whose inverse is the application of the
+   * single precision factors. It is the operator called by the Trilinos
+   * solvers and by the vmult function of the PreconditionBase.
+   */
+  class LocalILUOperator : public Epetra_Operator
+  {
+  public:
+    LocalILUOperator(const TrilinosWrappers::SparseMatrix &matrix,
+                     const AdditionalData &                additional_data);
+
+    int
+    SetUseTranspose(bool use_transpose) override;
+
+    int
+    Apply(const Epetra_MultiVector &X, Epetra_MultiVector &Y) const override;
+
+    int
+    ApplyInverse(const Epetra_MultiVector &X,
+                 Epetra_MultiVector &      Y) const override;
+
+    double
+    NormInf() const override
+    {
+      return 0.;
+    }
+
+    const char *
+    Label() const override
+    {
+      return "Lethe single precision ILU";
+    }
+
+    bool
+    UseTranspose() const override
+    {
+      return false;
+    }
+
+    bool
+    HasNormInf() const override
+    {
+      return false;
+    }
+
+    const Epetra_Comm &
+    Comm() const override
+    {
+      return domain_map.Comm();
+    }
+
+    const Epetra_Map &
+    OperatorDomainMap() const override
+    {
+      return domain_map;
+    }
+
+    const Epetra_Map &
+    OperatorRangeMap() const override
+    {
+      return range_map;
+    }
+
+  private:
+    Epetra_Map domain_map;
+    Epetra_Map range_map;
+
+    // The factors refer to the sparsity pattern, which must thus be
+    // declared before them
+    SparsityPattern  sparsity_pattern;
+    SparseILU<float> factors;
+    unsigned int     n_local_rows;
+
+    // Work vectors of the application of the factors
+    mutable Vector<double> local_src;
+    mutable Vector<double> local_dst;
+  };
+};
+
+#endif
@@ -0,0 +1,115 @@
+#include "core/async_output_writer.h"
+
+#include <fstream>
+#include <stdexcept>
+
+AsyncOutputWriter::AsyncOutputWriter(const std::size_t max_buffer_size)
+  : max_buffer_size(max_buffer_size)
+  , buffer_size(0)
+  , writing(false)
+  , stop(false)
+{
+  thread = std::thread(&AsyncOutputWriter::run, this);
+}
+
+AsyncOutputWriter::~AsyncOutputWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  file_queued.notify_one();
+  thread.join();
+}
+
+void
+AsyncOutputWriter::write(const std::string &filename, std::string &&content)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  throw_error();
+
+  // A file larger than the buffer is queued once the buffer is empty
+  file_written.wait(lock, [&]() {
+    return buffer_size == 0 ||
+           buffer_size + content.size() <= max_buffer_size;
+  });
+  throw_error();
+
+  buffer_size += content.size();
+  queue.push_back({filename, std::move(content), nullptr});
+  lock.unlock();
+  file_queued.notify_one();
+}
+
+void
+AsyncOutputWriter::enqueue(std::function<void()> &&task)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  throw_error();
+  queue.push_back({std::string(), std::string(), std::move(task)});
+  lock.unlock();
+  file_queued.notify_one();
+}
+
+void
+AsyncOutputWriter::flush()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  file_written.wait(lock, [&]() { return queue.empty() && !writing; });
+  throw_error();
+}
+
+void
+AsyncOutputWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true)
+    {
+      file_queued.wait(lock, [&]() { return stop || !queue.empty(); });
+      if (queue.empty())
+        return;
+
+      QueuedWrite file = std::move(queue.front());
+      queue.pop_front();
+      writing = true;
+      lock.unlock();
+
+      std::exception_ptr write_error;
+      try
+        {
+          if (file.task)
+            file.task();
+          else
+            {
+              std::ofstream output(file.filename.c_str(), std::ios::binary);
+              output.write(file.content.data(), file.content.size());
+              output.close();
+              if (!output)
+                throw(std::runtime_error("Unable to write the output file " +
+                                         file.filename));
+            }
+        }
+      catch (...)
+        {
+          write_error = std::current_exception();
+        }
+
+      lock.lock();
+      if (write_error && !error)
+        error = write_error;
+      buffer_size -= file.content.size();
+      writing = false;
+      file_written.notify_all();
+    }
+}
+
+void
+AsyncOutputWriter::throw_error()
+{
+  if (error)
+    {
+      std::exception_ptr current_error = error;
+      error                            = nullptr;
+      std::rethrow_exception(current_error);
+    }
+}
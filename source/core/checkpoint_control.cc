@@ -0,0 +1,183 @@
+#include "core/checkpoint_control.h"
+
+#include "core/fnv1a_hash.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+  // Size and 64 bits FNV-1a hash of the bytes of a file. Returns false if the
+  // file cannot be opened.
+  bool
+  checksum_file(const std::string &filename,
+                std::uint64_t &    size,
+                std::uint64_t &    checksum)
+  {
+    std::ifstream input(filename.c_str(), std::ios::binary);
+    if (!input)
+      return false;
+
+    size = 0;
+    FNV1aHash         hash;
+    std::vector<char> buffer(1 << 20);
+    while (input)
+      {
+        input.read(buffer.data(), buffer.size());
+        const std::streamsize n_read = input.gcount();
+        hash.add(buffer.data(), n_read);
+        size += n_read;
+      }
+    checksum = hash.value();
+    return true;
+  }
+
+  // Replaces a file by renaming a temporary file, which is atomic on POSIX
+  // file systems
+  void
+  write_atomically(const std::string &filename, const std::string &content)
+  {
+    const std::string temporary_filename = filename + ".tmp";
+    std::ofstream     output(temporary_filename.c_str(), std::ios::binary);
+    output.write(content.data(), content.size());
+    output.close();
+    if (!output ||
+        std::rename(temporary_filename.c_str(), filename.c_str()) != 0)
+      throw(std::runtime_error("Unable to write the checkpoint file " +
+                               filename));
+  }
+} // namespace
+
+CheckpointControl::CheckpointControl(const std::string &filename,
+                                     const unsigned int n_generations)
+  : filename(filename)
+  , n_generations(std::max(n_generations, 2U))
+{}
+
+std::string
+CheckpointControl::next_prefix() const
+{
+  const std::vector<std::string> checkpoints = read_checkpoint_list();
+
+  // The generation which appears last in the list is the oldest one
+  std::string oldest_prefix;
+  std::size_t oldest_position = 0;
+  for (unsigned int generation = 0; generation < n_generations; ++generation)
+    {
+      std::ostringstream prefix;
+      prefix << filename << "_" << std::setw(2) << std::setfill('0')
+             << generation;
+
+      const std::size_t position =
+        std::find(checkpoints.begin(), checkpoints.end(), prefix.str()) -
+        checkpoints.begin();
+      if (position == checkpoints.size())
+        return prefix.str();
+
+      if (oldest_prefix.empty() || position > oldest_position)
+        {
+          oldest_prefix   = prefix.str();
+          oldest_position = position;
+        }
+    }
+  return oldest_prefix;
+}
+
+CheckpointControl::FileChecksum
+CheckpointControl::checksum(const std::string &content)
+{
+  FNV1aHash hash;
+  hash.add(content);
+  return {content.size(), hash.value()};
+}
+
+void
+CheckpointControl::commit(
+  const std::string &                        prefix,
+  const std::vector<std::string> &           suffixes,
+  const std::map<std::string, FileChecksum> &known_checksums) const
+{
+  std::ostringstream checksums;
+  for (const std::string &suffix : suffixes)
+    {
+      std::uint64_t size, checksum;
+      const auto    known_checksum = known_checksums.find(suffix);
+      if (known_checksum != known_checksums.end())
+        {
+          size     = known_checksum->second.size;
+          checksum = known_checksum->second.checksum;
+        }
+      else if (!checksum_file(prefix + suffix, size, checksum))
+        continue;
+
+      checksums << suffix << " " << size << " " << std::hex << checksum
+                << std::dec << std::endl;
+    }
+  write_atomically(prefix + ".checksums", checksums.str());
+
+  // The committed checkpoint becomes the most recent one and the checkpoints
+  // beyond the number of generations are forgotten
+  std::vector<std::string> checkpoints = read_checkpoint_list();
+  checkpoints.erase(std::remove(checkpoints.begin(), checkpoints.end(), prefix),
+                    checkpoints.end());
+  checkpoints.insert(checkpoints.begin(), prefix);
+  if (checkpoints.size() > n_generations)
+    checkpoints.resize(n_generations);
+
+  std::ostringstream list;
+  for (const std::string &checkpoint : checkpoints)
+    list << checkpoint << std::endl;
+  write_atomically(filename + ".checkpoints", list.str());
+}
+
+bool
+CheckpointControl::is_valid(const std::string &prefix) const
+{
+  std::ifstream checksums((prefix + ".checksums").c_str());
+  if (!checksums)
+    return false;
+
+  std::string   suffix;
+  std::uint64_t expected_size, expected_checksum;
+  while (checksums >> suffix >> expected_size >> std::hex >>
+         expected_checksum >> std::dec)
+    {
+      std::uint64_t size, checksum;
+      if (!checksum_file(prefix + suffix, size, checksum) ||
+          size != expected_size || checksum != expected_checksum)
+        return false;
+    }
+  return checksums.eof();
+}
+
+std::string
+CheckpointControl::latest_valid_prefix() const
+{
+  std::ifstream list((filename + ".checkpoints").c_str());
+  if (!list)
+    return filename;
+
+  for (const std::string &checkpoint : read_checkpoint_list())
+    if (is_valid(checkpoint))
+      return checkpoint;
+
+  throw(std::runtime_error("None of the checkpoints listed in " + filename +
+                           ".checkpoints matches its checksums"));
+}
+
+std::vector<std::string>
+CheckpointControl::read_checkpoint_list() const
+{
+  std::vector<std::string> checkpoints;
+  std::ifstream            list((filename + ".checkpoints").c_str());
+  std::string              checkpoint;
+  while (std::getline(list, checkpoint))
+    if (!checkpoint.empty())
+      checkpoints.push_back(checkpoint);
+  return checkpoints;
+}
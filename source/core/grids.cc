@@ -1,13 +1,242 @@
 // Deal.II includes
+#include <deal.II/base/mpi.h>
+
 #include <deal.II/grid/grid_tools.h>
 
 // Lethe includes
 #include "core/boundary_conditions.h"
+#include "core/fnv1a_hash.h"
 #include "core/grids.h"
 
 // Std
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+
+namespace
+{
+  /**
+   * @brief Adds the periodicity of the periodic boundary conditions to a
+   * coarse triangulation
+   */
+  template <int dim>
+  void
+  add_periodic_boundary_conditions(
+    parallel::DistributedTriangulationBase<dim> &      triangulation,
+    const BoundaryConditions::BoundaryConditions<dim> &boundary_conditions)
+  {
+    for (unsigned int i_bc = 0; i_bc < boundary_conditions.size; ++i_bc)
+      {
+        if (boundary_conditions.type[i_bc] ==
+            BoundaryConditions::BoundaryType::periodic)
+          {
+            std::vector<GridTools::PeriodicFacePair<
+              typename Triangulation<dim>::cell_iterator>>
+              periodicity_vector;
+            GridTools::collect_periodic_faces(
+              static_cast<Triangulation<dim> &>(triangulation),
+              boundary_conditions.id[i_bc],
+              boundary_conditions.periodic_id[i_bc],
+              boundary_conditions.periodic_direction[i_bc],
+              periodicity_vector);
+            triangulation.add_periodicity(periodicity_vector);
+          }
+      }
+  }
+
+  /**
+   * @brief Returns the key which identifies the mesh stored in the cache. It
+   * depends on the content of the mesh file or on the arguments of the
+   * deal.II grid, on the initial refinement and on the periodicity, which all
+   * change the refined forest. The manifolds are attached again when the cache
+   * is loaded and are not part of the key.
+   */
+  template <int dim>
+  std::string
+  mesh_cache_key(
+    const Parameters::Mesh &                           mesh_parameters,
+    const BoundaryConditions::BoundaryConditions<dim> &boundary_conditions)
+  {
+    std::ostringstream key;
+    key << "lethe mesh cache 2 dim " << dim << " refinement "
+        << mesh_parameters.initial_refinement;
+
+    if (mesh_parameters.type == Parameters::Mesh::Type::gmsh)
+      {
+        std::ifstream      input_file(mesh_parameters.file_name,
+                                 std::ios::binary);
+        std::ostringstream content;
+        content << input_file.rdbuf();
+        key << " gmsh " << mesh_parameters.file_name << " "
+            << fnv1a_hash(content.str());
+      }
+    else
+      key << " dealii " << mesh_parameters.grid_type << " "
+          << mesh_parameters.grid_arguments;
+
+    for (unsigned int i_bc = 0; i_bc < boundary_conditions.size; ++i_bc)
+      if (boundary_conditions.type[i_bc] ==
+          BoundaryConditions::BoundaryType::periodic)
+        key << " periodic " << boundary_conditions.id[i_bc] << " "
+            << boundary_conditions.periodic_id[i_bc] << " "
+            << boundary_conditions.periodic_direction[i_bc];
+
+    return key.str();
+  }
+
+  template <typename T>
+  void
+  write_binary(std::ostream &out, const T &value)
+  {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  void
+  read_binary(std::istream &in, T &value)
+  {
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+  }
+
+  std::string
+  read_cache_key(std::istream &in)
+  {
+    std::uint64_t length = 0;
+    read_binary(in, length);
+    std::string key(in ? length : 0, ' ');
+    in.read(&key[0], key.size());
+    return in ? key : std::string();
+  }
+
+  /**
+   * @brief Writes the coarse mesh of a triangulation in binary form: its
+   * vertices, the vertices, material and manifold ids of its cells and the
+   * boundary and manifold ids of their faces and, in 3D, of their lines.
+   */
+  template <int dim>
+  void
+  write_coarse_mesh(const Triangulation<dim> &triangulation,
+                    const std::string &       key,
+                    std::ostream &            out)
+  {
+    write_binary(out, static_cast<std::uint64_t>(key.size()));
+    out.write(key.data(), key.size());
+
+    const std::vector<Point<dim>> &vertices = triangulation.get_vertices();
+    write_binary(out, static_cast<std::uint64_t>(vertices.size()));
+    for (const Point<dim> &vertex : vertices)
+      for (unsigned int d = 0; d < dim; ++d)
+        write_binary(out, vertex[d]);
+
+    write_binary(out, static_cast<std::uint64_t>(triangulation.n_cells(0)));
+    for (const auto &cell : triangulation.cell_iterators_on_level(0))
+      {
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          write_binary(out, cell->vertex_index(v));
+        write_binary(out, cell->material_id());
+        write_binary(out, cell->manifold_id());
+
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          {
+            write_binary(out, cell->face(f)->boundary_id());
+            write_binary(out, cell->face(f)->manifold_id());
+          }
+
+        if (dim == 3)
+          for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+            {
+              write_binary(out, cell->line(l)->boundary_id());
+              write_binary(out, cell->line(l)->manifold_id());
+            }
+      }
+  }
+
+  /**
+   * @brief Creates the coarse mesh stored by write_coarse_mesh in a
+   * triangulation. The cells are created in the order in which they were
+   * written, which reproduces the coarse mesh, and thus the p4est trees, of
+   * the simulation which wrote the cache.
+   */
+  template <int dim>
+  void
+  read_coarse_mesh(Triangulation<dim> &triangulation, std::istream &in)
+  {
+    read_cache_key(in);
+
+    std::uint64_t n_vertices = 0;
+    read_binary(in, n_vertices);
+    std::vector<Point<dim>> vertices(n_vertices);
+    for (Point<dim> &vertex : vertices)
+      for (unsigned int d = 0; d < dim; ++d)
+        read_binary(in, vertex[d]);
+
+    std::uint64_t n_cells = 0;
+    read_binary(in, n_cells);
+    std::vector<CellData<dim>>      cells(n_cells);
+    std::vector<types::boundary_id> face_boundary_ids(
+      n_cells * GeometryInfo<dim>::faces_per_cell);
+    std::vector<types::manifold_id> face_manifold_ids(
+      n_cells * GeometryInfo<dim>::faces_per_cell);
+    std::vector<types::boundary_id> line_boundary_ids(
+      dim == 3 ? n_cells * GeometryInfo<dim>::lines_per_cell : 0);
+    std::vector<types::manifold_id> line_manifold_ids(
+      dim == 3 ? n_cells * GeometryInfo<dim>::lines_per_cell : 0);
+
+    for (unsigned int c = 0; c < n_cells; ++c)
+      {
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          read_binary(in, cells[c].vertices[v]);
+        read_binary(in, cells[c].material_id);
+        read_binary(in, cells[c].manifold_id);
+
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          {
+            const unsigned int i = c * GeometryInfo<dim>::faces_per_cell + f;
+            read_binary(in, face_boundary_ids[i]);
+            read_binary(in, face_manifold_ids[i]);
+          }
+
+        if (dim == 3)
+          for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+            {
+              const unsigned int i = c * GeometryInfo<dim>::lines_per_cell + l;
+              read_binary(in, line_boundary_ids[i]);
+              read_binary(in, line_manifold_ids[i]);
+            }
+      }
+
+    if (!in)
+      throw std::runtime_error("Error, the mesh cache is corrupted");
+
+    triangulation.create_triangulation(vertices, cells, SubCellData());
+
+    unsigned int c = 0;
+    for (const auto &cell : triangulation.cell_iterators_on_level(0))
+      {
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          {
+            const unsigned int i = c * GeometryInfo<dim>::faces_per_cell + f;
+            if (cell->face(f)->at_boundary())
+              cell->face(f)->set_boundary_id(face_boundary_ids[i]);
+            cell->face(f)->set_manifold_id(face_manifold_ids[i]);
+          }
+
+        // The boundary ids of the lines are set after those of the faces,
+        // since they may differ from the ids of the faces which contain them
+        if (dim == 3)
+          for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+            {
+              const unsigned int i = c * GeometryInfo<dim>::lines_per_cell + l;
+              if (cell->line(l)->at_boundary())
+                cell->line(l)->set_boundary_id(line_boundary_ids[i]);
+              cell->line(l)->set_manifold_id(line_manifold_ids[i]);
+            }
+        ++c;
+      }
+  }
+} // namespace
 
 template <int dim>
 void
@@ -40,23 +269,7 @@ attach_grid_to_triangulation(
 
 
   // Setup periodic boundary conditions
-  for (unsigned int i_bc = 0; i_bc < boundary_conditions.size; ++i_bc)
-    {
-      if (boundary_conditions.type[i_bc] ==
-          BoundaryConditions::BoundaryType::periodic)
-        {
-          std::vector<GridTools::PeriodicFacePair<
-            typename Triangulation<dim>::cell_iterator>>
-            periodicity_vector;
-          GridTools::collect_periodic_faces(
-            *dynamic_cast<Triangulation<dim> *>(triangulation.get()),
-            boundary_conditions.id[i_bc],
-            boundary_conditions.periodic_id[i_bc],
-            boundary_conditions.periodic_direction[i_bc],
-            periodicity_vector);
-          triangulation->add_periodicity(periodicity_vector);
-        }
-    }
+  add_periodic_boundary_conditions(*triangulation, boundary_conditions);
 }
 
 template <int dim>
@@ -67,14 +280,89 @@ read_mesh_and_manifolds(
   const Parameters::Manifolds &                      manifolds_parameters,
   const BoundaryConditions::BoundaryConditions<dim> &boundary_conditions)
 {
+  auto distributed_triangulation =
+    dynamic_cast<parallel::distributed::Triangulation<dim> *>(
+      triangulation.get());
+  const bool use_cache =
+    mesh_parameters.use_cache && distributed_triangulation != nullptr;
+
+  const MPI_Comm mpi_communicator = triangulation->get_communicator();
+  const bool     is_root_process =
+    Utilities::MPI::this_mpi_process(mpi_communicator) == 0;
+
+  const std::string coarse_file_name =
+    mesh_parameters.cache_file_name + ".coarse";
+  const std::string forest_file_name =
+    mesh_parameters.cache_file_name + ".triangulation";
+
+  // The key of the mesh and the validity of the cache are established by the
+  // root process, which is the only one to read the mesh file
+  std::string cache_key;
+  if (use_cache)
+    {
+      unsigned int cache_is_valid = 1;
+      if (is_root_process)
+        {
+          cache_key = mesh_cache_key(mesh_parameters, boundary_conditions);
+          std::ifstream coarse_file(coarse_file_name, std::ios::binary);
+          std::ifstream forest_file(forest_file_name);
+          cache_is_valid = coarse_file && forest_file &&
+                           read_cache_key(coarse_file) == cache_key;
+        }
+      cache_is_valid = Utilities::MPI::min(cache_is_valid, mpi_communicator);
+
+      // The coarse GMSH mesh is read from the cache instead of parsing the
+      // mesh file again. The deal.II grids are generated again since they are
+      // cheap to create and may attach their own manifolds.
+      if (cache_is_valid)
+        {
+          if (mesh_parameters.type == Parameters::Mesh::Type::gmsh)
+            {
+              std::ifstream coarse_file(coarse_file_name, std::ios::binary);
+              read_coarse_mesh(*distributed_triangulation, coarse_file);
+              add_periodic_boundary_conditions(*triangulation,
+                                               boundary_conditions);
+            }
+          else
+            attach_grid_to_triangulation(triangulation,
+                                         mesh_parameters,
+                                         boundary_conditions);
+          attach_manifolds_to_triangulation(triangulation,
+                                            manifolds_parameters);
+          distributed_triangulation->load(forest_file_name);
+          return;
+        }
+    }
+
   attach_grid_to_triangulation(triangulation,
                                mesh_parameters,
                                boundary_conditions);
+
+  // The coarse mesh is kept before the manifolds modify its manifold ids
+  std::ostringstream coarse_mesh;
+  if (use_cache && is_root_process)
+    write_coarse_mesh(*triangulation, cache_key, coarse_mesh);
+
   attach_manifolds_to_triangulation(triangulation, manifolds_parameters);
 
   // Refine the triangulation to its initial size
   const int initialSize = mesh_parameters.initial_refinement;
   triangulation->refine_global(initialSize);
+
+  // The coarse mesh, which holds the key, is removed before the forest is
+  // saved and written once the save has finished, so that an interrupted
+  // write never leaves a previous key next to a partial forest
+  if (use_cache)
+    {
+      if (is_root_process)
+        std::remove(coarse_file_name.c_str());
+      distributed_triangulation->save(forest_file_name);
+      if (is_root_process)
+        {
+          std::ofstream coarse_file(coarse_file_name, std::ios::binary);
+          coarse_file << coarse_mesh.str();
+        }
+    }
 }
 
 template void attach_grid_to_triangulation(
@@ -0,0 +1,130 @@
+#include "core/load_balance_report.h"
+
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <set>
+
+namespace
+{
+  // Writes the rows of the statistics of a group of quantities
+  void
+  write_statistics(std::ostream &                            output,
+                   const std::string &                       title,
+                   const unsigned int                        name_width,
+                   const std::vector<LoadBalanceStatistics> &statistics)
+  {
+    output << std::left << std::setw(name_width) << title << std::right
+           << std::setw(12) << "Min" << std::setw(12) << "Avg"
+           << std::setw(12) << "Max" << std::setw(10) << "Max/Avg"
+           << std::setw(10) << "Min rank" << std::setw(10) << "Max rank"
+           << std::endl;
+
+    for (const LoadBalanceStatistics &quantity : statistics)
+      output << std::left << std::setw(name_width) << quantity.name
+             << std::right << std::scientific << std::setprecision(4)
+             << std::setw(12) << quantity.min << std::setw(12) << quantity.avg
+             << std::setw(12) << quantity.max << std::fixed
+             << std::setprecision(3) << std::setw(10) << quantity.imbalance()
+             << std::setw(10) << quantity.min_rank << std::setw(10)
+             << quantity.max_rank << std::endl;
+  }
+} // namespace
+
+std::vector<LoadBalanceStatistics>
+compute_load_balance_statistics(
+  const std::vector<std::map<std::string, double>> &values_by_rank)
+{
+  std::set<std::string> names;
+  for (const auto &values : values_by_rank)
+    for (const auto &value : values)
+      names.insert(value.first);
+
+  std::vector<LoadBalanceStatistics> statistics;
+  for (const std::string &name : names)
+    {
+      LoadBalanceStatistics quantity;
+      quantity.name     = name;
+      quantity.min_rank = 0;
+      quantity.max_rank = 0;
+
+      double sum = 0;
+      for (unsigned int rank = 0; rank < values_by_rank.size(); ++rank)
+        {
+          const auto   value_on_rank = values_by_rank[rank].find(name);
+          const double value = value_on_rank == values_by_rank[rank].end() ?
+                                 0. :
+                                 value_on_rank->second;
+          sum += value;
+
+          if (rank == 0 || value < quantity.min)
+            {
+              quantity.min      = value;
+              quantity.min_rank = rank;
+            }
+          if (rank == 0 || value > quantity.max)
+            {
+              quantity.max      = value;
+              quantity.max_rank = rank;
+            }
+        }
+      quantity.avg = sum / values_by_rank.size();
+      statistics.push_back(quantity);
+    }
+  return statistics;
+}
+
+void
+write_load_balance_report(std::ostream &                            output,
+                          const unsigned int                        n_ranks,
+                          const std::vector<LoadBalanceStatistics> &sections,
+                          const std::vector<LoadBalanceStatistics> &workload)
+{
+  const std::string sections_title = "Section (wall time in s)";
+  const std::string workload_title = "Workload";
+
+  std::size_t name_width =
+    std::max(sections_title.size(), workload_title.size());
+  for (const LoadBalanceStatistics &quantity : sections)
+    name_width = std::max(name_width, quantity.name.size());
+  for (const LoadBalanceStatistics &quantity : workload)
+    name_width = std::max(name_width, quantity.name.size());
+  name_width += 2;
+
+  const std::ios_base::fmtflags flags     = output.flags();
+  const std::streamsize         precision = output.precision();
+
+  output << std::endl
+         << "Load balance over " << n_ranks << " MPI rank(s)" << std::endl;
+  write_statistics(output, sections_title, name_width, sections);
+  output << std::endl;
+  write_statistics(output, workload_title, name_width, workload);
+  output << std::endl;
+
+  output.flags(flags);
+  output.precision(precision);
+}
+
+void
+print_load_balance_report(const std::map<std::string, double> &section_times,
+                          const std::map<std::string, double> &workload,
+                          const MPI_Comm &                     mpi_communicator,
+                          ConditionalOStream &                 pcout)
+{
+  // The values are gathered on the first rank, which knows the sections of
+  // all the ranks even if some of them were not entered everywhere
+  const std::vector<std::map<std::string, double>> section_times_by_rank =
+    Utilities::MPI::gather(mpi_communicator, section_times, 0);
+  const std::vector<std::map<std::string, double>> workload_by_rank =
+    Utilities::MPI::gather(mpi_communicator, workload, 0);
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0 &&
+      pcout.is_active())
+    write_load_balance_report(
+      pcout.get_stream(),
+      Utilities::MPI::n_mpi_processes(mpi_communicator),
+      compute_load_balance_statistics(section_times_by_rank),
+      compute_load_balance_statistics(workload_by_rank));
+}
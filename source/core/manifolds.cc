@@ -8,6 +8,7 @@
 #include <deal.II/opencascade/manifold_lib.h>
 #include <deal.II/opencascade/utilities.h>
 
+#include "core/cached_projection_manifold.h"
 #include "core/manifolds.h"
 
 namespace Parameters
@@ -251,8 +252,9 @@ void attach_cad_to_manifold(
 
   //  OpenCASCADE::NormalProjectionManifold<3,3> normal_projector(
   //        cad_surface, tolerance);
-  OpenCASCADE::NormalToMeshProjectionManifold<3, 3> normal_projector(
-    cad_surface, tolerance);
+  // The projections are cached since the refinement and the curved mappings
+  // project the same points again
+  CachedProjectionManifold<3, 3> normal_projector(cad_surface, tolerance);
 
   triangulation->set_manifold(manifold_id, normal_projector);
 #else
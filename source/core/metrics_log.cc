@@ -0,0 +1,108 @@
+#include "core/metrics_log.h"
+
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+MetricsLog::MetricsLog()
+{}
+
+MetricsLog::MetricsLog(const std::string &filename,
+                       const bool         write_to_file,
+                       const bool         append)
+{
+  if (write_to_file)
+    {
+      output = std::make_unique<std::ofstream>(
+        filename.c_str(), append ? std::ios::app : std::ios::trunc);
+      if (!*output)
+        throw(std::runtime_error("Unable to open the metrics log " +
+                                 filename));
+    }
+}
+
+void
+MetricsLog::add(const std::string &key, const std::vector<unsigned int> &values)
+{
+  std::ostringstream field;
+  field << "[";
+  for (unsigned int i = 0; i < values.size(); ++i)
+    field << (i > 0 ? "," : "") << values[i];
+  field << "]";
+  add_field(key, field.str());
+}
+
+void
+MetricsLog::add_increments(const std::string &                  key,
+                           const std::map<std::string, double> &totals)
+{
+  std::map<std::string, double> &previous = previous_totals[key];
+
+  std::ostringstream field;
+  field << "{";
+  bool first = true;
+  for (const auto &total : totals)
+    {
+      const auto   previous_total = previous.find(total.first);
+      const double increment =
+        (previous_total == previous.end() ||
+         total.second < previous_total->second) ?
+          total.second :
+          total.second - previous_total->second;
+
+      field << (first ? "" : ",") << quote(total.first) << ":";
+      write_number(field, increment);
+      first = false;
+    }
+  field << "}";
+
+  previous = totals;
+  add_field(key, field.str());
+}
+
+void
+MetricsLog::reset_increments(const std::string &key)
+{
+  previous_totals.erase(key);
+}
+
+void
+MetricsLog::write()
+{
+  if (output)
+    {
+      *output << "{" << record << "}\n";
+      output->flush();
+    }
+  record.clear();
+}
+
+void
+MetricsLog::add_field(const std::string &key, const std::string &value)
+{
+  if (!record.empty())
+    record += ",";
+  record += quote(key) + ":" + value;
+}
+
+void
+MetricsLog::write_number(std::ostream &output, const double value)
+{
+  if (std::isfinite(value))
+    output << std::setprecision(10) << value;
+  else
+    output << "null";
+}
+
+std::string
+MetricsLog::quote(const std::string &text)
+{
+  std::string quoted = "\"";
+  for (const char character : text)
+    {
+      if (character == '"' || character == '\\')
+        quoted += '\\';
+      quoted += character;
+    }
+  return quoted + "\"";
+}
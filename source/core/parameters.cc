@@ -32,6 +32,21 @@ namespace Parameters
                         "0",
                         Patterns::Integer(),
                         "Number of mesh adaptation (for steady simulations)");
+      prm.declare_entry("pseudo transient",
+                        "false",
+                        Patterns::Bool(),
+                        "Add a local pseudo-time term to the jacobian of "
+                        "steady simulations <true|false>. It cannot be "
+                        "used with the jfnk non-linear solver");
+      prm.declare_entry("pseudo cfl",
+                        "1",
+                        Patterns::Double(),
+                        "Initial CFL of the pseudo-time step. The CFL grows "
+                        "as the residual decreases");
+      prm.declare_entry("pseudo max cfl",
+                        "1e6",
+                        Patterns::Double(),
+                        "Maximal CFL of the pseudo-time step");
       prm.declare_entry("max cfl",
                         "1",
                         Patterns::Double(),
@@ -78,7 +93,33 @@ namespace Parameters
       prm.declare_entry("group files",
                         "1",
                         Patterns::Integer(),
-                        "Maximal number of vtu output files");
+                        "Maximal number of vtu output files. It cannot be "
+                        "larger than 1 with the asynchronous output");
+
+      prm.declare_entry("asynchronous output",
+                        "false",
+                        Patterns::Bool(),
+                        "Write the results from a background thread. Every "
+                        "process writes its own vtu file");
+
+      prm.declare_entry("asynchronous output buffer",
+                        "512",
+                        Patterns::Integer(),
+                        "Maximal size in megabytes of the results waiting "
+                        "to be written by the background thread");
+
+      prm.declare_entry(
+        "output format",
+        "vtu",
+        Patterns::Selection("vtu|hdf5"),
+        "Format of the results. Choices are <vtu|hdf5>. The hdf5 results are "
+        "written in a single file per output with collective MPI-IO and are "
+        "described by a xdmf file");
+
+      prm.declare_entry("hdf5 compression",
+                        "false",
+                        Patterns::Bool(),
+                        "Compression of the hdf5 results");
     }
     prm.leave_subsection();
   }
@@ -123,11 +164,47 @@ namespace Parameters
         prm.get_double("adaptative time step scaling");
       startup_timestep_scaling = prm.get_double("startup time scaling");
       number_mesh_adaptation   = prm.get_integer("number mesh adapt");
+      pseudo_transient         = prm.get_bool("pseudo transient");
+      pseudo_cfl               = prm.get_double("pseudo cfl");
+      pseudo_max_cfl           = prm.get_double("pseudo max cfl");
       output_folder            = prm.get("output path");
       output_name              = prm.get("output name");
       output_frequency         = prm.get_integer("output frequency");
       subdivision              = prm.get_integer("subdivision");
       group_files              = prm.get_integer("group files");
+      asynchronous_output      = prm.get_bool("asynchronous output");
+      asynchronous_output_buffer =
+        prm.get_integer("asynchronous output buffer");
+
+      // The background thread writes the results of every process to its own
+      // file and cannot group them
+      if (asynchronous_output && group_files > 1)
+        throw(std::runtime_error(
+          "The asynchronous output writes one vtu file per process and "
+          "cannot be combined with a number of group files larger than 1"));
+
+      const std::string format = prm.get("output format");
+      if (format == "vtu")
+        output_format = OutputFormat::vtu;
+      else if (format == "hdf5")
+        output_format = OutputFormat::hdf5;
+      else
+        throw(std::runtime_error("Invalid output format"));
+
+      hdf5_compression = prm.get_bool("hdf5 compression");
+
+#ifndef DEAL_II_WITH_HDF5
+      if (output_format == OutputFormat::hdf5)
+        throw(std::runtime_error(
+          "The hdf5 output format requires deal.II to be configured with "
+          "HDF5"));
+#endif
+#if !DEAL_II_VERSION_GTE(9, 3, 0)
+      if (hdf5_compression)
+        throw(std::runtime_error(
+          "The compression of the hdf5 results requires deal.II 9.3 or "
+          "later"));
+#endif
       log_frequency            = prm.get_integer("log frequency");
     }
     prm.leave_subsection();
@@ -143,6 +220,35 @@ namespace Parameters
                         Patterns::Selection("none|iteration|end"),
                         "Clock monitoring methods "
                         "Choices are <none|iteration|end>.");
+
+      prm.declare_entry(
+        "write metrics",
+        "false",
+        Patterns::Bool(),
+        "Write the performance metrics of each time step as a line of JSON: "
+        "the wall time of the timer sections during the step, the solver "
+        "iterations and the size of the problem.");
+
+      prm.declare_entry("metrics name",
+                        "metrics",
+                        Patterns::FileName(),
+                        "File output metrics");
+
+      prm.declare_entry(
+        "report load balance",
+        "false",
+        Patterns::Bool(),
+        "Report the minimum, average and maximum over the MPI ranks of the "
+        "wall time of each timer section and of the workload of the ranks, "
+        "with the ratio of the maximum to the average. The report is printed "
+        "at the end of the simulation.");
+
+      prm.declare_entry("load balance frequency",
+                        "0",
+                        Patterns::Integer(0),
+                        "Number of time steps between the load balance "
+                        "reports during the simulation. 0 only reports it "
+                        "at the end.");
     }
     prm.leave_subsection();
   }
@@ -159,6 +265,12 @@ namespace Parameters
         type = Type::iteration;
       else if (cl == "end")
         type = Type::end;
+
+      write_metrics       = prm.get_bool("write metrics");
+      metrics_output_name = prm.get("metrics name");
+
+      report_load_balance    = prm.get_bool("report load balance");
+      load_balance_frequency = prm.get_integer("load balance frequency");
     }
     prm.leave_subsection();
   }
@@ -207,6 +319,18 @@ namespace Parameters
                         "false",
                         Patterns::Bool(),
                         "Apply high order mapping everywhere");
+      prm.declare_entry(
+        "dof renumbering",
+        "automatic",
+        Patterns::Selection(
+          "automatic|none|cuthill_mckee|hierarchical|component_wise"),
+        "Renumbering of the degrees of freedom. "
+        "Choices are "
+        "<automatic|none|cuthill_mckee|hierarchical|component_wise>. "
+        "The automatic renumbering is cuthill_mckee for the gls solver and "
+        "none for the gd solver. "
+        "The hierarchical renumbering follows the space-filling curve "
+        "ordering of the cells of the distributed mesh.");
     }
     prm.leave_subsection();
   }
@@ -220,6 +344,20 @@ namespace Parameters
       pressure_order           = prm.get_integer("pressure order");
       number_quadrature_points = prm.get_integer("quadrature points");
       qmapping_all             = prm.get_bool("qmapping all");
+
+      const std::string dr = prm.get("dof renumbering");
+      if (dr == "automatic")
+        dof_renumbering = DofRenumbering::automatic;
+      else if (dr == "none")
+        dof_renumbering = DofRenumbering::none;
+      else if (dr == "cuthill_mckee")
+        dof_renumbering = DofRenumbering::cuthill_mckee;
+      else if (dr == "hierarchical")
+        dof_renumbering = DofRenumbering::hierarchical;
+      else if (dr == "component_wise")
+        dof_renumbering = DofRenumbering::component_wise;
+      else
+        throw(std::runtime_error("Invalid dof renumbering"));
     }
     prm.leave_subsection();
   }
@@ -344,6 +482,32 @@ namespace Parameters
                         "1",
                         Patterns::Integer(),
                         "Output frequency");
+
+      prm.declare_entry(
+        "calculate time-averaged statistics",
+        "false",
+        Patterns::Bool(),
+        "Enable the calculation of the time-averaged statistics of the "
+        "solution: the mean velocity and pressure, the variance of the "
+        "velocity and pressure fluctuations and the Reynolds stresses.");
+
+      prm.declare_entry("statistics initial time",
+                        "0",
+                        Patterns::Double(),
+                        "Time from which the statistics are averaged");
+
+      prm.declare_entry(
+        "statistics output frequency",
+        "0",
+        Patterns::Integer(0),
+        "Frequency of the output of the statistics. The statistics are "
+        "always written at the end of the simulation and 0 writes them "
+        "only then.");
+
+      prm.declare_entry("statistics name",
+                        "statistics",
+                        Patterns::FileName(),
+                        "File output statistics");
     }
     prm.leave_subsection();
   }
@@ -366,6 +530,12 @@ namespace Parameters
       enstrophy_output_name      = prm.get("enstrophy name");
       calculation_frequency      = prm.get_integer("calculation frequency");
       output_frequency           = prm.get_integer("output frequency");
+      calculate_time_averaged_statistics =
+        prm.get_bool("calculate time-averaged statistics");
+      statistics_initial_time = prm.get_double("statistics initial time");
+      statistics_output_frequency =
+        prm.get_integer("statistics output frequency");
+      statistics_output_name = prm.get("statistics name");
     }
     prm.leave_subsection();
   }
@@ -385,13 +555,21 @@ namespace Parameters
       prm.declare_entry(
         "solver",
         "newton",
-        Patterns::Selection("newton|skip_newton"),
+        Patterns::Selection("newton|skip_newton|picard|jfnk"),
         "Non-linear solver that will be used "
-        "Choices are <newton|skip_newton>."
+        "Choices are <newton|skip_newton|picard|jfnk>."
         " The newton solver is a traditional newton solver with"
         "an analytical jacobian formulation. The jacobian matrix and the preconditioner"
         "are assembled every iteration. In the skip_newton method, the jacobian matrix and"
-        "the pre-conditioner are re-assembled every skip_iteration.");
+        "the pre-conditioner are re-assembled every skip_iteration. The picard"
+        " solver is a fixed-point iteration with Anderson acceleration in which"
+        " the matrix is the Oseen linearization of the equations, where the"
+        " present iterate advects the velocity. The jfnk solver is a"
+        " jacobian-free Newton-Krylov solver"
+        " in which the Picard linearization is only assembled to build the"
+        " preconditioner, which is kept for the jfnk preconditioner lifetime."
+        " The matrix is then released, unless the preconditioner refers to it"
+        " as the amg preconditioner and the direct solver do.");
 
       prm.declare_entry("tolerance",
                         "1e-6",
@@ -409,6 +587,45 @@ namespace Parameters
         "Non-linear iterations to skip before rebuilding the jacobian matrix "
         "and the preconditioner");
 
+      prm.declare_entry(
+        "skip policy",
+        "fixed",
+        Patterns::Selection("fixed|adaptive"),
+        "Policy used by the skip_newton solver to rebuild the jacobian matrix. "
+        "Choices are <fixed|adaptive>."
+        " With the fixed policy, the jacobian matrix and the preconditioner are"
+        " re-assembled every skip iterations. With the adaptive policy, they are"
+        " kept as long as the residual contraction rate stays below the skip"
+        " contraction threshold and the line search is not needed.");
+
+      prm.declare_entry("skip contraction threshold",
+                        "0.1",
+                        Patterns::Double(),
+                        "Maximal ratio between two successive non-linear "
+                        "residuals for which the jacobian matrix is kept with "
+                        "the adaptive skip policy");
+
+      prm.declare_entry("anderson depth",
+                        "5",
+                        Patterns::Integer(),
+                        "Number of previous iterates used by the Anderson "
+                        "acceleration of the picard solver");
+
+      prm.declare_entry("jfnk forcing term",
+                        "1e-2",
+                        Patterns::Double(),
+                        "Relative tolerance of the Krylov solver used by the "
+                        "jfnk solver to calculate the Newton correction");
+
+      prm.declare_entry("jfnk preconditioner lifetime",
+                        "10",
+                        Patterns::Integer(1),
+                        "Non-linear iterations, over successive solutions, "
+                        "during which the jfnk solver keeps its "
+                        "preconditioner. The jacobian matrix is only "
+                        "assembled to rebuild it, when its lifetime is over "
+                        "or when the Krylov solver does not converge.");
+
       prm.declare_entry("residual precision",
                         "4",
                         Patterns::Integer(),
@@ -435,13 +652,31 @@ namespace Parameters
         solver = SolverType::newton;
       else if (str_solver == "skip_newton")
         solver = SolverType::skip_newton;
+      else if (str_solver == "picard")
+        solver = SolverType::picard;
+      else if (str_solver == "jfnk")
+        solver = SolverType::jfnk;
       else
         throw(std::runtime_error("Invalid non-linear solver "));
 
+      const std::string str_skip_policy = prm.get("skip policy");
+      if (str_skip_policy == "fixed")
+        skip_policy = SkipPolicy::fixed;
+      else if (str_skip_policy == "adaptive")
+        skip_policy = SkipPolicy::adaptive;
+      else
+        throw(std::runtime_error("Invalid skip policy "));
+
       tolerance         = prm.get_double("tolerance");
       max_iterations    = prm.get_integer("max iterations");
       skip_iterations   = prm.get_integer("skip iterations");
       display_precision = prm.get_integer("residual precision");
+      skip_contraction_threshold =
+        prm.get_double("skip contraction threshold");
+      anderson_depth    = prm.get_integer("anderson depth");
+      jfnk_forcing_term = prm.get_double("jfnk forcing term");
+      jfnk_preconditioner_lifetime =
+        prm.get_integer("jfnk preconditioner lifetime");
     }
     prm.leave_subsection();
   }
@@ -469,6 +704,18 @@ namespace Parameters
 
       prm.declare_entry("grid type", "hyper_cube");
       prm.declare_entry("grid arguments", "-1 : 1 : false");
+
+      prm.declare_entry("use cache",
+                        "false",
+                        Patterns::Bool(),
+                        "Store the refined and partitioned mesh in a cache "
+                        "which is loaded by the next simulations using the "
+                        "same mesh <true|false>");
+
+      prm.declare_entry("cache file name",
+                        "mesh_cache",
+                        Patterns::FileName(),
+                        "Prefix of the files of the mesh cache");
     }
     prm.leave_subsection();
   }
@@ -495,6 +742,9 @@ namespace Parameters
 
       grid_type      = prm.get("grid type");
       grid_arguments = prm.get("grid arguments");
+
+      use_cache       = prm.get_bool("use cache");
+      cache_file_name = prm.get("cache file name");
     }
     prm.leave_subsection();
   }
@@ -518,7 +768,7 @@ namespace Parameters
       prm.declare_entry(
         "method",
         "gmres",
-        Patterns::Selection("gmres|bicgstab|amg"),
+        Patterns::Selection("gmres|bicgstab|amg|direct"),
         "The iterative solver for the linear system of equations. "
         "Choices are <gmres|bicgstab|amg|direct>. gmres is a GMRES iterative "
         "solver "
@@ -529,7 +779,45 @@ namespace Parameters
         "preconditioning is more efficient. "
         "As the number of mesh elements increase, the amg solver is the most "
         "efficient. Generally, at 1M elements, the amg solver always "
-        "outperforms the gmres or bicgstab");
+        "outperforms the gmres or bicgstab. direct is a sparse direct solver "
+        "whose factorization is only recomputed when the matrix is renewed. "
+        "It is efficient for small problems.");
+      prm.declare_entry("direct solver type",
+                        "Amesos_Klu",
+                        Patterns::Anything(),
+                        "Amesos solver used by the direct method. "
+                        "For example Amesos_Klu, Amesos_Umfpack or "
+                        "Amesos_Mumps depending on the Trilinos installation");
+      prm.declare_entry("krylov recycling vectors",
+                        "0",
+                        Patterns::Integer(),
+                        "Maximal number of vectors of the Krylov subspace "
+                        "recycled between successive linear solutions by the "
+                        "gmres and amg methods. If it is larger than zero, "
+                        "the GMRES solver is replaced by a recycling FGMRES "
+                        "solver.");
+      prm.declare_entry(
+        "vector backend",
+        "trilinos",
+        Patterns::Selection("trilinos|dealii"),
+        "Parallel vector used for the solution and the right-hand side. "
+        "Choices are <trilinos|dealii>. The dealii distributed vectors have "
+        "threaded and vectorized operations, which speeds up the vector "
+        "operations of the non-linear and linear solvers. The matrix and the "
+        "preconditioners are the Trilinos ones with both vectors. The dealii "
+        "vectors are only available with the gls solver.");
+      prm.declare_entry(
+        "autotune",
+        "false",
+        Patterns::Bool(),
+        "Solve the first linear system with a small set of solvers and "
+        "preconditioner parameters and keep the fastest configuration, "
+        "set-up included, for the rest of the simulation. The method is "
+        "selected first, then the ilu preconditioner fill or the amg "
+        "aggregation threshold, smoother sweeps and number of cycles. The "
+        "selected parameters are written to autotuned_linear_solver.prm in "
+        "the output folder. Not used by the jfnk non-linear solver, which "
+        "does not solve the linear systems with a matrix.");
       prm.declare_entry("relative residual",
                         "1e-3",
                         Patterns::Double(),
@@ -543,6 +831,13 @@ namespace Parameters
                         Patterns::Integer(),
                         "Maximum solver iterations");
 
+      prm.declare_entry("max krylov vectors",
+                        "30",
+                        Patterns::Integer(1),
+                        "Dimension of the Krylov subspace of the GMRES "
+                        "solvers, including the one of the jfnk non-linear "
+                        "solver, before they restart");
+
       prm.declare_entry("ilu preconditioner fill",
                         "0",
                         Patterns::Double(),
@@ -558,6 +853,26 @@ namespace Parameters
                         Patterns::Double(),
                         "Ilu relative tolerance");
 
+      prm.declare_entry(
+        "ilu preconditioner precision",
+        "double",
+        Patterns::Selection("double|single"),
+        "Precision in which the ILU factors are stored and applied. "
+        "Choices are <double|single>. The single precision factors use half "
+        "of the memory and are faster to apply, while the Krylov solver "
+        "remains in double precision. The single precision ILU is a block "
+        "Jacobi ILU which uses the ilu preconditioner tolerances. It does not "
+        "use the ilu preconditioner fill, its pattern is extended by the ilu "
+        "preconditioner off diagonals instead. The jfnk non-linear solver "
+        "always uses the single precision ILU.");
+
+      prm.declare_entry(
+        "ilu preconditioner off diagonals",
+        "0",
+        Patterns::Integer(0),
+        "Number of off-diagonals added on each side of the diagonal to the "
+        "pattern of the single precision ILU factors");
+
       prm.declare_entry("amg preconditioner ilu fill",
                         "0",
                         Patterns::Double(),
@@ -620,19 +935,46 @@ namespace Parameters
         solver = SolverType::gmres;
       else if (sv == "bicgstab")
         solver = SolverType::bicgstab;
+      else if (sv == "direct")
+        solver = SolverType::direct;
       else
         throw std::runtime_error(
-          "Error, invalid iterative solver type. Choices are amg, gmres or bicgstab");
+          "Error, invalid iterative solver type. Choices are amg, gmres, bicgstab or direct");
+
+      direct_solver_type       = prm.get("direct solver type");
+      krylov_recycling_vectors = prm.get_integer("krylov recycling vectors");
+
+      const std::string backend = prm.get("vector backend");
+      if (backend == "trilinos")
+        vector_backend = VectorBackend::trilinos;
+      else if (backend == "dealii")
+        vector_backend = VectorBackend::dealii;
+      else
+        throw(std::runtime_error("Invalid vector backend"));
+
+      autotune = prm.get_bool("autotune");
 
       residual_precision = prm.get_integer("residual precision");
       relative_residual  = prm.get_double("relative residual");
       minimum_residual   = prm.get_double("minimum residual");
       max_iterations     = prm.get_integer("max iters");
+      max_krylov_vectors = prm.get_integer("max krylov vectors");
       ilu_precond_fill   = prm.get_double("ilu preconditioner fill");
       ilu_precond_atol =
         prm.get_double("ilu preconditioner absolute tolerance");
       ilu_precond_rtol =
         prm.get_double("ilu preconditioner relative tolerance");
+
+      const std::string precision = prm.get("ilu preconditioner precision");
+      if (precision == "double")
+        ilu_precision = Precision::double_precision;
+      else if (precision == "single")
+        ilu_precision = Precision::single_precision;
+      else
+        throw(std::runtime_error("Invalid ilu preconditioner precision"));
+      ilu_precond_off_diagonals =
+        prm.get_integer("ilu preconditioner off diagonals");
+
       amg_precond_ilu_fill = prm.get_double("amg preconditioner ilu fill");
       amg_precond_ilu_atol =
         prm.get_double("amg preconditioner ilu absolute tolerance");
@@ -780,6 +1122,30 @@ namespace Parameters
                         "1",
                         Patterns::Integer(),
                         "Frequency for checkpointing");
+
+      prm.declare_entry(
+        "checkpoint generations",
+        "2",
+        Patterns::Integer(2),
+        "Number of checkpoints kept, at least 2 so that a checkpoint is never "
+        "overwritten in place. The checkpoints are written in turn to "
+        "filename_00, filename_01, etc. and the restart uses the most recent "
+        "checkpoint whose files match their checksums.");
+
+      prm.declare_entry(
+        "walltime",
+        "0",
+        Patterns::Double(0),
+        "Wall time allowed to the simulation in seconds. A checkpoint is "
+        "written once the remaining wall time falls below the checkpoint "
+        "before walltime. 0 disables this checkpoint.");
+
+      prm.declare_entry(
+        "checkpoint before walltime",
+        "600",
+        Patterns::Double(0),
+        "Time in seconds before the walltime at which a checkpoint is "
+        "written");
     }
     prm.leave_subsection();
   }
@@ -793,6 +1159,10 @@ namespace Parameters
       checkpoint = prm.get_bool("checkpoint");
       restart    = prm.get_bool("restart");
       frequency  = prm.get_integer("frequency");
+
+      n_generations              = prm.get_integer("checkpoint generations");
+      walltime                   = prm.get_double("walltime");
+      walltime_checkpoint_margin = prm.get_double("checkpoint before walltime");
     }
     prm.leave_subsection();
   }
@@ -851,4 +1221,123 @@ namespace Parameters
     }
     prm.leave_subsection();
   }
+
+  void
+  Ensemble::declare_parameters(ParameterHandler &prm)
+  {
+    prm.enter_subsection("ensemble");
+    {
+      prm.declare_entry("viscosities",
+                        "",
+                        Patterns::List(Patterns::Double()),
+                        "Comma-separated kinematic viscosity of each variant");
+      prm.declare_entry("velocity scales",
+                        "",
+                        Patterns::List(Patterns::Double()),
+                        "Comma-separated factor applied to the velocity of "
+                        "the function boundary conditions of each variant");
+      prm.declare_entry("angular velocity scales",
+                        "",
+                        Patterns::List(Patterns::Double()),
+                        "Comma-separated factor applied to the angular "
+                        "velocity of the velocity source of each variant");
+    }
+    prm.leave_subsection();
+  }
+
+  void
+  Ensemble::parse_parameters(ParameterHandler &prm)
+  {
+    prm.enter_subsection("ensemble");
+    {
+      viscosities = Utilities::string_to_double(
+        Utilities::split_string_list(prm.get("viscosities")));
+      velocity_scales = Utilities::string_to_double(
+        Utilities::split_string_list(prm.get("velocity scales")));
+      angular_velocity_scales = Utilities::string_to_double(
+        Utilities::split_string_list(prm.get("angular velocity scales")));
+    }
+    prm.leave_subsection();
+
+    n_variants = std::max(viscosities.size(),
+                          std::max(velocity_scales.size(),
+                                   angular_velocity_scales.size()));
+
+    for (const auto *list :
+         {&viscosities, &velocity_scales, &angular_velocity_scales})
+      if (!list->empty() && list->size() != n_variants)
+        throw(std::runtime_error(
+          "Error, the lists of the ensemble must be empty or have the same "
+          "number of variants"));
+  }
+
+  void
+  Probes::declare_parameters(ParameterHandler &prm)
+  {
+    prm.enter_subsection("probes");
+    {
+      prm.declare_entry("enable",
+                        "false",
+                        Patterns::Bool(),
+                        "Enable the sampling of the probes");
+      prm.declare_entry("frequency",
+                        "1",
+                        Patterns::Integer(1),
+                        "Sampling frequency of the probes in iterations");
+      prm.declare_entry("output name",
+                        "probes",
+                        Patterns::FileName(),
+                        "Prefix of the probe output files");
+      prm.declare_entry("precision",
+                        "10",
+                        Patterns::Integer(1),
+                        "Number of digits of the sampled values");
+      prm.declare_entry("points",
+                        "",
+                        Patterns::Anything(),
+                        "Semicolon-separated points, each given by its "
+                        "comma-separated coordinates");
+      prm.declare_entry("lines",
+                        "",
+                        Patterns::Anything(),
+                        "Semicolon-separated lines, each given by the "
+                        "comma-separated coordinates of its start and end "
+                        "points followed by its number of samples");
+      prm.declare_entry("planes",
+                        "",
+                        Patterns::Anything(),
+                        "Semicolon-separated planes, each given by the "
+                        "comma-separated coordinates of its origin and of its "
+                        "two edge vectors followed by the number of samples "
+                        "along each edge");
+    }
+    prm.leave_subsection();
+  }
+
+  void
+  Probes::parse_parameters(ParameterHandler &prm)
+  {
+    // Converts a semicolon-separated list of comma-separated values
+    auto parse_probes = [&prm](const std::string &entry) {
+      std::vector<std::vector<double>> probes;
+      const std::vector<std::string> descriptions =
+        Utilities::split_string_list(prm.get(entry), ';');
+      for (const auto &description : descriptions)
+        probes.push_back(Utilities::string_to_double(
+          Utilities::split_string_list(description)));
+      return probes;
+    };
+
+    prm.enter_subsection("probes");
+    {
+      enable      = prm.get_bool("enable");
+      frequency   = prm.get_integer("frequency");
+      output_name = prm.get("output name");
+      precision   = prm.get_integer("precision");
+      points      = parse_probes("points");
+      lines       = parse_probes("lines");
+      planes      = parse_probes("planes");
+    }
+    prm.leave_subsection();
+  }
 } // namespace Parameters
@@ -10,6 +10,12 @@ PVDHandler::save(std::string prefix)
 {
   std::string   filename = prefix + ".pvdhandler";
   std::ofstream output(filename.c_str());
+  save(output);
+}
+
+void
+PVDHandler::save(std::ostream &output) const
+{
   output << times_and_names.size() << std::endl;
   output << "Time File" << std::endl;
   for (unsigned int i = 0; i < times_and_names.size(); ++i)
@@ -54,6 +54,12 @@ SimulationControl::save(std::string prefix)
 {
   std::string   filename = prefix + ".simulationcontrol";
   std::ofstream output(filename.c_str());
+  save(output);
+}
+
+void
+SimulationControl::save(std::ostream &output) const
+{
   output << "Simulation control" << std::endl;
   for (unsigned int i = 0; i < time_step_vector.size(); ++i)
     output << "dt_" << i << " " << time_step_vector[i] << std::endl;
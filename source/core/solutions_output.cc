@@ -11,6 +11,7 @@
 // Std
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 template <int dim, int spacedim>
 void
@@ -70,6 +71,94 @@ write_vtu_and_pvd(PVDHandler &                           pvd_handler,
   }
 }
 
+template <int dim, int spacedim>
+void
+write_vtu_and_pvd(AsyncOutputWriter &                    output_writer,
+                  PVDHandler &                           pvd_handler,
+                  const DataOutInterface<dim, spacedim> &data_out,
+                  const std::string                      folder,
+                  const std::string                      file_prefix,
+                  const double                           time,
+                  const unsigned int                     iter,
+                  const MPI_Comm &                       mpi_communicator,
+                  const unsigned int                     digits)
+{
+  const unsigned int my_id = Utilities::MPI::this_mpi_process(mpi_communicator);
+  const std::string  iter_prefix =
+    file_prefix + "." + Utilities::int_to_string(iter, digits) + ".";
+
+  // Write master files (.pvtu,.pvd) on the master process. The pvd is updated
+  // in memory, which keeps the pvd handler of the checkpoints up to date.
+  if (my_id == 0)
+    {
+      std::vector<std::string> filenames;
+      const unsigned int       n_processes =
+        Utilities::MPI::n_mpi_processes(mpi_communicator);
+      for (unsigned int i = 0; i < n_processes; ++i)
+        filenames.push_back(iter_prefix + Utilities::int_to_string(i, digits) +
+                            ".vtu");
+
+      const std::string  pvtu_filename = iter_prefix + "pvtu";
+      std::ostringstream pvtu_output;
+      data_out.write_pvtu_record(pvtu_output, filenames);
+      output_writer.write(folder + pvtu_filename, pvtu_output.str());
+
+      pvd_handler.append(time, pvtu_filename);
+      std::ostringstream pvd_output;
+      DataOutBase::write_pvd_record(pvd_output, pvd_handler.times_and_names);
+      output_writer.write(folder + file_prefix + ".pvd", pvd_output.str());
+    }
+
+  std::ostringstream vtu_output;
+  data_out.write_vtu(vtu_output);
+  output_writer.write(folder + iter_prefix +
+                        Utilities::int_to_string(my_id, digits) + ".vtu",
+                      vtu_output.str());
+}
+
+template <int dim, int spacedim>
+void
+write_hdf5_and_xdmf(XDMFHandler &                    xdmf_handler,
+                    DataOutInterface<dim, spacedim> &data_out,
+                    const std::string                folder,
+                    const std::string                file_prefix,
+                    const double                     time,
+                    const unsigned int               iter,
+                    const bool                       compression,
+                    const MPI_Comm &                 mpi_communicator,
+                    const unsigned int               digits)
+{
+#if DEAL_II_VERSION_GTE(9, 3, 0)
+  DataOutBase::Hdf5Flags flags;
+  flags.compression_level =
+    compression ? DataOutBase::CompressionLevel::default_compression :
+                  DataOutBase::CompressionLevel::no_compression;
+  data_out.set_flags(flags);
+#else
+  // The compression is rejected by the parameters for older deal.II versions
+  (void)compression;
+#endif
+
+  // The vertices shared by neighboring cells are only written once
+  DataOutBase::DataOutFilter data_filter(
+    DataOutBase::DataOutFilterFlags(true, true));
+  data_out.write_filtered_data(data_filter);
+
+  const std::string h5_filename =
+    file_prefix + "." + Utilities::int_to_string(iter, digits) + ".h5";
+  data_out.write_hdf5_parallel(data_filter,
+                               folder + h5_filename,
+                               mpi_communicator);
+
+  // The hdf5 files are referred to relatively to the xdmf file
+  xdmf_handler.entries.push_back(data_out.create_xdmf_entry(data_filter,
+                                                            h5_filename,
+                                                            time,
+                                                            mpi_communicator));
+  xdmf_handler.write_xdmf_file(folder + file_prefix + ".xdmf",
+                               mpi_communicator);
+}
+
 template <int dim>
 void
 write_boundaries_vtu(const DataOutFaces<dim> &data_out_faces,
@@ -139,6 +228,95 @@ write_vtu_and_pvd(PVDHandler &                  pvd_handler,
                   const MPI_Comm &              mpi_communicator,
                   const unsigned int            digits);
 
+template void
+write_vtu_and_pvd(AsyncOutputWriter &           output_writer,
+                  PVDHandler &                  pvd_handler,
+                  const DataOutInterface<2, 2> &data_out,
+                  const std::string             folder,
+                  const std::string             file_prefix,
+                  const double                  time,
+                  const unsigned int            iter,
+                  const MPI_Comm &              mpi_communicator,
+                  const unsigned int            digits);
+
+template void
+write_vtu_and_pvd(AsyncOutputWriter &           output_writer,
+                  PVDHandler &                  pvd_handler,
+                  const DataOutInterface<3, 3> &data_out,
+                  const std::string             folder,
+                  const std::string             file_prefix,
+                  const double                  time,
+                  const unsigned int            iter,
+                  const MPI_Comm &              mpi_communicator,
+                  const unsigned int            digits);
+
+template void
+write_vtu_and_pvd(AsyncOutputWriter &           output_writer,
+                  PVDHandler &                  pvd_handler,
+                  const DataOutInterface<0, 2> &data_out,
+                  const std::string             folder,
+                  const std::string             file_prefix,
+                  const double                  time,
+                  const unsigned int            iter,
+                  const MPI_Comm &              mpi_communicator,
+                  const unsigned int            digits);
+
+template void
+write_vtu_and_pvd(AsyncOutputWriter &           output_writer,
+                  PVDHandler &                  pvd_handler,
+                  const DataOutInterface<0, 3> &data_out,
+                  const std::string             folder,
+                  const std::string             file_prefix,
+                  const double                  time,
+                  const unsigned int            iter,
+                  const MPI_Comm &              mpi_communicator,
+                  const unsigned int            digits);
+
+
+template void
+write_hdf5_and_xdmf(XDMFHandler &           xdmf_handler,
+                    DataOutInterface<2, 2> &data_out,
+                    const std::string       folder,
+                    const std::string       file_prefix,
+                    const double            time,
+                    const unsigned int      iter,
+                    const bool              compression,
+                    const MPI_Comm &        mpi_communicator,
+                    const unsigned int      digits);
+
+template void
+write_hdf5_and_xdmf(XDMFHandler &           xdmf_handler,
+                    DataOutInterface<3, 3> &data_out,
+                    const std::string       folder,
+                    const std::string       file_prefix,
+                    const double            time,
+                    const unsigned int      iter,
+                    const bool              compression,
+                    const MPI_Comm &        mpi_communicator,
+                    const unsigned int      digits);
+
+template void
+write_hdf5_and_xdmf(XDMFHandler &           xdmf_handler,
+                    DataOutInterface<0, 2> &data_out,
+                    const std::string       folder,
+                    const std::string       file_prefix,
+                    const double            time,
+                    const unsigned int      iter,
+                    const bool              compression,
+                    const MPI_Comm &        mpi_communicator,
+                    const unsigned int      digits);
+
+template void
+write_hdf5_and_xdmf(XDMFHandler &           xdmf_handler,
+                    DataOutInterface<0, 3> &data_out,
+                    const std::string       folder,
+                    const std::string       file_prefix,
+                    const double            time,
+                    const unsigned int      iter,
+                    const bool              compression,
+                    const MPI_Comm &        mpi_communicator,
+                    const unsigned int      digits);
+
 
 template void
 write_boundaries_vtu(const DataOutFaces<2> &data_out_faces,
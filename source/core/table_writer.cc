@@ -0,0 +1,142 @@
+#include "core/table_writer.h"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+TableWriter::TableWriter()
+  : precision(0)
+  , write_to_file(false)
+  , max_buffered_rows(0)
+  , written_rows(0)
+  , file_created(false)
+{}
+
+TableWriter::TableWriter(const std::string &             filename,
+                         const std::vector<std::string> &column_names,
+                         const unsigned int              precision,
+                         const bool                      write_to_file,
+                         const unsigned int              max_buffered_rows)
+  : filename(filename)
+  , column_names(column_names)
+  , precision(precision)
+  , write_to_file(write_to_file)
+  , max_buffered_rows(max_buffered_rows)
+  , written_rows(0)
+  , file_created(false)
+{}
+
+void
+TableWriter::add_row(const std::vector<double> &values)
+{
+  if (values.size() != column_names.size())
+    throw(std::runtime_error("The row added to the table " + filename +
+                             " does not have one value for each column"));
+
+  buffered_rows.push_back(values);
+  if (buffered_rows.size() >= max_buffered_rows)
+    flush();
+}
+
+void
+TableWriter::flush()
+{
+  if (write_to_file && (!buffered_rows.empty() || !file_created))
+    {
+      std::ofstream output(filename.c_str(),
+                           file_created ? std::ios::app : std::ios::trunc);
+      if (!output)
+        throw(std::runtime_error("Unable to open the table file " + filename));
+
+      if (!file_created)
+        {
+          for (unsigned int i = 0; i < column_names.size(); ++i)
+            output << (i > 0 ? " " : "") << column_names[i];
+          output << std::endl;
+          file_created = true;
+        }
+
+      output << std::fixed << std::setprecision(precision);
+      for (const auto &row : buffered_rows)
+        {
+          for (unsigned int i = 0; i < row.size(); ++i)
+            output << (i > 0 ? " " : "") << row[i];
+          output << "\n";
+        }
+      output.flush();
+    }
+
+  written_rows += buffered_rows.size();
+  buffered_rows.clear();
+}
+
+void
+TableWriter::save(const std::string &prefix)
+{
+  if (write_to_file)
+    {
+      std::string   checkpoint_filename = prefix + ".tablewriter";
+      std::ofstream output(checkpoint_filename.c_str());
+      save(output);
+    }
+  else
+    flush();
+}
+
+void
+TableWriter::save(std::ostream &output)
+{
+  flush();
+  output << written_rows << std::endl;
+}
+
+void
+TableWriter::read(const std::string &prefix)
+{
+  buffered_rows.clear();
+
+  // Checkpoints written before the tables were saved do not hold the number
+  // of rows. The new rows are then appended to the rows already in the file.
+  std::string   checkpoint_filename = prefix + ".tablewriter";
+  std::ifstream input(checkpoint_filename.c_str());
+  if (!input)
+    {
+      written_rows = 0;
+      file_created = false;
+      if (!write_to_file)
+        return;
+
+      std::ifstream table(filename.c_str());
+      std::string   line;
+      if (std::getline(table, line))
+        {
+          file_created = true;
+          while (std::getline(table, line))
+            ++written_rows;
+        }
+      return;
+    }
+
+  input >> written_rows;
+  file_created = true;
+
+  if (!write_to_file)
+    return;
+
+  // Keep the header and the rows of the checkpoint. The file is rewritten only
+  // once, when the simulation is restarted.
+  std::vector<std::string> lines;
+  {
+    std::ifstream table(filename.c_str());
+    std::string   line;
+    while (lines.size() < written_rows + 1 && std::getline(table, line))
+      lines.push_back(line);
+  }
+  if (lines.size() != written_rows + 1)
+    throw(std::runtime_error("The table file " + filename +
+                             " contains fewer rows than its checkpoint"));
+
+  std::ofstream output(filename.c_str(), std::ios::trunc);
+  for (const auto &line : lines)
+    output << line << "\n";
+}
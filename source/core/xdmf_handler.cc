@@ -0,0 +1,113 @@
+#include "core/xdmf_handler.h"
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <fstream>
+#include <stdexcept>
+
+using namespace dealii;
+
+namespace
+{
+  // The header and the footer of the xdmf file are those written by
+  // DataOutInterface::write_xdmf_file
+  const std::string xdmf_header =
+    "<?xml version=\"1.0\" ?>\n"
+    "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n"
+    "<Xdmf Version=\"2.0\">\n"
+    "  <Domain>\n"
+    "    <Grid Name=\"CellTime\" GridType=\"Collection\" "
+    "CollectionType=\"Temporal\">\n";
+
+  const std::string xdmf_footer = "    </Grid>\n"
+                                  "  </Domain>\n"
+                                  "</Xdmf>\n";
+} // namespace
+
+XDMFHandler::XDMFHandler()
+  : n_written_entries(0)
+{}
+
+void
+XDMFHandler::write_xdmf_file(const std::string &filename,
+                             const MPI_Comm &   mpi_communicator)
+{
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+    {
+      // The new entries replace the footer of the file, which is checked
+      // beforehand so that a file modified since the last output is written
+      // again completely
+      bool append = false;
+      if (n_written_entries > 0)
+        {
+          std::ifstream input(filename.c_str(), std::ios::binary);
+          input.seekg(0, std::ios::end);
+          const std::streamoff size = input ? std::streamoff(input.tellg()) : 0;
+          if (size >= std::streamoff(xdmf_footer.size()))
+            {
+              std::string footer(xdmf_footer.size(), ' ');
+              input.seekg(size - std::streamoff(xdmf_footer.size()));
+              input.read(&footer[0], footer.size());
+              append = input && footer == xdmf_footer;
+            }
+        }
+
+      std::ofstream output;
+      if (append)
+        {
+          output.open(filename.c_str(),
+                      std::ios::in | std::ios::out | std::ios::binary);
+          output.seekp(-std::streamoff(xdmf_footer.size()), std::ios::end);
+        }
+      else
+        {
+          output.open(filename.c_str(), std::ios::trunc | std::ios::binary);
+          output << xdmf_header;
+          n_written_entries = 0;
+        }
+      if (!output)
+        throw(std::runtime_error("Unable to open the xdmf file " + filename));
+
+      for (unsigned int i = n_written_entries; i < entries.size(); ++i)
+        output << entries[i].get_xdmf_content(3);
+      output << xdmf_footer;
+    }
+
+  n_written_entries = entries.size();
+}
+
+void
+XDMFHandler::save(const std::string &prefix) const
+{
+  std::string   filename = prefix + ".xdmfhandler";
+  std::ofstream output(filename.c_str());
+  save(output);
+}
+
+void
+XDMFHandler::save(std::ostream &output) const
+{
+  boost::archive::text_oarchive archive(output);
+  archive << entries;
+}
+
+void
+XDMFHandler::read(const std::string &prefix)
+{
+  std::string   filename = prefix + ".xdmfhandler";
+  std::ifstream input(filename.c_str());
+  if (!input)
+    throw(std::runtime_error("Unable to open the xdmf restart file " +
+                             filename));
+
+  boost::archive::text_iarchive archive(input);
+  archive >> entries;
+
+  // The xdmf file may hold the entries of outputs which followed the
+  // checkpoint and is written again completely at the next output
+  n_written_entries = 0;
+}
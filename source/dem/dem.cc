@@ -48,6 +48,17 @@ DEMSolver<dim>::DEMSolver(DEMSolverParameters<dim> dem_parameters)
 
   simulation_control = std::make_shared<SimulationControlTransientDEM>(
     parameters.simulation_control);
+
+  if (parameters.timer.write_metrics)
+    metrics_log = MetricsLog(parameters.simulation_control.output_folder +
+                               parameters.timer.metrics_output_name + ".jsonl",
+                             this_mpi_process == 0,
+                             false);
+
+  if (parameters.simulation_control.asynchronous_output)
+    output_writer = std::make_unique<AsyncOutputWriter>(
+      std::size_t(parameters.simulation_control.asynchronous_output_buffer) *
+      1024 * 1024);
 }
 
 template <int dim>
@@ -184,10 +195,17 @@ template <int dim>
 void
 DEMSolver<dim>::finish_simulation()
 {
+  // Wait for the results which are still being written
+  if (output_writer)
+    output_writer->flush();
+
   // Timer output
   if (parameters.timer.type == Parameters::Timer::Type::end)
     this->computing_timer.print_summary();
 
+  if (parameters.timer.report_load_balance)
+    report_load_balance();
+
   // Testing
   if (parameters.test.enabled)
     {
@@ -427,14 +445,34 @@ DEMSolver<dim>::write_output_results()
   particle_data_out.build_patches(particle_handler,
                                   properties_class.get_properties_name());
 
-  write_vtu_and_pvd<0, dim>(particles_pvdhandler,
-                            particle_data_out,
-                            folder,
-                            particles_solution_name,
-                            time,
-                            iter,
-                            group_files,
-                            mpi_communicator);
+  if (parameters.simulation_control.output_format ==
+      Parameters::SimulationControl::OutputFormat::hdf5)
+    write_hdf5_and_xdmf<0, dim>(particles_xdmf_handler,
+                                particle_data_out,
+                                folder,
+                                particles_solution_name,
+                                time,
+                                iter,
+                                parameters.simulation_control.hdf5_compression,
+                                mpi_communicator);
+  else if (output_writer)
+    write_vtu_and_pvd<0, dim>(*output_writer,
+                              particles_pvdhandler,
+                              particle_data_out,
+                              folder,
+                              particles_solution_name,
+                              time,
+                              iter,
+                              mpi_communicator);
+  else
+    write_vtu_and_pvd<0, dim>(particles_pvdhandler,
+                              particle_data_out,
+                              folder,
+                              particles_solution_name,
+                              time,
+                              iter,
+                              group_files,
+                              mpi_communicator);
 
   // Write background grid
   DataOut<dim> background_data_out;
@@ -452,14 +490,34 @@ DEMSolver<dim>::write_output_results()
 
   background_data_out.build_patches();
 
-  write_vtu_and_pvd<dim>(grid_pvdhandler,
-                         background_data_out,
-                         folder,
-                         grid_solution_name,
-                         time,
-                         iter,
-                         group_files,
-                         mpi_communicator);
+  if (parameters.simulation_control.output_format ==
+      Parameters::SimulationControl::OutputFormat::hdf5)
+    write_hdf5_and_xdmf<dim>(grid_xdmf_handler,
+                             background_data_out,
+                             folder,
+                             grid_solution_name,
+                             time,
+                             iter,
+                             parameters.simulation_control.hdf5_compression,
+                             mpi_communicator);
+  else if (output_writer)
+    write_vtu_and_pvd<dim>(*output_writer,
+                           grid_pvdhandler,
+                           background_data_out,
+                           folder,
+                           grid_solution_name,
+                           time,
+                           iter,
+                           mpi_communicator);
+  else
+    write_vtu_and_pvd<dim>(grid_pvdhandler,
+                           background_data_out,
+                           folder,
+                           grid_solution_name,
+                           time,
+                           iter,
+                           group_files,
+                           mpi_communicator);
 }
 
 template <int dim>
@@ -588,10 +646,73 @@ DEMSolver<dim>::solve()
           write_output_results();
           computing_timer.leave_subsection();
         }
+
+      if (parameters.timer.write_metrics)
+        write_metrics();
+
+      if (parameters.timer.report_load_balance &&
+          parameters.timer.load_balance_frequency > 0 &&
+          step_number % parameters.timer.load_balance_frequency == 0)
+        report_load_balance();
     }
 
   finish_simulation();
 }
 
+template <int dim>
+void
+DEMSolver<dim>::write_metrics()
+{
+  // The particles and contacts of all the processes are counted by a single
+  // reduction
+  std::vector<unsigned int> local_counts(3, 0);
+  local_counts[0] = particle_handler.n_locally_owned_particles();
+  for (const auto &particle_contacts : adjacent_particles)
+    local_counts[1] += particle_contacts.second.size();
+  for (const auto &particle_contacts : pw_pairs_in_contact)
+    local_counts[2] += particle_contacts.second.size();
+
+  std::vector<unsigned int> counts(local_counts.size());
+  Utilities::MPI::sum(local_counts, mpi_communicator, counts);
+
+  metrics_log.add("step", simulation_control->get_step_number());
+  metrics_log.add("time", simulation_control->get_current_time());
+  metrics_log.add("dt", simulation_control->get_time_step());
+  metrics_log.add("n_particles", counts[0]);
+  metrics_log.add("pp_contacts", counts[1]);
+  metrics_log.add("pw_contacts", counts[2]);
+
+  // The summary of the timer holds the wall time accumulated since the start
+  // of the simulation, the log keeps the part of the time step
+  metrics_log.add_increments(
+    "timer", computing_timer.get_summary_data(TimerOutput::total_wall_time));
+  metrics_log.write();
+}
+
+template <int dim>
+void
+DEMSolver<dim>::report_load_balance()
+{
+  unsigned int n_pp_contacts = 0;
+  for (const auto &particle_contacts : adjacent_particles)
+    n_pp_contacts += particle_contacts.second.size();
+  unsigned int n_pw_contacts = 0;
+  for (const auto &particle_contacts : pw_pairs_in_contact)
+    n_pw_contacts += particle_contacts.second.size();
+
+  std::map<std::string, double> workload;
+  workload.emplace("locally_owned_cells",
+                   triangulation.n_locally_owned_active_cells());
+  workload.emplace("particles", particle_handler.n_locally_owned_particles());
+  workload.emplace("pp_contacts", n_pp_contacts);
+  workload.emplace("pw_contacts", n_pw_contacts);
+
+  print_load_balance_report(
+    computing_timer.get_summary_data(TimerOutput::total_wall_time),
+    workload,
+    mpi_communicator,
+    pcout);
+}
+
 template class DEMSolver<2>;
 template class DEMSolver<3>;
@@ -37,7 +37,19 @@ GDNavierStokesSolver<dim>::GDNavierStokesSolver(
                      std::vector<IndexSet>>(p_nsparam,
                                             degreeVelocity,
                                             degreePressure)
-{}
+  , krylov_recycler(p_nsparam.linear_solver.krylov_recycling_vectors,
+                    p_nsparam.linear_solver.max_krylov_vectors)
+{
+  if (p_nsparam.linear_solver.vector_backend !=
+      Parameters::LinearSolver::VectorBackend::trilinos)
+    throw(std::runtime_error(
+      "The gd solver uses Trilinos block vectors, the dealii vector backend "
+      "is only available with the gls solver"));
+
+  if (p_nsparam.ensemble.n_variants > 0)
+    throw(std::runtime_error(
+      "The ensemble of variants is only available with the gls solver"));
+}
 
 template <int dim>
 GDNavierStokesSolver<dim>::~GDNavierStokesSolver()
@@ -166,12 +178,37 @@ GDNavierStokesSolver<dim>::assembleGD()
   std::vector<Tensor<1, dim>> p3_velocity_values(n_q_points);
   std::vector<Tensor<1, dim>> p4_velocity_values(n_q_points);
 
+  // Pseudo-transient continuation of steady solves. A local pseudo-time term
+  // is added to the jacobian matrix only, so the converged solution is not
+  // affected by it
+  const bool pseudo_transient =
+    scheme == Parameters::SimulationControl::TimeSteppingMethod::steady &&
+    this->nsparam.simulation_control.pseudo_transient;
+  const double pseudo_cfl = this->pseudo_cfl;
+
+  // The Picard linearization drops the derivative of the advection with
+  // respect to the advecting velocity
+  const double advection_derivative = this->picard_linearization ? 0. : 1.;
+
+  // Element size
+  double h = 1.;
+
   for (const auto &cell : this->dof_handler.active_cell_iterators())
     {
       if (cell->is_locally_owned())
         {
           fe_values.reinit(cell);
 
+          if (assemble_matrix && pseudo_transient)
+            {
+              if (dim == 2)
+                h = std::sqrt(4. * cell->measure() / M_PI) /
+                    this->velocity_fem_degree;
+              else if (dim == 3)
+                h = pow(6 * cell->measure() / M_PI, 1. / 3.) /
+                    this->velocity_fem_degree;
+            }
+
           local_matrix = 0;
           local_rhs    = 0;
 
@@ -221,6 +258,14 @@ GDNavierStokesSolver<dim>::assembleGD()
                   phi_p[k]      = fe_values[pressure].value(k, q);
                 }
 
+              // Inverse of the local pseudo-time step, which is based on the
+              // convective and viscous time scales of the cell
+              const double sdtau =
+                pseudo_transient ? (present_velocity_values[q].norm() / h +
+                                    viscosity / (h * h)) /
+                                     pseudo_cfl :
+                                   0.;
+
               for (unsigned int i = 0; i < dofs_per_cell; ++i)
                 {
                   if (assemble_matrix)
@@ -230,7 +275,8 @@ GDNavierStokesSolver<dim>::assembleGD()
                           local_matrix(i, j) +=
                             (viscosity *
                                scalar_product(grad_phi_u[j], grad_phi_u[i]) +
-                             present_velocity_gradients[q] * phi_u[j] *
+                             advection_derivative *
+                               present_velocity_gradients[q] * phi_u[j] *
                                phi_u[i] +
                              grad_phi_u[j] * present_velocity_values[q] *
                                phi_u[i] -
@@ -249,6 +295,10 @@ GDNavierStokesSolver<dim>::assembleGD()
                             local_matrix(i, j) += phi_u[j] * phi_u[i] *
                                                   alpha_bdf[0] *
                                                   fe_values.JxW(q);
+
+                          if (pseudo_transient)
+                            local_matrix(i, j) += phi_u[j] * phi_u[i] * sdtau *
+                                                  fe_values.JxW(q);
                         }
                     }
 
@@ -426,12 +476,26 @@ GDNavierStokesSolver<dim>::setup_dofs()
 {
   TimerOutput::Scope t(this->computing_timer, "setup_dofs");
 
+  // Clear the preconditioners before the matrix they are associated with is
+  // cleared
+  system_ilu_preconditioner.reset();
+  system_amg_preconditioner.reset();
+  velocity_ilu_preconditioner.reset();
+  velocity_amg_preconditioner.reset();
+  pressure_ilu_preconditioner.reset();
+  pressure_amg_preconditioner.reset();
+  direct_solver.reset();
+  direct_linear_problem.reset();
+  krylov_recycler.clear();
+
   system_matrix.clear();
+  monolithic_matrix.clear();
 
   this->dof_handler.distribute_dofs(this->fe);
-  // DoFRenumbering::Cuthill_McKee(this->dof_handler);
-
+  this->renumber_dofs(Parameters::FEM::DofRenumbering::none);
 
+  // The velocity and pressure blocks are always separated. The component wise
+  // renumbering preserves the order established above within each block
   std::vector<unsigned int> block_component(dim + 1, 0);
   block_component[dim] = 1;
   DoFRenumbering::component_wise(this->dof_handler, block_component);
@@ -592,6 +656,10 @@ GDNavierStokesSolver<dim>::setup_dofs()
                            this->locally_relevant_dofs,
                            this->mpi_communicator);
 
+  this->evaluation_point.reinit(this->locally_owned_dofs,
+                                this->locally_relevant_dofs,
+                                this->mpi_communicator);
+
   this->newton_update.reinit(this->locally_owned_dofs, this->mpi_communicator);
   this->system_rhs.reinit(this->locally_owned_dofs, this->mpi_communicator);
   this->local_evaluation_point.reinit(this->locally_owned_dofs,
@@ -624,6 +692,33 @@ GDNavierStokesSolver<dim>::setup_dofs()
   system_matrix.reinit(sparsity_pattern);
   pressure_mass_matrix.reinit(sparsity_pattern.block(1, 1));
 
+  // The direct method factors a monolithic copy of the system matrix. Since
+  // the dofs are numbered block by block, the copy uses the numbering of the
+  // dof handler and has the same entries as the blocks
+  if (this->nsparam.linear_solver.solver ==
+      Parameters::LinearSolver::SolverType::direct)
+    {
+      TrilinosWrappers::SparsityPattern monolithic_sparsity_pattern(
+        this->dof_handler.locally_owned_dofs(),
+        this->dof_handler.locally_owned_dofs(),
+        locally_relevant_dofs_acquisition,
+        this->mpi_communicator);
+      DoFTools::make_sparsity_pattern(this->dof_handler,
+                                      coupling,
+                                      monolithic_sparsity_pattern,
+                                      this->nonzero_constraints,
+                                      true,
+                                      Utilities::MPI::this_mpi_process(
+                                        this->mpi_communicator));
+      monolithic_sparsity_pattern.compress();
+
+      monolithic_matrix.reinit(monolithic_sparsity_pattern);
+      monolithic_lhs.reinit(this->dof_handler.locally_owned_dofs(),
+                            this->mpi_communicator);
+      monolithic_rhs.reinit(this->dof_handler.locally_owned_dofs(),
+                            this->mpi_communicator);
+    }
+
 
   double global_volume = GridTools::volume(*this->triangulation);
 
@@ -702,6 +797,16 @@ void
 GDNavierStokesSolver<dim>::solve_linear_system(const bool initial_step,
                                                const bool renewed_matrix)
 {
+  // The autotune leaves the solution of the fastest configuration
+  if (this->nsparam.linear_solver.autotune && !this->linear_solver_autotuned)
+    {
+      this->autotune_linear_solver(
+        initial_step,
+        {Parameters::LinearSolver::SolverType::gmres,
+         Parameters::LinearSolver::SolverType::amg});
+      return;
+    }
+
   const double absolute_residual = this->nsparam.linear_solver.minimum_residual;
   const double relative_residual =
     this->nsparam.linear_solver.relative_residual;
@@ -718,6 +823,9 @@ GDNavierStokesSolver<dim>::solve_linear_system(const bool initial_step,
                      absolute_residual,
                      relative_residual,
                      renewed_matrix);
+  else if (this->nsparam.linear_solver.solver ==
+           Parameters::LinearSolver::SolverType::direct)
+    solve_system_direct(initial_step, renewed_matrix);
   else
     throw(std::runtime_error("This solver is not allowed"));
 }
@@ -727,6 +835,7 @@ void
 GDNavierStokesSolver<dim>::setup_ILU()
 {
   TimerOutput::Scope t(this->computing_timer, "setup_ILU");
+  ++this->solver_statistics.preconditioner_setups;
 
   //**********************************************
   // Trillinos Wrapper ILU Preconditioner
@@ -735,20 +844,38 @@ GDNavierStokesSolver<dim>::setup_ILU()
   const double ilu_atol = this->nsparam.linear_solver.ilu_precond_atol;
   const double ilu_rtol = this->nsparam.linear_solver.ilu_precond_rtol;
 
-  velocity_ilu_preconditioner =
-    std::make_shared<TrilinosWrappers::PreconditionILU>();
-  pressure_ilu_preconditioner =
-    std::make_shared<TrilinosWrappers::PreconditionILU>();
-
-  TrilinosWrappers::PreconditionILU::AdditionalData preconditionerOptions(
-    ilu_fill, ilu_atol, ilu_rtol, 0);
-  velocity_ilu_preconditioner->initialize(system_matrix.block(0, 0),
-                                          preconditionerOptions);
+  // The pressure factors are built from the pressure mass matrix they
+  // precondition since the pressure block of the system matrix is zero
+  if (this->nsparam.linear_solver.ilu_precision ==
+      Parameters::LinearSolver::Precision::single_precision)
+    {
+      const SinglePrecisionILU::AdditionalData single_ilu_data(
+        this->nsparam.linear_solver.ilu_precond_off_diagonals,
+        ilu_atol,
+        ilu_rtol);
+      auto velocity_ilu = std::make_shared<SinglePrecisionILU>();
+      auto pressure_ilu = std::make_shared<SinglePrecisionILU>();
+      velocity_ilu->initialize(system_matrix.block(0, 0), single_ilu_data);
+      pressure_ilu->initialize(pressure_mass_matrix, single_ilu_data);
+      velocity_ilu_preconditioner = velocity_ilu;
+      pressure_ilu_preconditioner = pressure_ilu;
+    }
+  else
+    {
+      auto velocity_ilu = std::make_shared<TrilinosWrappers::PreconditionILU>();
+      auto pressure_ilu = std::make_shared<TrilinosWrappers::PreconditionILU>();
+
+      TrilinosWrappers::PreconditionILU::AdditionalData preconditionerOptions(
+        ilu_fill, ilu_atol, ilu_rtol, 0);
+      velocity_ilu->initialize(system_matrix.block(0, 0),
+                               preconditionerOptions);
+      pressure_ilu->initialize(pressure_mass_matrix, preconditionerOptions);
+      velocity_ilu_preconditioner = velocity_ilu;
+      pressure_ilu_preconditioner = pressure_ilu;
+    }
 
-  pressure_ilu_preconditioner->initialize(system_matrix.block(1, 1),
-                                          preconditionerOptions);
   system_ilu_preconditioner = std::make_shared<
-    BlockSchurPreconditioner<TrilinosWrappers::PreconditionILU>>(
+    BlockSchurPreconditioner<TrilinosWrappers::PreconditionBase>>(
     gamma,
     this->nsparam.physical_properties.viscosity,
     system_matrix,
@@ -763,6 +890,7 @@ void
 GDNavierStokesSolver<dim>::setup_AMG()
 {
   TimerOutput::Scope t(this->computing_timer, "setup_AMG");
+  ++this->solver_statistics.preconditioner_setups;
 
   //**********************************************
   // Trillinos Wrapper AMG Preconditioner
@@ -846,21 +974,19 @@ GDNavierStokesSolver<dim>::setup_AMG()
                                     output_details,
                                     smoother_type,
                                     coarse_type);
+  // As for the ILU, the pressure preconditioner is built from the pressure
+  // mass matrix it preconditions since the pressure block of the system
+  // matrix is zero
   Teuchos::ParameterList              pressure_parameter_ml;
   std::unique_ptr<Epetra_MultiVector> pressure_distributed_constant_modes;
-  velocity_preconditioner_options.set_parameters(
+  pressure_preconditioner_options.set_parameters(
     pressure_parameter_ml,
     pressure_distributed_constant_modes,
-    system_matrix.block(0, 0));
-  pressure_amg_preconditioner->initialize(system_matrix.block(1, 1),
+    pressure_mass_matrix);
+  pressure_amg_preconditioner->initialize(pressure_mass_matrix,
                                           pressure_parameter_ml);
   this->computing_timer.leave_subsection("AMG_pressure");
 
-
-  TrilinosWrappers::MPI::BlockVector completely_distributed_solution(
-    this->locally_owned_dofs, this->mpi_communicator);
-
-
   system_amg_preconditioner = std::make_shared<
     BlockSchurPreconditioner<TrilinosWrappers::PreconditionAMG>>(
     gamma,
@@ -874,6 +1000,173 @@ GDNavierStokesSolver<dim>::setup_AMG()
 
 
 
+template <int dim>
+void
+GDNavierStokesSolver<dim>::setup_preconditioner()
+{
+  if (this->nsparam.linear_solver.solver ==
+      Parameters::LinearSolver::SolverType::amg)
+    setup_AMG();
+  else if (this->nsparam.linear_solver.solver ==
+           Parameters::LinearSolver::SolverType::direct)
+    setup_direct();
+  else
+    setup_ILU();
+}
+
+template <int dim>
+void
+GDNavierStokesSolver<dim>::apply_preconditioner(
+  TrilinosWrappers::MPI::BlockVector &      dst,
+  const TrilinosWrappers::MPI::BlockVector &src)
+{
+  if (this->nsparam.linear_solver.solver ==
+      Parameters::LinearSolver::SolverType::amg)
+    system_amg_preconditioner->vmult(dst, src);
+  else if (this->nsparam.linear_solver.solver ==
+           Parameters::LinearSolver::SolverType::direct)
+    solve_direct(dst, src);
+  else
+    system_ilu_preconditioner->vmult(dst, src);
+}
+
+template <int dim>
+bool
+GDNavierStokesSolver<dim>::is_preconditioner_available() const
+{
+  if (this->nsparam.linear_solver.solver ==
+      Parameters::LinearSolver::SolverType::amg)
+    return system_amg_preconditioner != nullptr;
+  else if (this->nsparam.linear_solver.solver ==
+           Parameters::LinearSolver::SolverType::direct)
+    return direct_solver != nullptr;
+  else
+    return system_ilu_preconditioner != nullptr;
+}
+
+template <int dim>
+void
+GDNavierStokesSolver<dim>::setup_direct()
+{
+  TimerOutput::Scope t(this->computing_timer, "setup_direct");
+  ++this->solver_statistics.preconditioner_setups;
+
+  // The rows and columns of the pressure block are shifted by the number of
+  // velocity dofs in the monolithic matrix
+  const types::global_dof_index block_offset[2] = {0, dofs_per_block[0]};
+
+  std::vector<types::global_dof_index> columns;
+  std::vector<double>                  values;
+
+  monolithic_matrix = 0;
+  for (unsigned int block_row = 0; block_row < 2; ++block_row)
+    for (const types::global_dof_index row :
+         this->locally_owned_dofs[block_row])
+      for (unsigned int block_column = 0; block_column < 2; ++block_column)
+        {
+          // The pressure block of the system matrix is zero, including the
+          // diagonal entries of the pressure dofs constrained by hanging
+          // nodes. These are taken from the pressure mass matrix so that the
+          // rows of the constrained dofs are not empty
+          const bool pressure_block = block_row == 1 && block_column == 1;
+          if (pressure_block &&
+              !this->zero_constraints.is_constrained(block_offset[1] + row))
+            continue;
+
+          const TrilinosWrappers::SparseMatrix &block =
+            pressure_block ? pressure_mass_matrix :
+                             system_matrix.block(block_row, block_column);
+
+          columns.clear();
+          values.clear();
+          for (auto entry = block.begin(row); entry != block.end(row); ++entry)
+            {
+              columns.push_back(block_offset[block_column] + entry->column());
+              values.push_back(entry->value());
+            }
+          monolithic_matrix.set(block_offset[block_row] + row, columns, values);
+        }
+  monolithic_matrix.compress(VectorOperation::insert);
+
+  // The Epetra matrix of the monolithic matrix is only replaced when the dofs
+  // are set-up again, which also resets the direct solver
+  if (!direct_solver)
+    {
+      direct_linear_problem = std::make_unique<Epetra_LinearProblem>();
+      direct_linear_problem->SetOperator(
+        const_cast<Epetra_CrsMatrix *>(&monolithic_matrix.trilinos_matrix()));
+
+      Amesos factory;
+      direct_solver.reset(
+        factory.Create(this->nsparam.linear_solver.direct_solver_type,
+                       *direct_linear_problem));
+      AssertThrow(direct_solver != nullptr,
+                  ExcMessage("The direct solver " +
+                             this->nsparam.linear_solver.direct_solver_type +
+                             " is not available in Amesos"));
+
+      const int ierr = direct_solver->SymbolicFactorization();
+      AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+    }
+
+  const int ierr = direct_solver->NumericFactorization();
+  AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+}
+
+template <int dim>
+void
+GDNavierStokesSolver<dim>::solve_direct(
+  TrilinosWrappers::MPI::BlockVector &      dst,
+  const TrilinosWrappers::MPI::BlockVector &src)
+{
+  const types::global_dof_index block_offset[2] = {0, dofs_per_block[0]};
+
+  for (unsigned int b = 0; b < 2; ++b)
+    for (const types::global_dof_index i : this->locally_owned_dofs[b])
+      monolithic_rhs[block_offset[b] + i] = src.block(b)[i];
+  monolithic_rhs.compress(VectorOperation::insert);
+
+  direct_linear_problem->SetLHS(&monolithic_lhs.trilinos_vector());
+  direct_linear_problem->SetRHS(&monolithic_rhs.trilinos_vector());
+  const int ierr = direct_solver->Solve();
+  AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+
+  for (unsigned int b = 0; b < 2; ++b)
+    for (const types::global_dof_index i : this->locally_owned_dofs[b])
+      dst.block(b)[i] = monolithic_lhs[block_offset[b] + i];
+  dst.compress(VectorOperation::insert);
+}
+
+template <int dim>
+void
+GDNavierStokesSolver<dim>::solve_system_direct(const bool initial_step,
+                                               const bool renewed_matrix)
+{
+  const AffineConstraints<double> &constraints_used =
+    initial_step ? this->nonzero_constraints : this->zero_constraints;
+
+  if (renewed_matrix || !direct_solver)
+    setup_direct();
+  else
+    ++this->solver_statistics.preconditioner_reuses;
+
+  {
+    TimerOutput::Scope t(this->computing_timer, "solve_linear_system");
+
+    this->newton_update = 0;
+    solve_direct(this->newton_update, this->system_rhs);
+
+    if (this->nsparam.linear_solver.verbosity != Parameters::Verbosity::quiet)
+      {
+        this->pcout << "  -Direct solver "
+                    << (renewed_matrix ? "refactorized the matrix" :
+                                         "reused the factorization")
+                    << std::endl;
+      }
+  }
+  constraints_used.distribute(this->newton_update);
+}
+
 template <int dim>
 void
 GDNavierStokesSolver<dim>::solve_system_GMRES(const bool   initial_step,
@@ -894,31 +1187,51 @@ GDNavierStokesSolver<dim>::solve_system_GMRES(const bool   initial_step,
                   << linear_solver_tolerance << std::endl;
     }
 
-
-  TrilinosWrappers::MPI::BlockVector completely_distributed_solution(
-    this->locally_owned_dofs, this->mpi_communicator);
-
   SolverControl solver_control(this->nsparam.linear_solver.max_iterations,
                                linear_solver_tolerance,
                                true,
                                true);
 
-  SolverFGMRES<TrilinosWrappers::MPI::BlockVector> solver(solver_control);
+  SolverFGMRES<TrilinosWrappers::MPI::BlockVector> solver(
+    solver_control,
+    SolverFGMRES<TrilinosWrappers::MPI::BlockVector>::AdditionalData(
+      this->nsparam.linear_solver.max_krylov_vectors));
 
   if (renewed_matrix || velocity_ilu_preconditioner == 0 ||
       pressure_ilu_preconditioner == 0 || system_ilu_preconditioner == 0)
     setup_ILU();
+  else
+    ++this->solver_statistics.preconditioner_reuses;
 
   {
     TimerOutput::Scope t(this->computing_timer, "solve_linear_system");
-    solver.solve(system_matrix,
-                 this->newton_update,
-                 this->system_rhs,
-                 *system_ilu_preconditioner);
+    if (this->nsparam.linear_solver.krylov_recycling_vectors > 0)
+      krylov_recycler.solve(system_matrix,
+                            this->newton_update,
+                            this->system_rhs,
+                            *system_ilu_preconditioner,
+                            solver_control,
+                            renewed_matrix);
+    else
+      solver.solve(system_matrix,
+                   this->newton_update,
+                   this->system_rhs,
+                   *system_ilu_preconditioner);
+    this->solver_statistics.linear_iterations.push_back(
+      solver_control.last_step());
     if (this->nsparam.linear_solver.verbosity != Parameters::Verbosity::quiet)
       {
         this->pcout << "  -Iterative solver took : "
                     << solver_control.last_step() << " steps " << std::endl;
+        if (this->nsparam.linear_solver.krylov_recycling_vectors > 0)
+          this->pcout << "  -Recycled subspace dimension : "
+                      << krylov_recycler.get_n_recycled_vectors()
+                      << "  - Initial residual reduction : "
+                      << krylov_recycler.get_deflation_ratio()
+                      << "  - Saved iterations : "
+                      << krylov_recycler.get_saved_iterations() << " (total "
+                      << krylov_recycler.get_total_saved_iterations() << ")"
+                      << std::endl;
       }
 
     constraints_used.distribute(this->newton_update);
@@ -950,6 +1263,8 @@ GDNavierStokesSolver<dim>::solve_system_AMG(const bool   initial_step,
   if (renewed_matrix || velocity_amg_preconditioner == 0 ||
       pressure_amg_preconditioner == 0 || system_amg_preconditioner == 0)
     setup_AMG();
+  else
+    ++this->solver_statistics.preconditioner_reuses;
 
 
   SolverControl solver_control(this->nsparam.linear_solver.max_iterations,
@@ -957,19 +1272,41 @@ GDNavierStokesSolver<dim>::solve_system_AMG(const bool   initial_step,
                                true,
                                true);
 
-  SolverFGMRES<TrilinosWrappers::MPI::BlockVector> solver(solver_control);
+  SolverFGMRES<TrilinosWrappers::MPI::BlockVector> solver(
+    solver_control,
+    SolverFGMRES<TrilinosWrappers::MPI::BlockVector>::AdditionalData(
+      this->nsparam.linear_solver.max_krylov_vectors));
 
   {
     TimerOutput::Scope t(this->computing_timer, "solve_linear_system");
 
-    solver.solve(system_matrix,
-                 this->newton_update,
-                 this->system_rhs,
-                 *system_amg_preconditioner);
+    if (this->nsparam.linear_solver.krylov_recycling_vectors > 0)
+      krylov_recycler.solve(system_matrix,
+                            this->newton_update,
+                            this->system_rhs,
+                            *system_amg_preconditioner,
+                            solver_control,
+                            renewed_matrix);
+    else
+      solver.solve(system_matrix,
+                   this->newton_update,
+                   this->system_rhs,
+                   *system_amg_preconditioner);
+    this->solver_statistics.linear_iterations.push_back(
+      solver_control.last_step());
     if (this->nsparam.linear_solver.verbosity != Parameters::Verbosity::quiet)
       {
         this->pcout << "  -Iterative solver took : "
                     << solver_control.last_step() << " steps " << std::endl;
+        if (this->nsparam.linear_solver.krylov_recycling_vectors > 0)
+          this->pcout << "  -Recycled subspace dimension : "
+                      << krylov_recycler.get_n_recycled_vectors()
+                      << "  - Initial residual reduction : "
+                      << krylov_recycler.get_deflation_ratio()
+                      << "  - Saved iterations : "
+                      << krylov_recycler.get_saved_iterations() << " (total "
+                      << krylov_recycler.get_total_saved_iterations() << ")"
+                      << std::endl;
       }
 
     constraints_used.distribute(this->newton_update);
@@ -1002,8 +1339,12 @@ GDNavierStokesSolver<dim>::solve_L2_system(const bool initial_step,
                                linear_solver_tolerance,
                                true,
                                true);
-  SolverFGMRES<TrilinosWrappers::MPI::BlockVector> solver(solver_control);
-  TrilinosWrappers::PreconditionILU                pmass_preconditioner;
+  SolverFGMRES<TrilinosWrappers::MPI::BlockVector> solver(
+    solver_control,
+    SolverFGMRES<TrilinosWrappers::MPI::BlockVector>::AdditionalData(
+      this->nsparam.linear_solver.max_krylov_vectors));
+
+  TrilinosWrappers::PreconditionILU pmass_preconditioner;
 
   //**********************************************
   // Trillinos Wrapper ILU Preconditioner
@@ -1025,6 +1366,8 @@ GDNavierStokesSolver<dim>::solve_L2_system(const bool initial_step,
                completely_distributed_solution,
                this->system_rhs,
                preconditioner);
+  this->solver_statistics.linear_iterations.push_back(
+    solver_control.last_step());
 
   if (this->nsparam.linear_solver.verbosity != Parameters::Verbosity::quiet)
     {
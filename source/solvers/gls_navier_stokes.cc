@@ -26,35 +26,40 @@
 #include "core/time_integration_utilities.h"
 
 // Constructor for class GLSNavierStokesSolver
-template <int dim>
-GLSNavierStokesSolver<dim>::GLSNavierStokesSolver(
+template <int dim, typename VectorType>
+GLSNavierStokesSolver<dim, VectorType>::GLSNavierStokesSolver(
   NavierStokesSolverParameters<dim> &p_nsparam,
   const unsigned int                 p_degreeVelocity,
   const unsigned int                 p_degreePressure)
-  : NavierStokesBase<dim, TrilinosWrappers::MPI::Vector, IndexSet>(
-      p_nsparam,
-      p_degreeVelocity,
-      p_degreePressure)
+  : NavierStokesBase<dim, VectorType, IndexSet>(p_nsparam,
+                                                p_degreeVelocity,
+                                                p_degreePressure)
+  , krylov_recycler(p_nsparam.linear_solver.krylov_recycling_vectors,
+                    p_nsparam.linear_solver.max_krylov_vectors)
 {}
 
-template <int dim>
-GLSNavierStokesSolver<dim>::~GLSNavierStokesSolver()
+template <int dim, typename VectorType>
+GLSNavierStokesSolver<dim, VectorType>::~GLSNavierStokesSolver()
 {
   this->dof_handler.clear();
 }
 
 
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::set_solution_vector(double value)
+GLSNavierStokesSolver<dim, VectorType>::set_solution_vector(double value)
 {
+  // The assignment of a scalar to a deal.II vector only sets its locally
+  // owned values, whereas the assignment of a vector without ghost values
+  // also imports its ghost values
   this->present_solution = value;
+  this->present_solution.update_ghost_values();
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::setup_dofs()
+GLSNavierStokesSolver<dim, VectorType>::setup_dofs()
 {
   TimerOutput::Scope t(this->computing_timer, "setup_dofs");
 
@@ -62,12 +67,15 @@ GLSNavierStokesSolver<dim>::setup_dofs()
   // cleared
   amg_preconditioner.reset();
   ilu_preconditioner.reset();
+  direct_solver.reset();
+  direct_linear_problem.reset();
+  krylov_recycler.clear();
 
   // Now reset system matrix
   system_matrix.clear();
 
   this->dof_handler.distribute_dofs(this->fe);
-  DoFRenumbering::Cuthill_McKee(this->dof_handler);
+  this->renumber_dofs(Parameters::FEM::DofRenumbering::cuthill_mckee);
 
   this->locally_owned_dofs = this->dof_handler.locally_owned_dofs();
   DoFTools::extract_locally_relevant_dofs(this->dof_handler,
@@ -196,11 +204,40 @@ GLSNavierStokesSolver<dim>::setup_dofs()
                            this->locally_relevant_dofs,
                            this->mpi_communicator);
 
+  this->evaluation_point.reinit(this->locally_owned_dofs,
+                                this->locally_relevant_dofs,
+                                this->mpi_communicator);
+
   this->newton_update.reinit(this->locally_owned_dofs, this->mpi_communicator);
-  this->system_rhs.reinit(this->locally_owned_dofs, this->mpi_communicator);
+
+  // The deal.II vectors can only receive contributions to the degrees of
+  // freedom of other processes in their ghost entries, which are sent to their
+  // owner by the compress of the assembly
+  if constexpr (std::is_same<VectorType, TrilinosWrappers::MPI::Vector>::value)
+    this->system_rhs.reinit(this->locally_owned_dofs, this->mpi_communicator);
+  else
+    this->system_rhs.reinit(this->locally_owned_dofs,
+                            this->locally_relevant_dofs,
+                            this->mpi_communicator);
   this->local_evaluation_point.reinit(this->locally_owned_dofs,
                                       this->mpi_communicator);
 
+  setup_system_matrix();
+
+  double global_volume = GridTools::volume(*this->triangulation);
+
+  this->pcout << "   Number of active cells:       "
+              << this->triangulation->n_global_active_cells() << std::endl
+              << "   Number of degrees of freedom: "
+              << this->dof_handler.n_dofs() << std::endl;
+  this->pcout << "   Volume of triangulation:      " << global_volume
+              << std::endl;
+}
+
+template <int dim, typename VectorType>
+void
+GLSNavierStokesSolver<dim, VectorType>::setup_system_matrix()
+{
   DynamicSparsityPattern dsp(this->locally_relevant_dofs);
   DoFTools::make_sparsity_pattern(this->dof_handler,
                                   dsp,
@@ -215,27 +252,23 @@ GLSNavierStokesSolver<dim>::setup_dofs()
                        this->locally_owned_dofs,
                        dsp,
                        this->mpi_communicator);
-
-
-  double global_volume = GridTools::volume(*this->triangulation);
-
-  this->pcout << "   Number of active cells:       "
-              << this->triangulation->n_global_active_cells() << std::endl
-              << "   Number of degrees of freedom: "
-              << this->dof_handler.n_dofs() << std::endl;
-  this->pcout << "   Volume of triangulation:      " << global_volume
-              << std::endl;
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 template <bool                                              assemble_matrix,
           Parameters::SimulationControl::TimeSteppingMethod scheme,
           Parameters::VelocitySource::VelocitySourceType    velocity_source>
 void
-GLSNavierStokesSolver<dim>::assembleGLS()
+GLSNavierStokesSolver<dim, VectorType>::assembleGLS()
 {
   if (assemble_matrix)
-    system_matrix = 0;
+    {
+      // The matrix is released by the jacobian-free non-linear solvers once
+      // their preconditioner is built
+      if (system_matrix.m() == 0)
+        setup_system_matrix();
+      system_matrix = 0;
+    }
   this->system_rhs = 0;
 
   double         viscosity = this->nsparam.physical_properties.viscosity;
@@ -328,6 +361,18 @@ GLSNavierStokesSolver<dim>::assembleGLS()
   if (is_sdirk3(scheme))
     sdirk_coefs = sdirk_coefficients(3, dt);
 
+  // Pseudo-transient continuation of steady solves. A local pseudo-time term
+  // is added to the jacobian matrix only, so the converged solution is not
+  // affected by it
+  const bool pseudo_transient =
+    scheme == Parameters::SimulationControl::TimeSteppingMethod::steady &&
+    this->nsparam.simulation_control.pseudo_transient;
+  const double pseudo_cfl = this->pseudo_cfl;
+
+  // The Picard linearization drops the derivative of the advection, and of
+  // the SUPG test function, with respect to the advecting velocity
+  const double advection_derivative = this->picard_linearization ? 0. : 1.;
+
   // Element size
   double h;
 
@@ -518,12 +563,20 @@ GLSNavierStokesSolver<dim>::assembleGLS()
               // Matrix assembly
               if (assemble_matrix)
                 {
+                  // Inverse of the local pseudo-time step, which is based on
+                  // the convective and viscous time scales of the cell
+                  const double sdtau =
+                    pseudo_transient ?
+                      (u_mag / h + viscosity / (h * h)) / pseudo_cfl :
+                      0.;
+
                   // We loop over the column first to prevent recalculation of
                   // the strong jacobian in the inner loop
                   for (unsigned int j = 0; j < dofs_per_cell; ++j)
                     {
                       auto strong_jac =
-                        (present_velocity_gradients[q] * phi_u[j] +
+                        (advection_derivative * present_velocity_gradients[q] *
+                           phi_u[j] +
                          grad_phi_u[j] * present_velocity_values[q] +
                          grad_phi_p[j] - viscosity * laplacian_phi_u[j]);
 
@@ -531,6 +584,8 @@ GLSNavierStokesSolver<dim>::assembleGLS()
                         strong_jac += phi_u[j] * bdf_coefs[0];
                       if (is_sdirk(scheme))
                         strong_jac += phi_u[j] * sdirk_coefs[0][0];
+                      if (pseudo_transient)
+                        strong_jac += phi_u[j] * sdtau;
 
                       if (velocity_source ==
                           Parameters::VelocitySource::VelocitySourceType::srf)
@@ -550,7 +605,8 @@ GLSNavierStokesSolver<dim>::assembleGLS()
                               // Momentum terms
                               viscosity *
                                 scalar_product(grad_phi_u[j], grad_phi_u[i]) +
-                              present_velocity_gradients[q] * phi_u[j] *
+                              advection_derivative *
+                                present_velocity_gradients[q] * phi_u[j] *
                                 phi_u[i] +
                               grad_phi_u[j] * present_velocity_values[q] *
                                 phi_u[i] -
@@ -568,6 +624,10 @@ GLSNavierStokesSolver<dim>::assembleGLS()
                             local_matrix(i, j) +=
                               phi_u[j] * phi_u[i] * sdirk_coefs[0][0] * JxW;
 
+                          if (pseudo_transient)
+                            local_matrix(i, j) +=
+                              phi_u[j] * phi_u[i] * sdtau * JxW;
+
                           // PSPG GLS term
                           local_matrix(i, j) +=
                             tau * strong_jac * grad_phi_p[i] * JxW;
@@ -602,7 +662,8 @@ GLSNavierStokesSolver<dim>::assembleGLS()
                                 tau *
                                 (strong_jac * (grad_phi_u[i] *
                                                present_velocity_values[q]) +
-                                 strong_residual * (grad_phi_u[i] * phi_u[j])) *
+                                 advection_derivative * strong_residual *
+                                   (grad_phi_u[i] * phi_u[j])) *
                                 JxW;
 
                               // SUPG TAU term is currently disabled because it
@@ -779,9 +840,9 @@ GLSNavierStokesSolver<dim>::assembleGLS()
 /**
  * Set the initial condition using a L2 or a viscous solver
  **/
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::set_initial_condition(
+GLSNavierStokesSolver<dim, VectorType>::set_initial_condition(
   Parameters::InitialConditionType initial_condition_type,
   bool                             restart)
 {
@@ -814,7 +875,7 @@ GLSNavierStokesSolver<dim>::set_initial_condition(
       double viscosity = this->nsparam.physical_properties.viscosity;
       this->nsparam.physical_properties.viscosity =
         this->nsparam.initial_condition->viscosity;
-      PhysicsSolver<TrilinosWrappers::MPI::Vector>::solve_non_linear_system(
+      PhysicsSolver<VectorType>::solve_non_linear_system(
         Parameters::SimulationControl::TimeSteppingMethod::steady, false, true);
       this->finish_time_step();
       this->postprocess(true);
@@ -826,10 +887,12 @@ GLSNavierStokesSolver<dim>::set_initial_condition(
     }
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::assemble_L2_projection()
+GLSNavierStokesSolver<dim, VectorType>::assemble_L2_projection()
 {
+  if (system_matrix.m() == 0)
+    setup_system_matrix();
   system_matrix    = 0;
   this->system_rhs = 0;
   QGauss<dim>         quadrature_formula(this->number_quadrature_points);
@@ -913,9 +976,9 @@ GLSNavierStokesSolver<dim>::assemble_L2_projection()
   this->system_rhs.compress(VectorOperation::add);
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::assemble_matrix_and_rhs(
+GLSNavierStokesSolver<dim, VectorType>::assemble_matrix_and_rhs(
   const Parameters::SimulationControl::TimeSteppingMethod time_stepping_method)
 {
   TimerOutput::Scope t(this->computing_timer, "assemble_system");
@@ -1020,9 +1083,9 @@ GLSNavierStokesSolver<dim>::assemble_matrix_and_rhs(
                     Parameters::VelocitySource::VelocitySourceType::srf>();
     }
 }
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::assemble_rhs(
+GLSNavierStokesSolver<dim, VectorType>::assemble_rhs(
   const Parameters::SimulationControl::TimeSteppingMethod time_stepping_method)
 {
   TimerOutput::Scope t(this->computing_timer, "assemble_rhs");
@@ -1127,11 +1190,23 @@ GLSNavierStokesSolver<dim>::assemble_rhs(
     }
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::solve_linear_system(const bool initial_step,
-                                                const bool renewed_matrix)
+GLSNavierStokesSolver<dim, VectorType>::solve_linear_system(
+  const bool initial_step,
+  const bool renewed_matrix)
 {
+  // The autotune leaves the solution of the fastest configuration
+  if (this->nsparam.linear_solver.autotune && !this->linear_solver_autotuned)
+    {
+      this->autotune_linear_solver(
+        initial_step,
+        {Parameters::LinearSolver::SolverType::gmres,
+         Parameters::LinearSolver::SolverType::bicgstab,
+         Parameters::LinearSolver::SolverType::amg});
+      return;
+    }
+
   const double absolute_residual = this->nsparam.linear_solver.minimum_residual;
   const double relative_residual =
     this->nsparam.linear_solver.relative_residual;
@@ -1154,32 +1229,56 @@ GLSNavierStokesSolver<dim>::solve_linear_system(const bool initial_step,
                      absolute_residual,
                      relative_residual,
                      renewed_matrix);
+  else if (this->nsparam.linear_solver.solver ==
+           Parameters::LinearSolver::SolverType::direct)
+    solve_system_direct(initial_step, renewed_matrix);
   else
     throw(std::runtime_error("This solver is not allowed"));
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::setup_ILU()
+GLSNavierStokesSolver<dim, VectorType>::setup_ILU()
 {
   TimerOutput::Scope t(this->computing_timer, "setup_ILU");
+  ++this->solver_statistics.preconditioner_setups;
 
   const double ilu_fill = this->nsparam.linear_solver.ilu_precond_fill;
   const double ilu_atol = this->nsparam.linear_solver.ilu_precond_atol;
   const double ilu_rtol = this->nsparam.linear_solver.ilu_precond_rtol;
+
+  // The jacobian-free non-linear solver releases the matrix once the
+  // preconditioner is built, which requires the factors to be owned by the
+  // preconditioner
+  if (this->nsparam.linear_solver.ilu_precision ==
+        Parameters::LinearSolver::Precision::single_precision ||
+      this->nsparam.non_linear_solver.solver ==
+        Parameters::NonLinearSolver::SolverType::jfnk)
+    {
+      const SinglePrecisionILU::AdditionalData single_ilu_data(
+        this->nsparam.linear_solver.ilu_precond_off_diagonals,
+        ilu_atol,
+        ilu_rtol);
+      auto single_ilu = std::make_shared<SinglePrecisionILU>();
+      single_ilu->initialize(system_matrix, single_ilu_data);
+      ilu_preconditioner = single_ilu;
+      return;
+    }
+
   TrilinosWrappers::PreconditionILU::AdditionalData preconditionerOptions(
     ilu_fill, ilu_atol, ilu_rtol, 0);
 
-  ilu_preconditioner = std::make_shared<TrilinosWrappers::PreconditionILU>();
-
-  ilu_preconditioner->initialize(system_matrix, preconditionerOptions);
+  auto double_ilu = std::make_shared<TrilinosWrappers::PreconditionILU>();
+  double_ilu->initialize(system_matrix, preconditionerOptions);
+  ilu_preconditioner = double_ilu;
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::setup_AMG()
+GLSNavierStokesSolver<dim, VectorType>::setup_AMG()
 {
   TimerOutput::Scope t(this->computing_timer, "setup_AMG");
+  ++this->solver_statistics.preconditioner_setups;
 
   std::vector<std::vector<bool>> constant_modes;
   // Constant modes include pressure since everything is in the same matrix
@@ -1239,12 +1338,127 @@ GLSNavierStokesSolver<dim>::setup_AMG()
   amg_preconditioner->initialize(system_matrix, parameter_ml);
 }
 
-template <int dim>
+template <int dim, typename VectorType>
+void
+GLSNavierStokesSolver<dim, VectorType>::setup_direct()
+{
+  TimerOutput::Scope t(this->computing_timer, "setup_direct");
+  ++this->solver_statistics.preconditioner_setups;
+
+  // The Epetra matrix of the system matrix is only replaced when the dofs are
+  // set-up again, which also resets the direct solver. Its sparsity pattern
+  // is thus unchanged as long as the solver exists.
+  if (!direct_solver)
+    {
+      direct_linear_problem = std::make_unique<Epetra_LinearProblem>();
+      direct_linear_problem->SetOperator(
+        const_cast<Epetra_CrsMatrix *>(&system_matrix.trilinos_matrix()));
+
+      Amesos factory;
+      direct_solver.reset(
+        factory.Create(this->nsparam.linear_solver.direct_solver_type,
+                       *direct_linear_problem));
+      AssertThrow(direct_solver != nullptr,
+                  ExcMessage("The direct solver " +
+                             this->nsparam.linear_solver.direct_solver_type +
+                             " is not available in Amesos"));
+
+      const int ierr = direct_solver->SymbolicFactorization();
+      AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+    }
+
+  const int ierr = direct_solver->NumericFactorization();
+  AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+}
+
+template <int dim, typename VectorType>
+void
+GLSNavierStokesSolver<dim, VectorType>::solve_direct(VectorType &      dst,
+                                                     const VectorType &src)
+{
+  const Epetra_CrsMatrix &matrix = system_matrix.trilinos_matrix();
+
+  Epetra_Vector lhs(View, matrix.DomainMap(), dst.begin());
+  Epetra_Vector rhs(View,
+                    matrix.RangeMap(),
+                    const_cast<double *>(src.begin()));
+
+  direct_linear_problem->SetLHS(&lhs);
+  direct_linear_problem->SetRHS(&rhs);
+  const int ierr = direct_solver->Solve();
+  AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+}
+
+template <int dim, typename VectorType>
+void
+GLSNavierStokesSolver<dim, VectorType>::setup_preconditioner()
+{
+  if (this->nsparam.linear_solver.solver ==
+      Parameters::LinearSolver::SolverType::amg)
+    setup_AMG();
+  else if (this->nsparam.linear_solver.solver ==
+           Parameters::LinearSolver::SolverType::direct)
+    setup_direct();
+  else
+    setup_ILU();
+}
+
+template <int dim, typename VectorType>
+void
+GLSNavierStokesSolver<dim, VectorType>::apply_preconditioner(
+  VectorType &      dst,
+  const VectorType &src)
+{
+  if (this->nsparam.linear_solver.solver ==
+      Parameters::LinearSolver::SolverType::amg)
+    amg_preconditioner->vmult(dst, src);
+  else if (this->nsparam.linear_solver.solver ==
+           Parameters::LinearSolver::SolverType::direct)
+    {
+      // The factorization of the last assembled matrix is an exact inverse
+      // of the lagged jacobian matrix
+      solve_direct(dst, src);
+    }
+  else
+    ilu_preconditioner->vmult(dst, src);
+}
+
+template <int dim, typename VectorType>
+bool
+GLSNavierStokesSolver<dim, VectorType>::is_preconditioner_available() const
+{
+  if (this->nsparam.linear_solver.solver ==
+      Parameters::LinearSolver::SolverType::amg)
+    return amg_preconditioner != nullptr;
+  else if (this->nsparam.linear_solver.solver ==
+           Parameters::LinearSolver::SolverType::direct)
+    return direct_solver != nullptr;
+  else
+    return ilu_preconditioner != nullptr;
+}
+
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::solve_system_GMRES(const bool   initial_step,
-                                               const double absolute_residual,
-                                               const double relative_residual,
-                                               const bool   renewed_matrix)
+GLSNavierStokesSolver<dim, VectorType>::release_system_matrix()
+{
+  // The AMG preconditioner and the direct solver refer to the matrix they are
+  // built from
+  if (this->nsparam.linear_solver.solver ==
+        Parameters::LinearSolver::SolverType::amg ||
+      this->nsparam.linear_solver.solver ==
+        Parameters::LinearSolver::SolverType::direct)
+    return;
+
+  system_matrix.clear();
+}
+
+template <int dim, typename VectorType>
+void
+GLSNavierStokesSolver<dim, VectorType>::solve_system_GMRES(
+  const bool   initial_step,
+  const double absolute_residual,
+  const double relative_residual,
+  const bool   renewed_matrix)
 {
   const AffineConstraints<double> &constraints_used =
     initial_step ? this->nonzero_constraints : this->zero_constraints;
@@ -1258,39 +1472,62 @@ GLSNavierStokesSolver<dim>::solve_system_GMRES(const bool   initial_step,
                        this->nsparam.linear_solver.residual_precision)
                   << linear_solver_tolerance << std::endl;
     }
-  TrilinosWrappers::MPI::Vector completely_distributed_solution(
-    this->locally_owned_dofs, this->mpi_communicator);
+  // The update is solved for directly in the newton_update vector sized in
+  // setup_dofs, starting from a zero initial guess
+  this->newton_update = 0;
 
   SolverControl solver_control(this->nsparam.linear_solver.max_iterations,
                                linear_solver_tolerance,
                                true,
                                true);
-  TrilinosWrappers::SolverGMRES solver(solver_control);
+  TrilinosWrappers::SolverGMRES::AdditionalData solver_data(
+    false, this->nsparam.linear_solver.max_krylov_vectors);
+  TrilinosWrappers::SolverGMRES solver(solver_control, solver_data);
 
   if (renewed_matrix || !ilu_preconditioner)
     setup_ILU();
+  else
+    ++this->solver_statistics.preconditioner_reuses;
 
   {
     TimerOutput::Scope t(this->computing_timer, "solve_linear_system");
 
-    solver.solve(system_matrix,
-                 completely_distributed_solution,
-                 this->system_rhs,
-                 *ilu_preconditioner);
+    if (this->nsparam.linear_solver.krylov_recycling_vectors > 0)
+      krylov_recycler.solve(system_matrix,
+                            this->newton_update,
+                            this->system_rhs,
+                            *ilu_preconditioner,
+                            solver_control,
+                            renewed_matrix);
+    else
+      solver.solve(system_matrix,
+                   this->newton_update,
+                   this->system_rhs,
+                   *ilu_preconditioner);
+    this->solver_statistics.linear_iterations.push_back(
+      solver_control.last_step());
 
     if (this->nsparam.linear_solver.verbosity != Parameters::Verbosity::quiet)
       {
         this->pcout << "  -Iterative solver took : "
                     << solver_control.last_step() << " steps " << std::endl;
+        if (this->nsparam.linear_solver.krylov_recycling_vectors > 0)
+          this->pcout << "  -Recycled subspace dimension : "
+                      << krylov_recycler.get_n_recycled_vectors()
+                      << "  - Initial residual reduction : "
+                      << krylov_recycler.get_deflation_ratio()
+                      << "  - Saved iterations : "
+                      << krylov_recycler.get_saved_iterations() << " (total "
+                      << krylov_recycler.get_total_saved_iterations() << ")"
+                      << std::endl;
       }
   }
-  constraints_used.distribute(completely_distributed_solution);
-  this->newton_update = completely_distributed_solution;
+  constraints_used.distribute(this->newton_update);
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::solve_system_BiCGStab(
+GLSNavierStokesSolver<dim, VectorType>::solve_system_BiCGStab(
   const bool   initial_step,
   const double absolute_residual,
   const double relative_residual,
@@ -1309,8 +1546,7 @@ GLSNavierStokesSolver<dim>::solve_system_BiCGStab(
                        this->nsparam.linear_solver.residual_precision)
                   << linear_solver_tolerance << std::endl;
     }
-  TrilinosWrappers::MPI::Vector completely_distributed_solution(
-    this->locally_owned_dofs, this->mpi_communicator);
+  this->newton_update = 0;
 
   SolverControl solver_control(this->nsparam.linear_solver.max_iterations,
                                linear_solver_tolerance,
@@ -1320,31 +1556,35 @@ GLSNavierStokesSolver<dim>::solve_system_BiCGStab(
 
   if (renewed_matrix || !ilu_preconditioner)
     setup_ILU();
+  else
+    ++this->solver_statistics.preconditioner_reuses;
 
   {
     TimerOutput::Scope t(this->computing_timer, "solve_linear_system");
 
     solver.solve(system_matrix,
-                 completely_distributed_solution,
+                 this->newton_update,
                  this->system_rhs,
                  *ilu_preconditioner);
+    this->solver_statistics.linear_iterations.push_back(
+      solver_control.last_step());
 
     if (this->nsparam.linear_solver.verbosity != Parameters::Verbosity::quiet)
       {
         this->pcout << "  -Iterative solver took : "
                     << solver_control.last_step() << " steps " << std::endl;
       }
-    constraints_used.distribute(completely_distributed_solution);
-    this->newton_update = completely_distributed_solution;
+    constraints_used.distribute(this->newton_update);
   }
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::solve_system_AMG(const bool   initial_step,
-                                             const double absolute_residual,
-                                             const double relative_residual,
-                                             const bool   renewed_matrix)
+GLSNavierStokesSolver<dim, VectorType>::solve_system_AMG(
+  const bool   initial_step,
+  const double absolute_residual,
+  const double relative_residual,
+  const bool   renewed_matrix)
 {
   const AffineConstraints<double> &constraints_used =
     initial_step ? this->nonzero_constraints : this->zero_constraints;
@@ -1358,41 +1598,92 @@ GLSNavierStokesSolver<dim>::solve_system_AMG(const bool   initial_step,
                        this->nsparam.linear_solver.residual_precision)
                   << linear_solver_tolerance << std::endl;
     }
-  TrilinosWrappers::MPI::Vector completely_distributed_solution(
-    this->locally_owned_dofs, this->mpi_communicator);
+  this->newton_update = 0;
 
   SolverControl solver_control(this->nsparam.linear_solver.max_iterations,
                                linear_solver_tolerance,
                                true,
                                true);
-  TrilinosWrappers::SolverGMRES solver(solver_control);
+  TrilinosWrappers::SolverGMRES::AdditionalData solver_data(
+    false, this->nsparam.linear_solver.max_krylov_vectors);
+  TrilinosWrappers::SolverGMRES solver(solver_control, solver_data);
 
   if (renewed_matrix || !amg_preconditioner)
     setup_AMG();
+  else
+    ++this->solver_statistics.preconditioner_reuses;
 
   {
     TimerOutput::Scope t(this->computing_timer, "solve_linear_system");
 
-    solver.solve(system_matrix,
-                 completely_distributed_solution,
-                 this->system_rhs,
-                 *amg_preconditioner);
+    if (this->nsparam.linear_solver.krylov_recycling_vectors > 0)
+      krylov_recycler.solve(system_matrix,
+                            this->newton_update,
+                            this->system_rhs,
+                            *amg_preconditioner,
+                            solver_control,
+                            renewed_matrix);
+    else
+      solver.solve(system_matrix,
+                   this->newton_update,
+                   this->system_rhs,
+                   *amg_preconditioner);
+    this->solver_statistics.linear_iterations.push_back(
+      solver_control.last_step());
 
     if (this->nsparam.linear_solver.verbosity != Parameters::Verbosity::quiet)
       {
         this->pcout << "  -Iterative solver took : "
                     << solver_control.last_step() << " steps " << std::endl;
+        if (this->nsparam.linear_solver.krylov_recycling_vectors > 0)
+          this->pcout << "  -Recycled subspace dimension : "
+                      << krylov_recycler.get_n_recycled_vectors()
+                      << "  - Initial residual reduction : "
+                      << krylov_recycler.get_deflation_ratio()
+                      << "  - Saved iterations : "
+                      << krylov_recycler.get_saved_iterations() << " (total "
+                      << krylov_recycler.get_total_saved_iterations() << ")"
+                      << std::endl;
       }
 
-    constraints_used.distribute(completely_distributed_solution);
+    constraints_used.distribute(this->newton_update);
+  }
+}
 
-    this->newton_update = completely_distributed_solution;
+template <int dim, typename VectorType>
+void
+GLSNavierStokesSolver<dim, VectorType>::solve_system_direct(
+  const bool initial_step,
+  const bool renewed_matrix)
+{
+  const AffineConstraints<double> &constraints_used =
+    initial_step ? this->nonzero_constraints : this->zero_constraints;
+
+  if (renewed_matrix || !direct_solver)
+    setup_direct();
+  else
+    ++this->solver_statistics.preconditioner_reuses;
+
+  {
+    TimerOutput::Scope t(this->computing_timer, "solve_linear_system");
+
+    this->newton_update = 0;
+    solve_direct(this->newton_update, this->system_rhs);
+
+    if (this->nsparam.linear_solver.verbosity != Parameters::Verbosity::quiet)
+      {
+        this->pcout << "  -Direct solver "
+                    << (renewed_matrix ? "refactorized the matrix" :
+                                         "reused the factorization")
+                    << std::endl;
+      }
   }
+  constraints_used.distribute(this->newton_update);
 }
 
-template <int dim>
+template <int dim, typename VectorType>
 void
-GLSNavierStokesSolver<dim>::solve()
+GLSNavierStokesSolver<dim, VectorType>::solve()
 {
   read_mesh_and_manifolds(this->triangulation,
                           this->nsparam.mesh,
@@ -1400,9 +1691,22 @@ GLSNavierStokesSolver<dim>::solve()
                           this->nsparam.boundary_conditions);
 
   this->setup_dofs();
+
+  if (this->nsparam.ensemble.n_variants > 0)
+    {
+      solve_ensemble();
+      return;
+    }
+
   this->set_initial_condition(this->nsparam.initial_condition->type,
                               this->nsparam.restart_parameters.restart);
+  run_time_loop();
+}
 
+template <int dim, typename VectorType>
+void
+GLSNavierStokesSolver<dim, VectorType>::run_time_loop()
+{
   while (this->simulationControl->integrate())
     {
       this->simulationControl->print_progression(this->pcout);
@@ -1410,7 +1714,7 @@ GLSNavierStokesSolver<dim>::solve()
         this->first_iteration();
       else
         {
-          NavierStokesBase<dim, TrilinosWrappers::MPI::Vector, IndexSet>::
+          NavierStokesBase<dim, VectorType, IndexSet>::
             refine_mesh();
           this->iterate();
         }
@@ -1422,8 +1726,48 @@ GLSNavierStokesSolver<dim>::solve()
   this->finish_simulation();
 }
 
+// The mesh, the degrees of freedom, the sparsity pattern and the matrix are
+// those of the reference simulation for all the variants. The preconditioner
+// and the symbolic factorization of the direct solver are thus reused from
+// one variant to the next when the linear solver allows it.
+template <int dim, typename VectorType>
+void
+GLSNavierStokesSolver<dim, VectorType>::solve_ensemble()
+{
+  if (this->nsparam.mesh_adaptation.type !=
+      Parameters::MeshAdaptation::Type::none)
+    throw(std::runtime_error(
+      "Error, the variants of an ensemble share the same mesh. Mesh "
+      "adaptation is not supported"));
+
+  if (this->nsparam.restart_parameters.restart)
+    throw(std::runtime_error(
+      "Error, the variants of an ensemble cannot be restarted from a "
+      "checkpoint"));
+
+  const NavierStokesSolverParameters<dim> reference_parameters = this->nsparam;
+
+  AffineConstraints<double> reference_constraints;
+  reference_constraints.copy_from(this->nonzero_constraints);
+
+  for (unsigned int variant = 0;
+       variant < reference_parameters.ensemble.n_variants;
+       ++variant)
+    {
+      this->setup_ensemble_variant(variant,
+                                   reference_parameters,
+                                   reference_constraints);
+      this->set_initial_condition(this->nsparam.initial_condition->type);
+      run_time_loop();
+    }
+}
+
 
 // Pre-compile the 2D and 3D Navier-Stokes solver to ensure that the library is
 // valid before we actually compile the solver This greatly helps with debugging
 template class GLSNavierStokesSolver<2>;
 template class GLSNavierStokesSolver<3>;
+template class GLSNavierStokesSolver<2,
+                                     LinearAlgebra::distributed::Vector<double>>;
+template class GLSNavierStokesSolver<3,
+                                     LinearAlgebra::distributed::Vector<double>>;
@@ -37,6 +37,18 @@
 
 #include "core/time_integration_utilities.h"
 
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+
 
 /*
  * Constructor for the Navier-Stokes base class
@@ -68,26 +80,23 @@ NavierStokesBase<dim, VectorType, DofsType>::NavierStokesBase(
   , velocity_fem_degree(p_degreeVelocity)
   , pressure_fem_degree(p_degreePressure)
   , number_quadrature_points(p_degreeVelocity + 1)
+  , pseudo_cfl(p_nsparam.simulation_control.pseudo_cfl)
+  , pseudo_initial_residual(0)
+  , linear_solver_autotuned(false)
+  , boundary_faces_outdated(true)
+  , averaging_time(0)
+  , velocity_support_dofs_outdated(true)
+  , postprocessed_cfl(0)
+  , postprocessed_cfl_available(false)
+  , checkpoint_control(p_nsparam.restart_parameters.filename,
+                       p_nsparam.restart_parameters.n_generations)
+  , start_wall_time(std::chrono::steady_clock::now())
+  , walltime_checkpoint_written(false)
 {
   this->pcout.set_condition(
     Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0);
 
-  if (nsparam.simulation_control.method ==
-      Parameters::SimulationControl::TimeSteppingMethod::steady)
-    simulationControl =
-      std::make_shared<SimulationControlSteady>(nsparam.simulation_control);
-  else
-    {
-      if (nsparam.simulation_control.output_control ==
-          Parameters::SimulationControl::OutputControl::time)
-        simulationControl =
-          std::make_shared<SimulationControlTransientDynamicOutput>(
-            nsparam.simulation_control);
-      else
-        simulationControl = std::make_shared<SimulationControlTransient>(
-          nsparam.simulation_control);
-    }
-
+  create_simulation_control();
 
   // Overide default value of quadrature point if they are specified
   if (nsparam.fem_parameters.number_quadrature_points > 0)
@@ -97,11 +106,28 @@ NavierStokesBase<dim, VectorType, DofsType>::NavierStokesBase(
   if (nsparam.timer.type == Parameters::Timer::Type::none)
     this->computing_timer.disable_output();
 
+  if (nsparam.timer.write_metrics)
+    metrics_log =
+      MetricsLog(simulationControl->get_output_path() +
+                   nsparam.timer.metrics_output_name + ".jsonl",
+                 this_mpi_process == 0,
+                 nsparam.restart_parameters.restart);
+
   // Pre-allocate the force tables to match the number of boundary conditions
   forces_on_boundaries.resize(nsparam.boundary_conditions.size);
   torques_on_boundaries.resize(nsparam.boundary_conditions.size);
-  forces_tables.resize(nsparam.boundary_conditions.size);
-  torques_tables.resize(nsparam.boundary_conditions.size);
+  create_table_writers();
+  create_probes();
+
+  if (nsparam.simulation_control.asynchronous_output)
+    output_writer = std::make_unique<AsyncOutputWriter>(
+      std::size_t(nsparam.simulation_control.asynchronous_output_buffer) *
+      1024 * 1024);
+
+  // The boundary faces used by the force and torque calculation are gathered
+  // again after any change of the triangulation
+  boundary_faces_connection = this->triangulation->signals.any_change.connect(
+    [this]() { this->boundary_faces_outdated = true; });
 
   // Get the exact solution from the parser
   exact_solution = &nsparam.analytical_solution->velocity;
@@ -117,22 +143,40 @@ NavierStokesBase<dim, VectorType, DofsType>::NavierStokesBase(
               << " MPI rank(s)..." << std::endl;
 }
 
-// This is a primitive first implementation that could be greatly improved by
-// doing a single pass instead of N boundary passes
 template <int dim, typename VectorType, typename DofsType>
 void
-NavierStokesBase<dim, VectorType, DofsType>::postprocessing_forces(
+NavierStokesBase<dim, VectorType, DofsType>::postprocessing_forces_and_torques(
   const VectorType &evaluation_point)
 {
-  TimerOutput::Scope t(this->computing_timer, "calculate_forces");
+  TimerOutput::Scope t(this->computing_timer, "calculate_forces_and_torques");
 
-  this->forces_on_boundaries = calculate_forces(this->dof_handler,
-                                                evaluation_point,
-                                                nsparam.physical_properties,
-                                                nsparam.fem_parameters,
-                                                nsparam.boundary_conditions,
-                                                mpi_communicator);
+  if (boundary_faces_outdated)
+    {
+      boundary_faces =
+        gather_boundary_faces(this->dof_handler, nsparam.boundary_conditions);
+      boundary_faces_outdated = false;
+    }
+
+  calculate_forces_and_torques(this->dof_handler,
+                               boundary_faces,
+                               evaluation_point,
+                               nsparam.physical_properties,
+                               nsparam.fem_parameters,
+                               nsparam.boundary_conditions,
+                               mpi_communicator,
+                               this->forces_on_boundaries,
+                               this->torques_on_boundaries);
+
+  if (nsparam.forces_parameters.calculate_force)
+    postprocessing_forces();
+  if (nsparam.forces_parameters.calculate_torque)
+    postprocessing_torques();
+}
 
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::postprocessing_forces()
+{
   if (nsparam.forces_parameters.verbosity == Parameters::Verbosity::verbose &&
       this->this_mpi_process == 0)
     {
@@ -162,45 +206,20 @@ NavierStokesBase<dim, VectorType, DofsType>::postprocessing_forces(
        i_boundary < nsparam.boundary_conditions.size;
        ++i_boundary)
     {
-      this->forces_tables[i_boundary].add_value(
-        "time", simulationControl->get_current_time());
-      this->forces_tables[i_boundary].add_value(
-        "f_x", this->forces_on_boundaries[i_boundary][0]);
-      this->forces_tables[i_boundary].add_value(
-        "f_y", this->forces_on_boundaries[i_boundary][1]);
-      if (dim == 3)
-        this->forces_tables[i_boundary].add_value(
-          "f_z", this->forces_on_boundaries[i_boundary][2]);
-      else
-        this->forces_tables[i_boundary].add_value("f_z", 0.);
-
-      // Precision
-      this->forces_tables[i_boundary].set_precision(
-        "f_x", nsparam.forces_parameters.output_precision);
-      this->forces_tables[i_boundary].set_precision(
-        "f_y", nsparam.forces_parameters.output_precision);
-      this->forces_tables[i_boundary].set_precision(
-        "f_z", nsparam.forces_parameters.output_precision);
-      this->forces_tables[i_boundary].set_precision(
-        "time", nsparam.forces_parameters.output_precision);
+      const Tensor<1, dim> &force = this->forces_on_boundaries[i_boundary];
+      this->forces_tables[i_boundary].add_row(
+        {simulationControl->get_current_time(),
+         force[0],
+         force[1],
+         dim == 3 ? force[2] : 0.});
     }
 }
 
 
 template <int dim, typename VectorType, typename DofsType>
 void
-NavierStokesBase<dim, VectorType, DofsType>::postprocessing_torques(
-  const VectorType &evaluation_point)
+NavierStokesBase<dim, VectorType, DofsType>::postprocessing_torques()
 {
-  TimerOutput::Scope t(this->computing_timer, "calculate_torques");
-
-  this->torques_on_boundaries = calculate_torques(this->dof_handler,
-                                                  evaluation_point,
-                                                  nsparam.physical_properties,
-                                                  nsparam.fem_parameters,
-                                                  nsparam.boundary_conditions,
-                                                  mpi_communicator);
-
   if (nsparam.forces_parameters.verbosity == Parameters::Verbosity::verbose &&
       this->this_mpi_process == 0)
     {
@@ -229,24 +248,12 @@ NavierStokesBase<dim, VectorType, DofsType>::postprocessing_torques(
        boundary_id < nsparam.boundary_conditions.size;
        ++boundary_id)
     {
-      this->torques_tables[boundary_id].add_value(
-        "time", simulationControl->get_current_time());
-      this->torques_tables[boundary_id].add_value(
-        "T_x", this->torques_on_boundaries[boundary_id][0]);
-      this->torques_tables[boundary_id].add_value(
-        "T_y", this->torques_on_boundaries[boundary_id][1]);
-      this->torques_tables[boundary_id].add_value(
-        "T_z", this->torques_on_boundaries[boundary_id][2]);
-
-      // Precision
-      this->torques_tables[boundary_id].set_precision(
-        "T_x", nsparam.forces_parameters.output_precision);
-      this->torques_tables[boundary_id].set_precision(
-        "T_y", nsparam.forces_parameters.output_precision);
-      this->torques_tables[boundary_id].set_precision(
-        "T_z", nsparam.forces_parameters.output_precision);
-      this->torques_tables[boundary_id].set_precision(
-        "time", nsparam.forces_parameters.output_precision);
+      const Tensor<1, 3> &torque = this->torques_on_boundaries[boundary_id];
+      this->torques_tables[boundary_id].add_row(
+        {simulationControl->get_current_time(),
+         torque[0],
+         torque[1],
+         torque[2]});
     }
 }
 
@@ -389,6 +396,22 @@ NavierStokesBase<dim, VectorType, DofsType>::finish_simulation()
   if (nsparam.forces_parameters.calculate_torque)
     this->write_output_torques();
 
+  // Wait for the results which are still being written
+  if (output_writer)
+    output_writer->flush();
+
+  if (nsparam.post_processing.calculate_enstrophy)
+    this->enstrophy_table.flush();
+
+  if (nsparam.post_processing.calculate_kinetic_energy)
+    this->kinetic_energy_table.flush();
+
+  if (probes)
+    probes->flush();
+
+  if (nsparam.post_processing.calculate_time_averaged_statistics)
+    this->write_output_time_averaged_statistics();
+
   if (nsparam.analytical_solution->calculate_error())
     {
       if (nsparam.simulation_control.method ==
@@ -421,6 +444,9 @@ NavierStokesBase<dim, VectorType, DofsType>::finish_simulation()
           error_table.write_text(std::cout);
         }
     }
+
+  if (nsparam.timer.report_load_balance)
+    report_load_balance();
 }
 
 template <int dim, typename VectorType, typename DofsType>
@@ -430,28 +456,559 @@ NavierStokesBase<dim, VectorType, DofsType>::finish_time_step()
   if (nsparam.simulation_control.method !=
       Parameters::SimulationControl::TimeSteppingMethod::steady)
     {
-      this->solution_m3 = this->solution_m2;
-      this->solution_m2 = this->solution_m1;
-      this->solution_m1 = this->present_solution;
-      const double CFL  = calculate_CFL(this->dof_handler,
-                                       this->present_solution,
-                                       nsparam.fem_parameters,
-                                       simulationControl->get_time_step(),
-                                       mpi_communicator);
+      rotate_solution_history();
+      // The CFL of the present solution may already have been calculated by
+      // the post-processing of the time step
+      double CFL = postprocessed_cfl;
+      if (!postprocessed_cfl_available)
+        CFL = calculate_CFL(this->dof_handler,
+                            this->present_solution,
+                            nsparam.fem_parameters,
+                            simulationControl->get_time_step(),
+                            mpi_communicator);
+      postprocessed_cfl_available = false;
       this->simulationControl->set_CFL(CFL);
     }
-  if (this->nsparam.restart_parameters.checkpoint &&
-      simulationControl->get_step_number() %
-          this->nsparam.restart_parameters.frequency ==
-        0)
+  // A single checkpoint is written when the remaining wall time falls below
+  // the margin. The elapsed time of the slowest process is used so that all
+  // the processes take the same decision.
+  bool walltime_checkpoint = false;
+  if (this->nsparam.restart_parameters.walltime > 0 &&
+      !walltime_checkpoint_written)
+    {
+      const double elapsed_wall_time = Utilities::MPI::max(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                      start_wall_time)
+          .count(),
+        this->mpi_communicator);
+      walltime_checkpoint =
+        elapsed_wall_time >=
+        this->nsparam.restart_parameters.walltime -
+          this->nsparam.restart_parameters.walltime_checkpoint_margin;
+      walltime_checkpoint_written = walltime_checkpoint;
+      if (walltime_checkpoint)
+        this->pcout << "Writing a checkpoint before the walltime" << std::endl;
+    }
+
+  if ((this->nsparam.restart_parameters.checkpoint &&
+       simulationControl->get_step_number() %
+           this->nsparam.restart_parameters.frequency ==
+         0) ||
+      walltime_checkpoint)
     {
       this->write_checkpoint();
     }
 
+  if (this->nsparam.timer.write_metrics)
+    write_metrics();
+
+  if (this->nsparam.timer.report_load_balance &&
+      this->nsparam.timer.load_balance_frequency > 0 &&
+      simulationControl->get_step_number() %
+          this->nsparam.timer.load_balance_frequency ==
+        0)
+    report_load_balance();
+
   if (this->nsparam.timer.type == Parameters::Timer::Type::iteration)
     {
       this->computing_timer.print_summary();
       this->computing_timer.reset();
+      metrics_log.reset_increments("timer");
+    }
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::write_metrics()
+{
+  metrics_log.add("step", simulationControl->get_step_number());
+  metrics_log.add("time", simulationControl->get_current_time());
+  metrics_log.add("dt", simulationControl->get_time_step());
+  metrics_log.add("cfl", simulationControl->get_CFL());
+  metrics_log.add("n_cells", this->triangulation->n_global_active_cells());
+  metrics_log.add("n_dofs", this->dof_handler.n_dofs());
+  metrics_log.add("non_linear_iterations",
+                  this->solver_statistics.non_linear_iterations);
+  metrics_log.add("linear_iterations",
+                  this->solver_statistics.linear_iterations);
+  metrics_log.add("preconditioner_setups",
+                  this->solver_statistics.preconditioner_setups);
+  metrics_log.add("preconditioner_reuses",
+                  this->solver_statistics.preconditioner_reuses);
+
+  // The summary of the timer holds the wall time accumulated since the start
+  // of the simulation, the log keeps the part of the time step
+  metrics_log.add_increments(
+    "timer",
+    this->computing_timer.get_summary_data(TimerOutput::total_wall_time));
+  metrics_log.write();
+
+  this->solver_statistics.reset();
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::report_load_balance()
+{
+  unsigned int n_ghost_cells = 0;
+  for (const auto &cell : this->dof_handler.active_cell_iterators())
+    if (cell->is_ghost())
+      ++n_ghost_cells;
+
+  std::map<std::string, double> workload;
+  workload["ghost_cells"]         = n_ghost_cells;
+  workload["locally_owned_dofs"]  = this->dof_handler.n_locally_owned_dofs();
+  workload["locally_owned_cells"] =
+    this->triangulation->n_locally_owned_active_cells();
+
+  print_load_balance_report(
+    this->computing_timer.get_summary_data(TimerOutput::total_wall_time),
+    workload,
+    this->mpi_communicator,
+    this->pcout);
+}
+
+// Shift the solution history by one time step. The older vectors are
+// rotated by swapping their storage instead of being copied, which
+// leaves only the copy of the present solution into solution_m1.
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::rotate_solution_history()
+{
+  this->solution_m3.swap(this->solution_m2);
+  this->solution_m2.swap(this->solution_m1);
+  this->solution_m1 = this->present_solution;
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::renumber_dofs(
+  const Parameters::FEM::DofRenumbering automatic_renumbering)
+{
+  Parameters::FEM::DofRenumbering renumbering =
+    nsparam.fem_parameters.dof_renumbering;
+  if (renumbering == Parameters::FEM::DofRenumbering::automatic)
+    renumbering = automatic_renumbering;
+
+  switch (renumbering)
+    {
+      case Parameters::FEM::DofRenumbering::automatic:
+      case Parameters::FEM::DofRenumbering::none:
+        break;
+      case Parameters::FEM::DofRenumbering::cuthill_mckee:
+        DoFRenumbering::Cuthill_McKee(this->dof_handler);
+        break;
+      case Parameters::FEM::DofRenumbering::hierarchical:
+        DoFRenumbering::hierarchical(this->dof_handler);
+        break;
+      case Parameters::FEM::DofRenumbering::component_wise:
+        DoFRenumbering::component_wise(this->dof_handler);
+        break;
+    }
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::create_simulation_control()
+{
+  if (nsparam.simulation_control.method ==
+      Parameters::SimulationControl::TimeSteppingMethod::steady)
+    simulationControl =
+      std::make_shared<SimulationControlSteady>(nsparam.simulation_control);
+  else
+    {
+      if (nsparam.simulation_control.output_control ==
+          Parameters::SimulationControl::OutputControl::time)
+        simulationControl =
+          std::make_shared<SimulationControlTransientDynamicOutput>(
+            nsparam.simulation_control);
+      else
+        simulationControl = std::make_shared<SimulationControlTransient>(
+          nsparam.simulation_control);
+    }
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::create_table_writers()
+{
+  const bool write_to_file = this->this_mpi_process == 0;
+
+  enstrophy_table =
+    TableWriter(nsparam.post_processing.enstrophy_output_name + ".dat",
+                {"time", "enstrophy"},
+                12,
+                write_to_file);
+  kinetic_energy_table =
+    TableWriter(nsparam.post_processing.kinetic_energy_output_name + ".dat",
+                {"time", "kinetic-energy"},
+                12,
+                write_to_file);
+
+  forces_tables.clear();
+  torques_tables.clear();
+  for (unsigned int boundary_id = 0;
+       boundary_id < nsparam.boundary_conditions.size;
+       ++boundary_id)
+    {
+      const std::string suffix =
+        "." + Utilities::int_to_string(boundary_id, 2) + ".dat";
+      forces_tables.emplace_back(nsparam.forces_parameters.force_output_name +
+                                   suffix,
+                                 std::vector<std::string>{"time",
+                                                          "f_x",
+                                                          "f_y",
+                                                          "f_z"},
+                                 nsparam.forces_parameters.output_precision,
+                                 write_to_file);
+      torques_tables.emplace_back(nsparam.forces_parameters.torque_output_name +
+                                    suffix,
+                                  std::vector<std::string>{"time",
+                                                           "T_x",
+                                                           "T_y",
+                                                           "T_z"},
+                                  nsparam.forces_parameters.output_precision,
+                                  write_to_file);
+    }
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::create_probes()
+{
+  if (nsparam.probes.enable)
+    probes = std::make_unique<Probes<dim, VectorType>>(nsparam.probes,
+                                                       this->dof_handler,
+                                                       velocity_fem_degree,
+                                                       nsparam.fem_parameters,
+                                                       mpi_communicator);
+}
+
+// The variants share the mesh, the degrees of freedom and thus the sparsity
+// pattern of the reference simulation. Only the parameters read during the
+// assembly and the inhomogeneities of the constraints differ between them.
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::setup_ensemble_variant(
+  const unsigned int                       variant,
+  const NavierStokesSolverParameters<dim> &reference_parameters,
+  const AffineConstraints<double> &        reference_constraints)
+{
+  const Parameters::Ensemble &ensemble = reference_parameters.ensemble;
+
+  if (!ensemble.viscosities.empty())
+    nsparam.physical_properties.viscosity = ensemble.viscosities[variant];
+
+  if (!ensemble.angular_velocity_scales.empty())
+    {
+      const double scale = ensemble.angular_velocity_scales[variant];
+      nsparam.velocitySource.omega_x =
+        scale * reference_parameters.velocitySource.omega_x;
+      nsparam.velocitySource.omega_y =
+        scale * reference_parameters.velocitySource.omega_y;
+      nsparam.velocitySource.omega_z =
+        scale * reference_parameters.velocitySource.omega_z;
+    }
+
+  // The velocity imposed by the function boundary conditions only appears in
+  // the inhomogeneities of the nonzero constraints. Since the constraints are
+  // linear, scaling the inhomogeneities is equivalent to interpolating the
+  // scaled boundary values again. Only the velocity dofs of the function
+  // boundaries are scaled, including the hanging nodes on these boundaries.
+  if (!ensemble.velocity_scales.empty())
+    {
+      std::set<types::boundary_id> function_boundaries;
+      for (unsigned int i_bc = 0;
+           i_bc < reference_parameters.boundary_conditions.size;
+           ++i_bc)
+        if (reference_parameters.boundary_conditions.type[i_bc] ==
+            BoundaryConditions::BoundaryType::function)
+          function_boundaries.insert(
+            reference_parameters.boundary_conditions.id[i_bc]);
+
+      // Without boundary ids, all the boundary dofs would be extracted
+      IndexSet function_boundary_dofs(this->dof_handler.n_dofs());
+      if (!function_boundaries.empty())
+        {
+          const FEValuesExtractors::Vector velocities(0);
+          DoFTools::extract_boundary_dofs(this->dof_handler,
+                                          fe.component_mask(velocities),
+                                          function_boundary_dofs,
+                                          function_boundaries);
+        }
+
+      const double scale = ensemble.velocity_scales[variant];
+      for (const auto &line : reference_constraints.get_lines())
+        if (line.inhomogeneity != 0. &&
+            function_boundary_dofs.is_element(line.index))
+          this->nonzero_constraints.set_inhomogeneity(line.index,
+                                                      scale *
+                                                        line.inhomogeneity);
+    }
+
+  const std::string suffix =
+    "_variant_" + Utilities::int_to_string(variant, 2);
+  nsparam.simulation_control.output_name =
+    reference_parameters.simulation_control.output_name + suffix;
+  nsparam.forces_parameters.force_output_name =
+    reference_parameters.forces_parameters.force_output_name + suffix;
+  nsparam.forces_parameters.torque_output_name =
+    reference_parameters.forces_parameters.torque_output_name + suffix;
+  nsparam.post_processing.enstrophy_output_name =
+    reference_parameters.post_processing.enstrophy_output_name + suffix;
+  nsparam.post_processing.kinetic_energy_output_name =
+    reference_parameters.post_processing.kinetic_energy_output_name + suffix;
+  nsparam.post_processing.statistics_output_name =
+    reference_parameters.post_processing.statistics_output_name + suffix;
+  nsparam.probes.output_name = reference_parameters.probes.output_name + suffix;
+  nsparam.restart_parameters.filename =
+    reference_parameters.restart_parameters.filename + suffix;
+  nsparam.timer.metrics_output_name =
+    reference_parameters.timer.metrics_output_name + suffix;
+  checkpoint_control =
+    CheckpointControl(nsparam.restart_parameters.filename,
+                      nsparam.restart_parameters.n_generations);
+
+  // The time stepping and the post-processing start over for every variant
+  create_simulation_control();
+  pvdhandler            = PVDHandler();
+  xdmf_handler          = XDMFHandler();
+  error_table           = ConvergenceTable();
+  statistics_pvdhandler = PVDHandler();
+  averaging_time        = 0;
+  create_table_writers();
+  create_probes();
+  if (nsparam.timer.write_metrics)
+    metrics_log = MetricsLog(simulationControl->get_output_path() +
+                               nsparam.timer.metrics_output_name + ".jsonl",
+                             this_mpi_process == 0,
+                             false);
+
+  this->pcout << std::endl;
+  this->pcout
+    << "*****************************************************************"
+    << std::endl;
+  this->pcout << "Ensemble variant : " << variant + 1 << " of "
+              << ensemble.n_variants << std::endl;
+  this->pcout
+    << "*****************************************************************"
+    << std::endl;
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::
+  reset_pseudo_transient_continuation()
+{
+  pseudo_cfl              = nsparam.simulation_control.pseudo_cfl;
+  pseudo_initial_residual = 0;
+}
+
+// The pseudo CFL follows the reduction of the residual. The first residual
+// of the solve is the reference, and the CFL increases geometrically as the
+// residual decreases so that the pseudo-time term vanishes near convergence
+// and the quadratic convergence of the Newton method is recovered.
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::
+  update_pseudo_transient_continuation(const double residual)
+{
+  if (!nsparam.simulation_control.pseudo_transient)
+    return;
+
+  if (pseudo_initial_residual <= 0)
+    {
+      pseudo_initial_residual = residual;
+      return;
+    }
+
+  const double max_cfl = nsparam.simulation_control.pseudo_max_cfl;
+  if (residual > 0)
+    pseudo_cfl = std::min(nsparam.simulation_control.pseudo_cfl *
+                            pseudo_initial_residual / residual,
+                          max_cfl);
+  else
+    pseudo_cfl = max_cfl;
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::start_non_linear_solve(
+  const Parameters::SimulationControl::TimeSteppingMethod time_stepping_method)
+{
+  if (time_stepping_method ==
+      Parameters::SimulationControl::TimeSteppingMethod::steady)
+    reset_pseudo_transient_continuation();
+}
+
+// The pseudo CFL is only updated with the accepted iterates of the
+// non-linear solver. The trial points of the line search and the residuals of
+// the jacobian-free products would otherwise change it within an iteration.
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::accept_non_linear_iterate(
+  const Parameters::SimulationControl::TimeSteppingMethod time_stepping_method,
+  const double                                            residual)
+{
+  if (time_stepping_method ==
+      Parameters::SimulationControl::TimeSteppingMethod::steady)
+    update_pseudo_transient_continuation(residual);
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::autotune_linear_solver(
+  const bool                                               initial_step,
+  const std::vector<Parameters::LinearSolver::SolverType> &solver_types)
+{
+  using SolverType = Parameters::LinearSolver::SolverType;
+
+  linear_solver_autotuned = true;
+
+  // The trials are quiet and do not recycle a Krylov subspace, which would
+  // favour the configurations measured last
+  const Parameters::LinearSolver user_parameters = nsparam.linear_solver;
+  Parameters::LinearSolver       best            = user_parameters;
+  best.verbosity                = Parameters::Verbosity::quiet;
+  best.krylov_recycling_vectors = 0;
+  double best_time              = std::numeric_limits<double>::max();
+
+  // Solution of the fastest configuration, and whether the preconditioner
+  // left by the last trial is the one of that configuration
+  VectorType best_update     = this->newton_update;
+  bool       last_trial_best = false;
+
+  auto method_name = [](const Parameters::LinearSolver &p) {
+    if (p.solver == SolverType::amg)
+      return "amg";
+    else if (p.solver == SolverType::bicgstab)
+      return "bicgstab";
+    return "gmres";
+  };
+
+  auto describe = [&](const Parameters::LinearSolver &p) {
+    std::ostringstream description;
+    description << method_name(p);
+    if (p.solver == SolverType::amg)
+      description << " - aggregation threshold " << p.amg_aggregation_threshold
+                  << " - smoother sweeps " << p.amg_smoother_sweeps
+                  << " - n cycles " << p.amg_n_cycles;
+    else
+      description << " - ilu fill " << p.ilu_precond_fill;
+    return description.str();
+  };
+
+  // Solves the linear system with a candidate configuration and keeps it if
+  // it is the fastest so far. The preconditioner is always set-up again.
+  auto measure = [&](const Parameters::LinearSolver &candidate) {
+    nsparam.linear_solver = candidate;
+    Timer        timer;
+    unsigned int converged = 1;
+    try
+      {
+        this->solve_linear_system(initial_step, true);
+      }
+    catch (std::exception &)
+      {
+        converged = 0;
+      }
+    timer.stop();
+
+    // A failure on one rank is a failure on all of them, so that the ranks
+    // keep selecting the same configurations. This does not recover from a
+    // rank which failed in the middle of a collective operation of the
+    // solver, which the other ranks then wait for.
+    converged = Utilities::MPI::min(converged, this->mpi_communicator);
+    const double time =
+      Utilities::MPI::max(timer.wall_time(), this->mpi_communicator);
+
+    this->pcout << "   Autotune - " << describe(candidate) << " : ";
+    if (converged)
+      this->pcout << time << " s" << std::endl;
+    else
+      this->pcout << "failed" << std::endl;
+
+    last_trial_best = converged && time < best_time;
+    if (last_trial_best)
+      {
+        best        = candidate;
+        best_time   = time;
+        best_update = this->newton_update;
+      }
+  };
+
+  // Tunes one parameter of the best configuration found so far
+  auto tune = [&](auto member, const auto &values) {
+    const Parameters::LinearSolver reference = best;
+    for (const auto &value : values)
+      {
+        if (value == reference.*member)
+          continue;
+        Parameters::LinearSolver candidate = reference;
+        candidate.*member                  = value;
+        measure(candidate);
+      }
+  };
+
+  this->pcout << "   Autotune of the linear solver" << std::endl;
+
+  const Parameters::LinearSolver reference = best;
+  for (const SolverType solver_type : solver_types)
+    {
+      Parameters::LinearSolver candidate = reference;
+      candidate.solver                   = solver_type;
+      measure(candidate);
+    }
+
+  if (best_time == std::numeric_limits<double>::max())
+    throw(std::runtime_error(
+      "None of the linear solvers tested by the autotune has converged"));
+
+  if (best.solver == SolverType::amg)
+    {
+      tune(&Parameters::LinearSolver::amg_aggregation_threshold,
+           std::vector<double>{1e-14, 1e-4, 1e-2});
+      tune(&Parameters::LinearSolver::amg_smoother_sweeps,
+           std::vector<unsigned int>{1, 2, 4});
+      tune(&Parameters::LinearSolver::amg_n_cycles,
+           std::vector<unsigned int>{1, 2});
+    }
+  else
+    tune(&Parameters::LinearSolver::ilu_precond_fill,
+         std::vector<double>{0, 1, 2});
+
+  best.verbosity                = user_parameters.verbosity;
+  best.krylov_recycling_vectors = user_parameters.krylov_recycling_vectors;
+  nsparam.linear_solver         = best;
+
+  // The solution of the fastest trial is the solution of the linear system.
+  // The preconditioner may be reused if the matrix is not renewed, so it is
+  // only set-up again if the last trial was not the fastest.
+  this->newton_update = best_update;
+  if (!last_trial_best)
+    this->setup_preconditioner();
+
+  this->pcout << "   Autotune selected " << describe(best) << std::endl;
+
+  // Parameter file with the selected configuration
+  if (this->this_mpi_process == 0)
+    {
+      std::ofstream output(simulationControl->get_output_path() +
+                           "autotuned_linear_solver.prm");
+      output << "# Linear solver selected by the autotune" << std::endl
+             << "subsection linear solver" << std::endl
+             << "  set method                    = " << method_name(best)
+             << std::endl
+             << "  set ilu preconditioner fill   = " << best.ilu_precond_fill
+             << std::endl
+             << "  set amg aggregation threshold = "
+             << best.amg_aggregation_threshold << std::endl
+             << "  set amg smoother sweeps       = " << best.amg_smoother_sweeps
+             << std::endl
+             << "  set amg n cycles              = " << best.amg_n_cycles
+             << std::endl
+             << "  set autotune                  = false" << std::endl
+             << "end" << std::endl;
     }
 }
 
@@ -533,8 +1090,7 @@ NavierStokesBase<dim, VectorType, DofsType>::first_iteration()
       simulationControl->set_current_time_step(time_step);
       PhysicsSolver<VectorType>::solve_non_linear_system(
         Parameters::SimulationControl::TimeSteppingMethod::bdf1, false, true);
-      this->solution_m2 = this->solution_m1;
-      this->solution_m1 = this->present_solution;
+      rotate_solution_history();
 
       // Reset the time step and do a bdf 2 newton iteration using the two
       // steps to complete the full step
@@ -563,8 +1119,7 @@ NavierStokesBase<dim, VectorType, DofsType>::first_iteration()
 
       PhysicsSolver<VectorType>::solve_non_linear_system(
         Parameters::SimulationControl::TimeSteppingMethod::bdf1, false, true);
-      this->solution_m2 = this->solution_m1;
-      this->solution_m1 = this->present_solution;
+      rotate_solution_history();
 
       // Reset the time step and do a bdf 2 newton iteration using the two
       // steps
@@ -573,9 +1128,7 @@ NavierStokesBase<dim, VectorType, DofsType>::first_iteration()
 
       PhysicsSolver<VectorType>::solve_non_linear_system(
         Parameters::SimulationControl::TimeSteppingMethod::bdf1, false, true);
-      this->solution_m3 = this->solution_m2;
-      this->solution_m2 = this->solution_m1;
-      this->solution_m1 = this->present_solution;
+      rotate_solution_history();
 
       // Reset the time step and do a bdf 3 newton iteration using the two
       // steps to complete the full step
@@ -685,23 +1238,27 @@ NavierStokesBase<dim, VectorType, DofsType>::refine_mesh_kelly()
 
   tria.prepare_coarsening_and_refinement();
 
-  // Solution transfer objects for all the solutions
+  // A single solution transfer object carries the present solution and the
+  // whole solution history through the refinement in one pass
+  std::vector<const VectorType *> sol_set_transfer;
+  sol_set_transfer.push_back(&this->present_solution);
+  sol_set_transfer.push_back(&this->solution_m1);
+  sol_set_transfer.push_back(&this->solution_m2);
+  sol_set_transfer.push_back(&this->solution_m3);
+
+  // The time-averaged statistics are carried along with the solution
+  std::vector<VectorType> statistics;
+  if (nsparam.post_processing.calculate_time_averaged_statistics)
+    statistics = ghosted_time_averaged_statistics();
+  for (const VectorType &statistic : statistics)
+    sol_set_transfer.push_back(&statistic);
   parallel::distributed::SolutionTransfer<dim, VectorType> solution_transfer(
     this->dof_handler);
-  parallel::distributed::SolutionTransfer<dim, VectorType> solution_transfer_m1(
-    this->dof_handler);
-  parallel::distributed::SolutionTransfer<dim, VectorType> solution_transfer_m2(
-    this->dof_handler);
-  parallel::distributed::SolutionTransfer<dim, VectorType> solution_transfer_m3(
-    this->dof_handler);
-  solution_transfer.prepare_for_coarsening_and_refinement(
-    this->present_solution);
-  solution_transfer_m1.prepare_for_coarsening_and_refinement(this->solution_m1);
-  solution_transfer_m2.prepare_for_coarsening_and_refinement(this->solution_m2);
-  solution_transfer_m3.prepare_for_coarsening_and_refinement(this->solution_m3);
+  solution_transfer.prepare_for_coarsening_and_refinement(sol_set_transfer);
 
   tria.execute_coarsening_and_refinement();
   setup_dofs();
+  velocity_support_dofs_outdated = true;
 
   // Set up the vectors for the transfer
   VectorType tmp(locally_owned_dofs, this->mpi_communicator);
@@ -710,10 +1267,16 @@ NavierStokesBase<dim, VectorType, DofsType>::refine_mesh_kelly()
   VectorType tmp_m3(locally_owned_dofs, this->mpi_communicator);
 
   // Interpolate the solution at time and previous time
-  solution_transfer.interpolate(tmp);
-  solution_transfer_m1.interpolate(tmp_m1);
-  solution_transfer_m2.interpolate(tmp_m2);
-  solution_transfer_m3.interpolate(tmp_m3);
+  std::vector<VectorType *> sol_set_interpolated;
+  sol_set_interpolated.push_back(&tmp);
+  sol_set_interpolated.push_back(&tmp_m1);
+  sol_set_interpolated.push_back(&tmp_m2);
+  sol_set_interpolated.push_back(&tmp_m3);
+  std::vector<VectorType> interpolated_statistics(
+    statistics.size(), VectorType(locally_owned_dofs, this->mpi_communicator));
+  for (VectorType &statistic : interpolated_statistics)
+    sol_set_interpolated.push_back(&statistic);
+  solution_transfer.interpolate(sol_set_interpolated);
 
   // Distribute constraints
   this->nonzero_constraints.distribute(tmp);
@@ -726,6 +1289,7 @@ NavierStokesBase<dim, VectorType, DofsType>::refine_mesh_kelly()
   this->solution_m1      = tmp_m1;
   this->solution_m2      = tmp_m2;
   this->solution_m3      = tmp_m3;
+  set_time_averaged_statistics(interpolated_statistics);
 }
 
 template <int dim, typename VectorType, typename DofsType>
@@ -734,25 +1298,29 @@ NavierStokesBase<dim, VectorType, DofsType>::refine_mesh_uniform()
 {
   TimerOutput::Scope t(this->computing_timer, "refine");
 
-  // Solution transfer objects for all the solutions
+  // A single solution transfer object carries the present solution and the
+  // whole solution history through the refinement in one pass
+  std::vector<const VectorType *> sol_set_transfer;
+  sol_set_transfer.push_back(&this->present_solution);
+  sol_set_transfer.push_back(&this->solution_m1);
+  sol_set_transfer.push_back(&this->solution_m2);
+  sol_set_transfer.push_back(&this->solution_m3);
+
+  // The time-averaged statistics are carried along with the solution
+  std::vector<VectorType> statistics;
+  if (nsparam.post_processing.calculate_time_averaged_statistics)
+    statistics = ghosted_time_averaged_statistics();
+  for (const VectorType &statistic : statistics)
+    sol_set_transfer.push_back(&statistic);
   parallel::distributed::SolutionTransfer<dim, VectorType> solution_transfer(
     this->dof_handler);
-  parallel::distributed::SolutionTransfer<dim, VectorType> solution_transfer_m1(
-    this->dof_handler);
-  parallel::distributed::SolutionTransfer<dim, VectorType> solution_transfer_m2(
-    this->dof_handler);
-  parallel::distributed::SolutionTransfer<dim, VectorType> solution_transfer_m3(
-    this->dof_handler);
-  solution_transfer.prepare_for_coarsening_and_refinement(
-    this->present_solution);
-  solution_transfer_m1.prepare_for_coarsening_and_refinement(this->solution_m1);
-  solution_transfer_m2.prepare_for_coarsening_and_refinement(this->solution_m2);
-  solution_transfer_m3.prepare_for_coarsening_and_refinement(this->solution_m3);
+  solution_transfer.prepare_for_coarsening_and_refinement(sol_set_transfer);
 
   // Refine
   this->triangulation->refine_global(1);
 
   setup_dofs();
+  velocity_support_dofs_outdated = true;
 
   // Set up the vectors for the transfer
   VectorType tmp(locally_owned_dofs, this->mpi_communicator);
@@ -761,10 +1329,16 @@ NavierStokesBase<dim, VectorType, DofsType>::refine_mesh_uniform()
   VectorType tmp_m3(locally_owned_dofs, this->mpi_communicator);
 
   // Interpolate the solution at time and previous time
-  solution_transfer.interpolate(tmp);
-  solution_transfer_m1.interpolate(tmp_m1);
-  solution_transfer_m2.interpolate(tmp_m2);
-  solution_transfer_m3.interpolate(tmp_m3);
+  std::vector<VectorType *> sol_set_interpolated;
+  sol_set_interpolated.push_back(&tmp);
+  sol_set_interpolated.push_back(&tmp_m1);
+  sol_set_interpolated.push_back(&tmp_m2);
+  sol_set_interpolated.push_back(&tmp_m3);
+  std::vector<VectorType> interpolated_statistics(
+    statistics.size(), VectorType(locally_owned_dofs, this->mpi_communicator));
+  for (VectorType &statistic : interpolated_statistics)
+    sol_set_interpolated.push_back(&statistic);
+  solution_transfer.interpolate(sol_set_interpolated);
 
   // Distribute constraints
   this->nonzero_constraints.distribute(tmp);
@@ -777,6 +1351,7 @@ NavierStokesBase<dim, VectorType, DofsType>::refine_mesh_uniform()
   this->solution_m1      = tmp_m1;
   this->solution_m2      = tmp_m2;
   this->solution_m3      = tmp_m3;
+  set_time_averaged_statistics(interpolated_statistics);
 }
 
 template <int dim, typename VectorType, typename DofsType>
@@ -788,16 +1363,50 @@ NavierStokesBase<dim, VectorType, DofsType>::postprocess(bool firstIter)
 
 
 
+  const bool transient =
+    nsparam.simulation_control.method !=
+    Parameters::SimulationControl::TimeSteppingMethod::steady;
+  const bool calculate_cfl = transient && !firstIter;
+  const bool calculate_error =
+    !firstIter && this->nsparam.analytical_solution->calculate_error();
+
+  // The volume quantities are calculated in a single pass over the cells
+  VolumeQuantities volume_quantities;
+  if (calculate_cfl || calculate_error ||
+      this->nsparam.post_processing.calculate_enstrophy ||
+      this->nsparam.post_processing.calculate_kinetic_energy)
+    {
+      TimerOutput::Scope t(this->computing_timer, "volume_postprocessing");
+
+      // Update the time of the exact solution to the actual time
+      if (calculate_error)
+        this->exact_solution->set_time(simulationControl->get_current_time());
+
+      volume_quantities = calculate_volume_quantities(
+        this->dof_handler,
+        this->present_solution,
+        nsparam.fem_parameters,
+        calculate_cfl,
+        simulationControl->get_time_step(),
+        this->nsparam.post_processing.calculate_kinetic_energy,
+        this->nsparam.post_processing.calculate_enstrophy,
+        calculate_error ? this->exact_solution : nullptr,
+        this->number_quadrature_points + 1,
+        mpi_communicator);
+
+      if (calculate_cfl)
+        {
+          postprocessed_cfl           = volume_quantities.cfl;
+          postprocessed_cfl_available = true;
+        }
+    }
+
   if (this->nsparam.post_processing.calculate_enstrophy)
     {
-      double enstrophy = calculate_enstrophy(this->dof_handler,
-                                             this->present_solution,
-                                             nsparam.fem_parameters,
-                                             mpi_communicator);
+      const double enstrophy = volume_quantities.enstrophy;
 
-      this->enstrophy_table.add_value("time",
-                                      simulationControl->get_current_time());
-      this->enstrophy_table.add_value("enstrophy", enstrophy);
+      this->enstrophy_table.add_row(
+        {simulationControl->get_current_time(), enstrophy});
 
       // Display Enstrophy to screen if verbosity is enabled
       if (this->nsparam.post_processing.verbosity ==
@@ -806,89 +1415,90 @@ NavierStokesBase<dim, VectorType, DofsType>::postprocess(bool firstIter)
           this->pcout << "Enstrophy  : " << enstrophy << std::endl;
         }
 
-      // Output Enstrophy to a text file from processor 0
+      // Append the new rows of the enstrophy table to its text file, which is
+      // written by processor 0
       if (simulationControl->get_step_number() %
-              this->nsparam.post_processing.output_frequency ==
-            0 &&
-          this->this_mpi_process == 0)
-        {
-          std::string filename =
-            nsparam.post_processing.enstrophy_output_name + ".dat";
-          std::ofstream output(filename.c_str());
-          enstrophy_table.set_precision("time", 12);
-          enstrophy_table.set_precision("enstrophy", 12);
-          this->enstrophy_table.write_text(output);
-        }
+            this->nsparam.post_processing.output_frequency ==
+          0)
+        this->enstrophy_table.flush();
     }
 
   if (this->nsparam.post_processing.calculate_kinetic_energy)
     {
-      TimerOutput::Scope t(this->computing_timer, "kinetic_energy_calculation");
-      double             kE = calculate_kinetic_energy(this->dof_handler,
-                                           this->present_solution,
-                                           nsparam.fem_parameters,
-                                           mpi_communicator);
-      this->kinetic_energy_table.add_value(
-        "time", simulationControl->get_current_time());
-      this->kinetic_energy_table.add_value("kinetic-energy", kE);
+      const double kE = volume_quantities.kinetic_energy;
+      this->kinetic_energy_table.add_row(
+        {simulationControl->get_current_time(), kE});
       if (this->nsparam.post_processing.verbosity ==
           Parameters::Verbosity::verbose)
         {
           this->pcout << "Kinetic energy : " << kE << std::endl;
         }
 
-      // Output Kinetic Energy to a text file from processor 0
-      if ((simulationControl->get_step_number() %
-             this->nsparam.post_processing.output_frequency ==
-           0) &&
-          this->this_mpi_process == 0)
-        {
-          std::string filename =
-            nsparam.post_processing.kinetic_energy_output_name + ".dat";
-          std::ofstream output(filename.c_str());
-          kinetic_energy_table.set_precision("time", 12);
-          kinetic_energy_table.set_precision("kinetic-energy", 12);
-          this->kinetic_energy_table.write_text(output);
-        }
+      // Append the new rows of the kinetic energy table to its text file,
+      // which is written by processor 0
+      if (simulationControl->get_step_number() %
+            this->nsparam.post_processing.output_frequency ==
+          0)
+        this->kinetic_energy_table.flush();
     }
 
   if (!firstIter)
     {
-      // Calculate forces on the boundary conditions
-      if (this->nsparam.forces_parameters.calculate_force)
+      // Sample the probes at their own frequency
+      if (probes &&
+          simulationControl->get_step_number() %
+              this->nsparam.probes.frequency ==
+            0)
         {
-          if (simulationControl->get_step_number() %
-                this->nsparam.forces_parameters.calculation_frequency ==
-              0)
-            this->postprocessing_forces(this->present_solution);
-          if (simulationControl->get_step_number() %
-                this->nsparam.forces_parameters.output_frequency ==
-              0)
-            this->write_output_forces();
+          TimerOutput::Scope t(this->computing_timer, "probes");
+          probes->sample(this->present_solution,
+                         simulationControl->get_current_time());
         }
 
-      // Calculate torques on the boundary conditions
-      if (this->nsparam.forces_parameters.calculate_torque)
+      // Add the solution to the time-averaged statistics once the averaging
+      // has started
+      if (transient &&
+          this->nsparam.post_processing.calculate_time_averaged_statistics &&
+          simulationControl->get_current_time() >
+            this->nsparam.post_processing.statistics_initial_time)
         {
-          if (simulationControl->get_step_number() %
-                this->nsparam.forces_parameters.calculation_frequency ==
-              0)
-            this->postprocessing_torques(this->present_solution);
-          if (simulationControl->get_step_number() %
-                this->nsparam.forces_parameters.output_frequency ==
-              0)
-            this->write_output_torques();
+          this->update_time_averaged_statistics();
+
+          const unsigned int statistics_output_frequency =
+            this->nsparam.post_processing.statistics_output_frequency;
+          if (statistics_output_frequency > 0 &&
+              simulationControl->get_step_number() %
+                  statistics_output_frequency ==
+                0)
+            this->write_output_time_averaged_statistics();
         }
 
+      // Calculate forces and torques on the boundary conditions in a single
+      // pass at their own calculation frequency
+      if ((this->nsparam.forces_parameters.calculate_force ||
+           this->nsparam.forces_parameters.calculate_torque) &&
+          simulationControl->get_step_number() %
+              this->nsparam.forces_parameters.calculation_frequency ==
+            0)
+        this->postprocessing_forces_and_torques(this->present_solution);
+
+      if (this->nsparam.forces_parameters.calculate_force &&
+          simulationControl->get_step_number() %
+              this->nsparam.forces_parameters.output_frequency ==
+            0)
+        this->write_output_forces();
+
+      if (this->nsparam.forces_parameters.calculate_torque &&
+          simulationControl->get_step_number() %
+              this->nsparam.forces_parameters.output_frequency ==
+            0)
+        this->write_output_torques();
+
       // Calculate error with respect to analytical solution
-      if (this->nsparam.analytical_solution->calculate_error())
+      if (calculate_error)
         {
-          // Update the time of the exact solution to the actual time
-          this->exact_solution->set_time(simulationControl->get_current_time());
-          const std::pair<double, double> errors =
-            this->calculate_L2_error(this->present_solution);
-          const double error_velocity = errors.first;
-          const double error_pressure = errors.second;
+          const double error_velocity = volume_quantities.l2_error_velocity;
+          const double error_pressure = volume_quantities.l2_error_pressure;
           if (nsparam.simulation_control.method ==
               Parameters::SimulationControl::TimeSteppingMethod::steady)
             {
@@ -949,9 +1559,72 @@ void
 NavierStokesBase<dim, VectorType, DofsType>::read_checkpoint()
 {
   TimerOutput::Scope timer(this->computing_timer, "read_checkpoint");
-  std::string        prefix = this->nsparam.restart_parameters.filename;
+
+  // The most recent checkpoint matching its checksums is found by the first
+  // process, along with the error raised if there is none
+  std::pair<std::string, std::string> latest_checkpoint;
+  if (this_mpi_process == 0)
+    {
+      try
+        {
+          latest_checkpoint.first = checkpoint_control.latest_valid_prefix();
+        }
+      catch (std::exception &exc)
+        {
+          latest_checkpoint.second = exc.what();
+        }
+    }
+  latest_checkpoint =
+    Utilities::MPI::all_gather(this->mpi_communicator, latest_checkpoint)[0];
+  AssertThrow(latest_checkpoint.second.empty(),
+              ExcMessage(latest_checkpoint.second));
+  const std::string prefix = latest_checkpoint.first;
+  this->pcout << "Restarting from the checkpoint " << prefix << std::endl;
+
   this->simulationControl->read(prefix);
   this->pvdhandler.read(prefix);
+  if (nsparam.simulation_control.output_format ==
+      Parameters::SimulationControl::OutputFormat::hdf5)
+    this->xdmf_handler.read(prefix);
+
+  // The table files are truncated to the rows of the checkpoint and the
+  // following rows are appended to them
+  if (nsparam.post_processing.calculate_enstrophy)
+    this->enstrophy_table.read(prefix + ".enstrophy");
+  if (nsparam.post_processing.calculate_kinetic_energy)
+    this->kinetic_energy_table.read(prefix + ".kinetic_energy");
+  for (unsigned int boundary_id = 0;
+       boundary_id < nsparam.boundary_conditions.size;
+       ++boundary_id)
+    {
+      const std::string suffix = Utilities::int_to_string(boundary_id, 2);
+      if (nsparam.forces_parameters.calculate_force)
+        this->forces_tables[boundary_id].read(prefix + ".force." + suffix);
+      if (nsparam.forces_parameters.calculate_torque)
+        this->torques_tables[boundary_id].read(prefix + ".torque." + suffix);
+    }
+  if (probes)
+    probes->read(prefix);
+  if (nsparam.post_processing.calculate_time_averaged_statistics)
+    {
+      // The averages are stored in the checkpoint after the solution history.
+      // A checkpoint written without the statistics holds fewer vectors than
+      // the ones which would be deserialized.
+      const std::string filename = prefix + ".statistics";
+      std::ifstream     input(filename.c_str());
+      AssertThrow(
+        input,
+        ExcMessage(
+          "The checkpoint " + prefix +
+          " does not contain the time-averaged statistics since it was "
+          "written by a simulation which did not calculate them. The "
+          "time-averaged statistics can only be enabled when restarting "
+          "from a checkpoint which contains them."));
+      std::string buffer;
+      input >> buffer >> averaging_time;
+
+      this->statistics_pvdhandler.read(prefix + ".statistics");
+    }
 
   const std::string filename = prefix + ".triangulation";
   std::ifstream     in(filename.c_str());
@@ -976,6 +1649,7 @@ NavierStokesBase<dim, VectorType, DofsType>::read_checkpoint()
                              "triangulation stored there."));
     }
   setup_dofs();
+  velocity_support_dofs_outdated = true;
   std::vector<VectorType *> x_system(4);
 
   VectorType distributed_system(this->newton_update);
@@ -986,6 +1660,14 @@ NavierStokesBase<dim, VectorType, DofsType>::read_checkpoint()
   x_system[1] = &(distributed_system_m1);
   x_system[2] = &(distributed_system_m2);
   x_system[3] = &(distributed_system_m3);
+
+  // The time-averaged statistics are stored after the solution history
+  std::vector<VectorType> statistics;
+  if (nsparam.post_processing.calculate_time_averaged_statistics)
+    statistics.resize(3, this->newton_update);
+  for (VectorType &statistic : statistics)
+    x_system.push_back(&statistic);
+
   parallel::distributed::SolutionTransfer<dim, VectorType> system_trans_vectors(
     this->dof_handler);
   system_trans_vectors.deserialize(x_system);
@@ -993,6 +1675,7 @@ NavierStokesBase<dim, VectorType, DofsType>::read_checkpoint()
   this->solution_m1      = distributed_system_m1;
   this->solution_m2      = distributed_system_m2;
   this->solution_m3      = distributed_system_m3;
+  set_time_averaged_statistics(statistics);
 }
 
 template <int dim, typename VectorType, typename DofsType>
@@ -1063,14 +1746,34 @@ NavierStokesBase<dim, VectorType, DofsType>::write_output_results(
                          subdivision,
                          DataOut<dim>::curved_inner_cells);
 
-  write_vtu_and_pvd<dim>(this->pvdhandler,
-                         data_out,
-                         folder,
-                         solution_name,
-                         time,
-                         iter,
-                         group_files,
-                         this->mpi_communicator);
+  if (nsparam.simulation_control.output_format ==
+      Parameters::SimulationControl::OutputFormat::hdf5)
+    write_hdf5_and_xdmf<dim>(this->xdmf_handler,
+                             data_out,
+                             folder,
+                             solution_name,
+                             time,
+                             iter,
+                             nsparam.simulation_control.hdf5_compression,
+                             this->mpi_communicator);
+  else if (output_writer)
+    write_vtu_and_pvd<dim>(*output_writer,
+                           this->pvdhandler,
+                           data_out,
+                           folder,
+                           solution_name,
+                           time,
+                           iter,
+                           this->mpi_communicator);
+  else
+    write_vtu_and_pvd<dim>(this->pvdhandler,
+                           data_out,
+                           folder,
+                           solution_name,
+                           time,
+                           iter,
+                           group_files,
+                           this->mpi_communicator);
 
   if (nsparam.post_processing.output_boundaries)
     {
@@ -1087,37 +1790,222 @@ NavierStokesBase<dim, VectorType, DofsType>::write_output_results(
 
 template <int dim, typename VectorType, typename DofsType>
 void
-NavierStokesBase<dim, VectorType, DofsType>::write_output_forces()
+NavierStokesBase<dim, VectorType, DofsType>::update_time_averaged_statistics()
 {
-  TimerOutput::Scope t(this->computing_timer, "output_forces");
-  for (unsigned int boundary_id = 0;
-       boundary_id < nsparam.boundary_conditions.size;
-       ++boundary_id)
-    {
-      std::string filename = nsparam.forces_parameters.force_output_name + "." +
-                             Utilities::int_to_string(boundary_id, 2) + ".dat";
-      std::ofstream output(filename.c_str());
+  TimerOutput::Scope t(this->computing_timer, "time_averaged_statistics");
+
+  VectorType solution(locally_owned_dofs, this->mpi_communicator);
+  solution = this->present_solution;
 
-      forces_tables[boundary_id].write_text(output);
+  if (averaging_time == 0)
+    {
+      average_solution.reinit(solution);
+      average_squared_solution.reinit(solution);
+      average_velocity_products.reinit(solution);
     }
+
+  // Running averages weighted by the time step, the first step initializes
+  // them with the present solution
+  const double time_step = simulationControl->get_time_step();
+  averaging_time += time_step;
+  const double weight = time_step / averaging_time;
+
+  average_solution.sadd(1. - weight, weight, solution);
+
+  VectorType product(solution);
+  product.scale(solution);
+  average_squared_solution.sadd(1. - weight, weight, product);
+
+  shift_velocity_components(solution, product);
+  product.scale(solution);
+  average_velocity_products.sadd(1. - weight, weight, product);
+}
+
+template <int dim, typename VectorType, typename DofsType>
+std::vector<VectorType>
+NavierStokesBase<dim, VectorType, DofsType>::time_averaged_statistics()
+{
+  // Variances <u'u'> = <uu> - <u><u> of the velocity and pressure and shear
+  // Reynolds stresses <u'v'> = <uv> - <u><v>
+  VectorType mean_product(average_solution);
+  mean_product.scale(average_solution);
+  VectorType variance(average_squared_solution);
+  variance -= mean_product;
+
+  shift_velocity_components(average_solution, mean_product);
+  mean_product.scale(average_solution);
+  VectorType shear_stress(average_velocity_products);
+  shear_stress -= mean_product;
+
+  return {average_solution, variance, shear_stress};
 }
 
 template <int dim, typename VectorType, typename DofsType>
 void
-NavierStokesBase<dim, VectorType, DofsType>::write_output_torques()
+NavierStokesBase<dim, VectorType, DofsType>::
+  write_output_time_averaged_statistics()
 {
-  TimerOutput::Scope t(this->computing_timer, "output_torques");
-  for (unsigned int boundary_id = 0;
-       boundary_id < nsparam.boundary_conditions.size;
-       ++boundary_id)
+  if (averaging_time == 0)
+    return;
+
+  TimerOutput::Scope  t(this->computing_timer, "output_statistics");
+  const MappingQ<dim> mapping(this->velocity_fem_degree,
+                              nsparam.fem_parameters.qmapping_all);
+
+  const std::vector<VectorType> owned_statistics = time_averaged_statistics();
+  std::vector<VectorType>       statistics(
+    3,
+    VectorType(locally_owned_dofs,
+               locally_relevant_dofs,
+               this->mpi_communicator));
+  for (unsigned int i = 0; i < statistics.size(); ++i)
+    statistics[i] = owned_statistics[i];
+
+  std::vector<DataComponentInterpretation::DataComponentInterpretation>
+    data_component_interpretation(
+      dim, DataComponentInterpretation::component_is_part_of_vector);
+  data_component_interpretation.push_back(
+    DataComponentInterpretation::component_is_scalar);
+
+  std::vector<std::string> average_names(dim, "average_velocity");
+  average_names.push_back("average_pressure");
+  std::vector<std::string> variance_names(dim, "reynolds_normal_stress");
+  variance_names.push_back("pressure_variance");
+  // The pressure dofs of the shear stresses are zero
+  std::vector<std::string> shear_stress_names(dim, "reynolds_shear_stress");
+  shear_stress_names.push_back("reynolds_shear_stress_pressure");
+
+  DataOut<dim> data_out;
+
+  DataOutBase::VtkFlags flags;
+  if (this->velocity_fem_degree > 1)
+    flags.write_higher_order_cells = true;
+  data_out.set_flags(flags);
+
+  data_out.attach_dof_handler(this->dof_handler);
+  data_out.add_data_vector(statistics[0],
+                           average_names,
+                           DataOut<dim>::type_dof_data,
+                           data_component_interpretation);
+  data_out.add_data_vector(statistics[1],
+                           variance_names,
+                           DataOut<dim>::type_dof_data,
+                           data_component_interpretation);
+  data_out.add_data_vector(statistics[2],
+                           shear_stress_names,
+                           DataOut<dim>::type_dof_data,
+                           data_component_interpretation);
+  data_out.build_patches(mapping,
+                         simulationControl->get_number_subdivision(),
+                         DataOut<dim>::curved_inner_cells);
+
+  write_vtu_and_pvd<dim>(this->statistics_pvdhandler,
+                         data_out,
+                         simulationControl->get_output_path(),
+                         nsparam.post_processing.statistics_output_name,
+                         simulationControl->get_current_time(),
+                         simulationControl->get_step_number(),
+                         simulationControl->get_group_files(),
+                         this->mpi_communicator);
+}
+
+template <int dim, typename VectorType, typename DofsType>
+std::vector<VectorType>
+NavierStokesBase<dim, VectorType, DofsType>::ghosted_time_averaged_statistics()
+  const
+{
+  std::vector<VectorType> statistics(
+    3,
+    VectorType(locally_owned_dofs,
+               locally_relevant_dofs,
+               this->mpi_communicator));
+  if (averaging_time > 0)
     {
-      std::string filename = nsparam.forces_parameters.torque_output_name +
-                             "." + Utilities::int_to_string(boundary_id, 2) +
-                             ".dat";
-      std::ofstream output(filename.c_str());
+      statistics[0] = average_solution;
+      statistics[1] = average_squared_solution;
+      statistics[2] = average_velocity_products;
+    }
+  return statistics;
+}
 
-      this->torques_tables[boundary_id].write_text(output);
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::set_time_averaged_statistics(
+  const std::vector<VectorType> &statistics)
+{
+  if (statistics.empty())
+    return;
+
+  average_solution          = statistics[0];
+  average_squared_solution  = statistics[1];
+  average_velocity_products = statistics[2];
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::shift_velocity_components(
+  const VectorType &solution,
+  VectorType &      shifted_solution)
+{
+  // The dofs of the velocity components of a support point are owned by the
+  // same process and are found from the base element of the velocity
+  if (velocity_support_dofs_outdated)
+    {
+      velocity_support_dofs.clear();
+
+      const IndexSet &owned_dofs = this->dof_handler.locally_owned_dofs();
+      const unsigned int dofs_per_component =
+        this->fe.base_element(0).dofs_per_cell;
+      std::vector<types::global_dof_index> local_dof_indices(
+        this->fe.dofs_per_cell);
+
+      for (const auto &cell : this->dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            cell->get_dof_indices(local_dof_indices);
+            for (unsigned int i = 0; i < dofs_per_component; ++i)
+              {
+                std::array<types::global_dof_index, dim> support_dofs;
+                for (unsigned int d = 0; d < dim; ++d)
+                  support_dofs[d] =
+                    local_dof_indices[this->fe.component_to_system_index(d,
+                                                                         i)];
+                if (owned_dofs.is_element(support_dofs[0]))
+                  velocity_support_dofs.push_back(support_dofs);
+              }
+          }
+
+      std::sort(velocity_support_dofs.begin(), velocity_support_dofs.end());
+      velocity_support_dofs.erase(std::unique(velocity_support_dofs.begin(),
+                                              velocity_support_dofs.end()),
+                                  velocity_support_dofs.end());
+      velocity_support_dofs_outdated = false;
     }
+
+  shifted_solution.reinit(locally_owned_dofs, this->mpi_communicator);
+  for (const auto &support_dofs : velocity_support_dofs)
+    for (unsigned int d = 0; d < dim; ++d)
+      shifted_solution(support_dofs[d]) =
+        solution(support_dofs[(d + 1) % dim]);
+  shifted_solution.compress(VectorOperation::insert);
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::write_output_forces()
+{
+  TimerOutput::Scope t(this->computing_timer, "output_forces");
+  for (auto &table : forces_tables)
+    table.flush();
+}
+
+template <int dim, typename VectorType, typename DofsType>
+void
+NavierStokesBase<dim, VectorType, DofsType>::write_output_torques()
+{
+  TimerOutput::Scope t(this->computing_timer, "output_torques");
+  for (auto &table : torques_tables)
+    table.flush();
 }
 
 template <int dim, typename VectorType, typename DofsType>
@@ -1125,17 +2013,145 @@ void
 NavierStokesBase<dim, VectorType, DofsType>::write_checkpoint()
 {
   TimerOutput::Scope timer(this->computing_timer, "write_checkpoint");
-  std::string        prefix = this->nsparam.restart_parameters.filename;
-  if (Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
-    simulationControl->save(prefix);
-  if (Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
-    this->pvdhandler.save(prefix);
+
+  // The previous checkpoint is committed before its generation can be
+  // overwritten
+  if (output_writer)
+    output_writer->flush();
+
+  // The generation of the checkpoint is chosen by the first process, which
+  // maintains the list of the checkpoints
+  const std::string prefix = Utilities::MPI::all_gather(
+    this->mpi_communicator,
+    this_mpi_process == 0 ? checkpoint_control.next_prefix() :
+                            std::string())[0];
+
+  // Files of the checkpoint, which are validated by their checksums when the
+  // simulation is restarted
+  std::vector<std::string> checkpoint_suffixes = {
+    ".simulationcontrol",
+    ".pvdhandler",
+    ".xdmfhandler",
+    ".enstrophy.tablewriter",
+    ".kinetic_energy.tablewriter",
+    ".statistics",
+    ".statistics.pvdhandler",
+    ".triangulation",
+    ".triangulation.info",
+    ".triangulation_fixed.data",
+    ".triangulation_variable.data"};
+
+  // The small files of the checkpoint are built in memory. The first
+  // process calculates their checksums from their content and writes them,
+  // with the output writer if there is one, so that they are not read back
+  // when the checkpoint is committed. The tables are flushed by all the
+  // processes.
+  std::vector<std::pair<std::string, std::string>> files;
+  const auto save_in_memory =
+    [&](const std::string &                        suffix,
+        const std::function<void(std::ostream &)> &save) {
+      std::ostringstream output;
+      save(output);
+      if (this_mpi_process == 0)
+        files.emplace_back(suffix, output.str());
+    };
+
+  save_in_memory(".simulationcontrol", [&](std::ostream &output) {
+    simulationControl->save(output);
+  });
+  save_in_memory(".pvdhandler", [&](std::ostream &output) {
+    this->pvdhandler.save(output);
+  });
+  if (nsparam.simulation_control.output_format ==
+      Parameters::SimulationControl::OutputFormat::hdf5)
+    save_in_memory(".xdmfhandler", [&](std::ostream &output) {
+      this->xdmf_handler.save(output);
+    });
+
+  // The tables are flushed and the number of rows of their files is saved
+  if (nsparam.post_processing.calculate_enstrophy)
+    save_in_memory(".enstrophy.tablewriter", [&](std::ostream &output) {
+      this->enstrophy_table.save(output);
+    });
+  if (nsparam.post_processing.calculate_kinetic_energy)
+    save_in_memory(".kinetic_energy.tablewriter", [&](std::ostream &output) {
+      this->kinetic_energy_table.save(output);
+    });
+  for (unsigned int boundary_id = 0;
+       boundary_id < nsparam.boundary_conditions.size;
+       ++boundary_id)
+    {
+      const std::string suffix = Utilities::int_to_string(boundary_id, 2);
+      if (nsparam.forces_parameters.calculate_force)
+        save_in_memory(".force." + suffix + ".tablewriter",
+                       [&](std::ostream &output) {
+                         this->forces_tables[boundary_id].save(output);
+                       });
+      if (nsparam.forces_parameters.calculate_torque)
+        save_in_memory(".torque." + suffix + ".tablewriter",
+                       [&](std::ostream &output) {
+                         this->torques_tables[boundary_id].save(output);
+                       });
+      checkpoint_suffixes.push_back(".force." + suffix + ".tablewriter");
+      checkpoint_suffixes.push_back(".torque." + suffix + ".tablewriter");
+    }
+  const unsigned int n_probes = nsparam.probes.points.size() +
+                                nsparam.probes.lines.size() +
+                                nsparam.probes.planes.size();
+  for (unsigned int probe = 0; probe < n_probes; ++probe)
+    {
+      const std::string suffix =
+        ".probe." + Utilities::int_to_string(probe, 2) + ".tablewriter";
+      if (probes)
+        save_in_memory(suffix, [&](std::ostream &output) {
+          probes->save(probe, output);
+        });
+      checkpoint_suffixes.push_back(suffix);
+    }
 
   std::vector<const VectorType *> sol_set_transfer;
   sol_set_transfer.push_back(&this->present_solution);
   sol_set_transfer.push_back(&this->solution_m1);
   sol_set_transfer.push_back(&this->solution_m2);
   sol_set_transfer.push_back(&this->solution_m3);
+
+  // The time-averaged statistics are stored after the solution history and
+  // must be alive until the triangulation is saved
+  std::vector<VectorType> statistics;
+  if (nsparam.post_processing.calculate_time_averaged_statistics)
+    {
+      statistics = ghosted_time_averaged_statistics();
+      save_in_memory(".statistics.pvdhandler", [&](std::ostream &output) {
+        this->statistics_pvdhandler.save(output);
+      });
+      save_in_memory(".statistics", [&](std::ostream &output) {
+        output << std::setprecision(17) << "Averaging_time " << averaging_time
+               << std::endl;
+      });
+    }
+  else if (Utilities::MPI::this_mpi_process(this->mpi_communicator) == 0)
+    {
+      // The statistics of an older checkpoint with the same prefix would make
+      // this checkpoint appear to contain them when it is restarted
+      std::remove((prefix + ".statistics").c_str());
+      std::remove((prefix + ".statistics.pvdhandler").c_str());
+    }
+
+  std::map<std::string, CheckpointControl::FileChecksum> known_checksums;
+  for (auto &file : files)
+    {
+      known_checksums[file.first] = CheckpointControl::checksum(file.second);
+      if (output_writer)
+        output_writer->write(prefix + file.first, std::move(file.second));
+      else
+        {
+          std::ofstream output(prefix + file.first, std::ios::binary);
+          output << file.second;
+        }
+    }
+
+  for (const VectorType &statistic : statistics)
+    sol_set_transfer.push_back(&statistic);
   parallel::distributed::SolutionTransfer<dim, VectorType> system_trans_vectors(
     this->dof_handler);
   system_trans_vectors.prepare_for_serialization(sol_set_transfer);
@@ -1147,6 +2163,27 @@ NavierStokesBase<dim, VectorType, DofsType>::write_checkpoint()
       std::string triangulationName = prefix + ".triangulation";
       tria->save(prefix + ".triangulation");
     }
+
+  // The checkpoint is made the most recent one by the first process, once
+  // the triangulation has been saved by all the processes. The files of the
+  // triangulation are written by deal.II and are read back to calculate their
+  // checksums. With the asynchronous output, this is done by the background
+  // thread, after the small files are written, while the simulation
+  // continues.
+  if (this_mpi_process == 0)
+    {
+      if (output_writer)
+        output_writer->enqueue([control = checkpoint_control,
+                                prefix,
+                                checkpoint_suffixes,
+                                known_checksums]() {
+          control.commit(prefix, checkpoint_suffixes, known_checksums);
+        });
+      else
+        checkpoint_control.commit(prefix,
+                                  checkpoint_suffixes,
+                                  known_checksums);
+    }
 }
 
 
@@ -1160,3 +2197,9 @@ template class NavierStokesBase<2,
 template class NavierStokesBase<3,
                                 TrilinosWrappers::MPI::BlockVector,
                                 std::vector<IndexSet>>;
+template class NavierStokesBase<2,
+                                LinearAlgebra::distributed::Vector<double>,
+                                IndexSet>;
+template class NavierStokesBase<3,
+                                LinearAlgebra::distributed::Vector<double>,
+                                IndexSet>;
@@ -3,6 +3,7 @@
 
 // Lac
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
 // Dofs
@@ -117,3 +118,19 @@ calculate_CFL<3, TrilinosWrappers::MPI::BlockVector>(
   const Parameters::FEM &                   fem_parameters,
   const double                              time_step,
   const MPI_Comm &                          mpi_communicator);
+
+template double
+calculate_CFL<2, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<2> &                             dof_handler,
+  const LinearAlgebra::distributed::Vector<double> &evaluation_point,
+  const Parameters::FEM &                           fem_parameters,
+  const double                                      time_step,
+  const MPI_Comm &                                  mpi_communicator);
+
+template double
+calculate_CFL<3, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<3> &                             dof_handler,
+  const LinearAlgebra::distributed::Vector<double> &evaluation_point,
+  const Parameters::FEM &                           fem_parameters,
+  const double                                      time_step,
+  const MPI_Comm &                                  mpi_communicator);
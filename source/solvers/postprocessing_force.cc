@@ -3,6 +3,7 @@
 
 // Lac
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
 // Dofs
@@ -27,17 +28,48 @@
 
 using namespace dealii;
 
-// This is a primitive first implementation that could be greatly improved by
-// doing a single pass instead of N boundary passes
+template <int dim>
+BoundaryFaces<dim>
+gather_boundary_faces(
+  const DoFHandler<dim> &                            dof_handler,
+  const BoundaryConditions::BoundaryConditions<dim> &boundary_conditions)
+{
+  BoundaryFaces<dim> boundary_faces(boundary_conditions.size);
+
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      if (cell->is_locally_owned())
+        {
+          for (unsigned int face = 0; face < GeometryInfo<dim>::faces_per_cell;
+               face++)
+            {
+              if (cell->face(face)->at_boundary())
+                {
+                  const types::boundary_id boundary_id =
+                    cell->face(face)->boundary_id();
+                  for (unsigned int i_bc = 0; i_bc < boundary_conditions.size;
+                       ++i_bc)
+                    if (boundary_conditions.id[i_bc] == boundary_id)
+                      boundary_faces[i_bc].emplace_back(cell, face);
+                }
+            }
+        }
+    }
+  return boundary_faces;
+}
+
 template <int dim, typename VectorType>
-std::vector<Tensor<1, dim>>
-calculate_forces(
+void
+calculate_forces_and_torques(
   const DoFHandler<dim> &                              dof_handler,
+  const BoundaryFaces<dim> &                           boundary_faces,
   const VectorType &                                   evaluation_point,
   const Parameters::PhysicalProperties &               physical_properties,
   const Parameters::FEM &                              fem_parameters,
   const BoundaryConditions::NSBoundaryConditions<dim> &boundary_conditions,
-  const MPI_Comm &                                     mpi_communicator)
+  const MPI_Comm &                                     mpi_communicator,
+  std::vector<Tensor<1, dim>> &                        forces,
+  std::vector<Tensor<1, 3>> &                          torques)
 {
   const FiniteElement<dim> &fe = dof_handler.get_fe();
 
@@ -53,9 +85,6 @@ calculate_forces(
   Tensor<1, dim>                   normal_vector;
   Tensor<2, dim>                   fluid_stress;
   Tensor<2, dim>                   fluid_pressure;
-  Tensor<1, dim>                   force;
-
-  std::vector<Tensor<1, dim>> force_vector(boundary_conditions.size);
 
   FEFaceValues<dim> fe_face_values(mapping,
                                    fe,
@@ -64,50 +93,103 @@ calculate_forces(
                                      update_gradients | update_JxW_values |
                                      update_normal_vectors);
 
+  // The forces and the torques of all the boundaries are packed in a single
+  // vector so that they are reduced with one communication
+  const unsigned int  n_components = dim + 3;
+  std::vector<double> local_values(boundary_conditions.size * n_components,
+                                   0.);
+
   for (unsigned int i_bc = 0; i_bc < boundary_conditions.size; ++i_bc)
     {
-      unsigned int boundary_id = boundary_conditions.id[i_bc];
-      force                    = 0;
-      for (const auto &cell : dof_handler.active_cell_iterators())
+      Tensor<1, dim> force;
+      // torque tensor had to be considered in 3D at all time...
+      Tensor<1, 3> torque;
+      Point<dim>   center_of_rotation =
+        boundary_conditions.bcFunctions[i_bc].cor;
+
+      for (const auto &cell_and_face : boundary_faces[i_bc])
         {
-          if (cell->is_locally_owned())
+          fe_face_values.reinit(cell_and_face.first, cell_and_face.second);
+          const std::vector<Point<dim>> &q_points =
+            fe_face_values.get_quadrature_points();
+          fe_face_values[velocities].get_function_gradients(evaluation_point,
+                                                            velocity_gradients);
+          fe_face_values[pressure].get_function_values(evaluation_point,
+                                                       pressure_values);
+          for (unsigned int q = 0; q < n_q_points; q++)
             {
-              for (unsigned int face = 0;
-                   face < GeometryInfo<dim>::faces_per_cell;
-                   face++)
+              normal_vector = -fe_face_values.normal_vector(q);
+              for (int d = 0; d < dim; ++d)
+                {
+                  fluid_pressure[d][d] = pressure_values[q];
+                }
+              fluid_stress = viscosity * (velocity_gradients[q] +
+                                          transpose(velocity_gradients[q])) -
+                             fluid_pressure;
+              const Tensor<1, dim> face_force =
+                fluid_stress * normal_vector * fe_face_values.JxW(q);
+              force += face_force;
+
+              const Tensor<1, dim> distance = q_points[q] - center_of_rotation;
+              if (dim == 2)
+                {
+                  torque[2] += distance[0] * face_force[1] -
+                               distance[1] * face_force[0];
+                }
+              else if (dim == 3)
                 {
-                  if (cell->face(face)->at_boundary())
-                    {
-                      fe_face_values.reinit(cell, face);
-                      if (cell->face(face)->boundary_id() == boundary_id)
-                        {
-                          std::vector<Point<dim>> q_points =
-                            fe_face_values.get_quadrature_points();
-                          fe_face_values[velocities].get_function_gradients(
-                            evaluation_point, velocity_gradients);
-                          fe_face_values[pressure].get_function_values(
-                            evaluation_point, pressure_values);
-                          for (unsigned int q = 0; q < n_q_points; q++)
-                            {
-                              normal_vector = -fe_face_values.normal_vector(q);
-                              for (int d = 0; d < dim; ++d)
-                                {
-                                  fluid_pressure[d][d] = pressure_values[q];
-                                }
-                              fluid_stress =
-                                viscosity * (velocity_gradients[q] +
-                                             transpose(velocity_gradients[q])) -
-                                fluid_pressure;
-                              force += fluid_stress * normal_vector *
-                                       fe_face_values.JxW(q);
-                            }
-                        }
-                    }
+                  torque[0] += distance[1] * face_force[2] -
+                               distance[2] * face_force[1];
+                  torque[1] += distance[2] * face_force[0] -
+                               distance[0] * face_force[2];
+                  torque[2] += distance[0] * face_force[1] -
+                               distance[1] * face_force[0];
                 }
             }
         }
-      force_vector[i_bc] = Utilities::MPI::sum(force, mpi_communicator);
+
+      for (unsigned int d = 0; d < dim; ++d)
+        local_values[i_bc * n_components + d] = force[d];
+      for (unsigned int d = 0; d < 3; ++d)
+        local_values[i_bc * n_components + dim + d] = torque[d];
+    }
+
+  std::vector<double> values(local_values.size());
+  Utilities::MPI::sum(local_values, mpi_communicator, values);
+
+  forces.resize(boundary_conditions.size);
+  torques.resize(boundary_conditions.size);
+  for (unsigned int i_bc = 0; i_bc < boundary_conditions.size; ++i_bc)
+    {
+      for (unsigned int d = 0; d < dim; ++d)
+        forces[i_bc][d] = values[i_bc * n_components + d];
+      for (unsigned int d = 0; d < 3; ++d)
+        torques[i_bc][d] = values[i_bc * n_components + dim + d];
     }
+}
+
+template <int dim, typename VectorType>
+std::vector<Tensor<1, dim>>
+calculate_forces(
+  const DoFHandler<dim> &                              dof_handler,
+  const VectorType &                                   evaluation_point,
+  const Parameters::PhysicalProperties &               physical_properties,
+  const Parameters::FEM &                              fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<dim> &boundary_conditions,
+  const MPI_Comm &                                     mpi_communicator)
+{
+  std::vector<Tensor<1, dim>> force_vector;
+  std::vector<Tensor<1, 3>>   torque_vector;
+  calculate_forces_and_torques(
+    dof_handler,
+    gather_boundary_faces(dof_handler, boundary_conditions),
+    evaluation_point,
+    physical_properties,
+    fem_parameters,
+    boundary_conditions,
+    mpi_communicator,
+    force_vector,
+    torque_vector);
   return force_vector;
 }
 
@@ -145,3 +227,102 @@ calculate_forces<3, TrilinosWrappers::MPI::BlockVector>(
   const Parameters::FEM &                            fem_parameters,
   const BoundaryConditions::NSBoundaryConditions<3> &boundary_conditions,
   const MPI_Comm &                                   mpi_communicator);
+
+template std::vector<Tensor<1, 2>>
+calculate_forces<2, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<2> &                              dof_handler,
+  const LinearAlgebra::distributed::Vector<double> & evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<2> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator);
+
+template std::vector<Tensor<1, 3>>
+calculate_forces<3, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<3> &                              dof_handler,
+  const LinearAlgebra::distributed::Vector<double> & evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<3> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator);
+
+template BoundaryFaces<2>
+gather_boundary_faces<2>(
+  const DoFHandler<2> &                            dof_handler,
+  const BoundaryConditions::BoundaryConditions<2> &boundary_conditions);
+template BoundaryFaces<3>
+gather_boundary_faces<3>(
+  const DoFHandler<3> &                            dof_handler,
+  const BoundaryConditions::BoundaryConditions<3> &boundary_conditions);
+
+template void
+calculate_forces_and_torques<2, TrilinosWrappers::MPI::Vector>(
+  const DoFHandler<2> &                              dof_handler,
+  const BoundaryFaces<2> &                           boundary_faces,
+  const TrilinosWrappers::MPI::Vector &              evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<2> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator,
+  std::vector<Tensor<1, 2>> &                        forces,
+  std::vector<Tensor<1, 3>> &                        torques);
+
+template void
+calculate_forces_and_torques<3, TrilinosWrappers::MPI::Vector>(
+  const DoFHandler<3> &                              dof_handler,
+  const BoundaryFaces<3> &                           boundary_faces,
+  const TrilinosWrappers::MPI::Vector &              evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<3> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator,
+  std::vector<Tensor<1, 3>> &                        forces,
+  std::vector<Tensor<1, 3>> &                        torques);
+
+template void
+calculate_forces_and_torques<2, TrilinosWrappers::MPI::BlockVector>(
+  const DoFHandler<2> &                              dof_handler,
+  const BoundaryFaces<2> &                           boundary_faces,
+  const TrilinosWrappers::MPI::BlockVector &         evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<2> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator,
+  std::vector<Tensor<1, 2>> &                        forces,
+  std::vector<Tensor<1, 3>> &                        torques);
+
+template void
+calculate_forces_and_torques<3, TrilinosWrappers::MPI::BlockVector>(
+  const DoFHandler<3> &                              dof_handler,
+  const BoundaryFaces<3> &                           boundary_faces,
+  const TrilinosWrappers::MPI::BlockVector &         evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<3> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator,
+  std::vector<Tensor<1, 3>> &                        forces,
+  std::vector<Tensor<1, 3>> &                        torques);
+
+template void
+calculate_forces_and_torques<2, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<2> &                              dof_handler,
+  const BoundaryFaces<2> &                           boundary_faces,
+  const LinearAlgebra::distributed::Vector<double> & evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<2> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator,
+  std::vector<Tensor<1, 2>> &                        forces,
+  std::vector<Tensor<1, 3>> &                        torques);
+
+template void
+calculate_forces_and_torques<3, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<3> &                              dof_handler,
+  const BoundaryFaces<3> &                           boundary_faces,
+  const LinearAlgebra::distributed::Vector<double> & evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<3> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator,
+  std::vector<Tensor<1, 3>> &                        forces,
+  std::vector<Tensor<1, 3>> &                        torques);
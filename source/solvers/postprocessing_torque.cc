@@ -3,6 +3,7 @@
 
 // Lac
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
 // Dofs
@@ -21,13 +22,12 @@
 
 // Lethe includes
 #include <core/parameters.h>
+#include <solvers/postprocessing_force.h>
 #include <solvers/postprocessing_torque.h>
 
 
 using namespace dealii;
 
-// This is a primitive first implementation that could be greatly improved by
-// doing a single pass instead of N boundary passes
 template <int dim, typename VectorType>
 std::vector<Tensor<1, 3>>
 calculate_torques(
@@ -38,96 +38,18 @@ calculate_torques(
   const BoundaryConditions::NSBoundaryConditions<dim> &boundary_conditions,
   const MPI_Comm &                                     mpi_communicator)
 {
-  const FiniteElement<dim> &fe = dof_handler.get_fe();
-
-  double viscosity = physical_properties.viscosity;
-
-  QGauss<dim - 1>     face_quadrature_formula(fe.degree + 1);
-  const MappingQ<dim> mapping(fe.degree, fem_parameters.qmapping_all);
-  const unsigned int  n_q_points = face_quadrature_formula.size();
-  const FEValuesExtractors::Vector velocities(0);
-  const FEValuesExtractors::Scalar pressure(dim);
-  std::vector<double>              pressure_values(n_q_points);
-  std::vector<Tensor<2, dim>>      velocity_gradients(n_q_points);
-  Tensor<1, dim>                   normal_vector;
-  Tensor<2, dim>                   fluid_stress;
-  Tensor<2, dim>                   fluid_pressure;
-  // torque tensor had to be considered in 3D at all time...
-  Tensor<1, 3> torque;
-
-  std::vector<Tensor<1, 3>> torque_vector(boundary_conditions.size);
-
-  FEFaceValues<dim> fe_face_values(mapping,
-                                   fe,
-                                   face_quadrature_formula,
-                                   update_values | update_quadrature_points |
-                                     update_gradients | update_JxW_values |
-                                     update_normal_vectors);
-
-  for (unsigned int i_bc = 0; i_bc < boundary_conditions.size; ++i_bc)
-    {
-      unsigned int boundary_id = boundary_conditions.id[i_bc];
-      torque                   = 0;
-      Point<dim> center_of_rotation =
-        boundary_conditions.bcFunctions[boundary_id].cor;
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        {
-          if (cell->is_locally_owned())
-            {
-              for (unsigned int face = 0;
-                   face < GeometryInfo<dim>::faces_per_cell;
-                   face++)
-                {
-                  if (cell->face(face)->at_boundary())
-                    {
-                      fe_face_values.reinit(cell, face);
-                      if (cell->face(face)->boundary_id() == boundary_id)
-                        {
-                          std::vector<Point<dim>> q_points =
-                            fe_face_values.get_quadrature_points();
-                          fe_face_values[velocities].get_function_gradients(
-                            evaluation_point, velocity_gradients);
-                          fe_face_values[pressure].get_function_values(
-                            evaluation_point, pressure_values);
-                          for (unsigned int q = 0; q < n_q_points; q++)
-                            {
-                              normal_vector = -fe_face_values.normal_vector(q);
-                              for (int d = 0; d < dim; ++d)
-                                {
-                                  fluid_pressure[d][d] = pressure_values[q];
-                                }
-                              fluid_stress =
-                                viscosity * (velocity_gradients[q] +
-                                             transpose(velocity_gradients[q])) -
-                                fluid_pressure;
-                              auto force = fluid_stress * normal_vector *
-                                           fe_face_values.JxW(q);
-
-                              auto distance = q_points[q] - center_of_rotation;
-                              if (dim == 2)
-                                {
-                                  torque[0] = 0.;
-                                  torque[1] = 0.;
-                                  torque[2] += distance[0] * force[1] -
-                                               distance[1] * force[0];
-                                }
-                              else if (dim == 3)
-                                {
-                                  torque[0] += distance[1] * force[2] -
-                                               distance[2] * force[1];
-                                  torque[1] += distance[2] * force[0] -
-                                               distance[0] * force[2];
-                                  torque[2] += distance[0] * force[1] -
-                                               distance[1] * force[0];
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-      torque_vector[i_bc] = Utilities::MPI::sum(torque, mpi_communicator);
-    }
+  std::vector<Tensor<1, dim>> force_vector;
+  std::vector<Tensor<1, 3>>   torque_vector;
+  calculate_forces_and_torques(
+    dof_handler,
+    gather_boundary_faces(dof_handler, boundary_conditions),
+    evaluation_point,
+    physical_properties,
+    fem_parameters,
+    boundary_conditions,
+    mpi_communicator,
+    force_vector,
+    torque_vector);
   return torque_vector;
 }
 
@@ -165,3 +87,21 @@ calculate_torques<3, TrilinosWrappers::MPI::BlockVector>(
   const Parameters::FEM &                            fem_parameters,
   const BoundaryConditions::NSBoundaryConditions<3> &boundary_conditions,
   const MPI_Comm &                                   mpi_communicator);
+
+template std::vector<Tensor<1, 3>>
+calculate_torques<2, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<2> &                              dof_handler,
+  const LinearAlgebra::distributed::Vector<double> & evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<2> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator);
+
+template std::vector<Tensor<1, 3>>
+calculate_torques<3, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<3> &                              dof_handler,
+  const LinearAlgebra::distributed::Vector<double> & evaluation_point,
+  const Parameters::PhysicalProperties &             physical_properties,
+  const Parameters::FEM &                            fem_parameters,
+  const BoundaryConditions::NSBoundaryConditions<3> &boundary_conditions,
+  const MPI_Comm &                                   mpi_communicator);
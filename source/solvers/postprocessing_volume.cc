@@ -0,0 +1,299 @@
+// Base
+#include <deal.II/base/quadrature_lib.h>
+
+// Lac
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+// Dofs
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+// Lac - Trilinos includes
+#include <deal.II/lac/trilinos_parallel_block_vector.h>
+#include <deal.II/lac/trilinos_vector.h>
+
+// Fe
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+// Lethe includes
+#include <core/parameters.h>
+#include <solvers/postprocessing_volume.h>
+
+
+using namespace dealii;
+
+template <int dim, typename VectorType>
+VolumeQuantities
+calculate_volume_quantities(const DoFHandler<dim> &dof_handler,
+                            const VectorType &     evaluation_point,
+                            const Parameters::FEM &fem_parameters,
+                            const bool             calculate_cfl,
+                            const double           time_step,
+                            const bool             calculate_kinetic_energy,
+                            const bool             calculate_enstrophy,
+                            const Function<dim> *  exact_solution,
+                            const unsigned int     error_quadrature_points,
+                            const MPI_Comm &       mpi_communicator)
+{
+  const FiniteElement<dim> &fe = dof_handler.get_fe();
+  const MappingQ<dim>       mapping(fe.degree, fem_parameters.qmapping_all);
+  const FEValuesExtractors::Vector velocities(0);
+  const FEValuesExtractors::Scalar pressure(dim);
+
+  const bool calculate_error = exact_solution != nullptr;
+
+  // The CFL is evaluated at the center of the cells
+  QGauss<dim>   cfl_quadrature_formula(1);
+  FEValues<dim> cfl_fe_values(mapping,
+                              fe,
+                              cfl_quadrature_formula,
+                              update_values);
+  std::vector<Tensor<1, dim>> cfl_velocity_values(1);
+  const double                degree = double(fe.degree);
+
+  // Kinetic energy and enstrophy
+  QGauss<dim>   energy_quadrature_formula(fe.degree + 1);
+  FEValues<dim> energy_fe_values(mapping,
+                                 fe,
+                                 energy_quadrature_formula,
+                                 update_values | update_gradients |
+                                   update_JxW_values);
+  const unsigned int n_energy_q_points = energy_quadrature_formula.size();
+  std::vector<Tensor<1, dim>> energy_velocity_values(n_energy_q_points);
+  std::vector<Tensor<2, dim>> energy_velocity_gradients(n_energy_q_points);
+
+  // L2 error
+  QGauss<dim>   error_quadrature_formula(error_quadrature_points);
+  FEValues<dim> error_fe_values(mapping,
+                                fe,
+                                error_quadrature_formula,
+                                update_values | update_quadrature_points |
+                                  update_JxW_values);
+  const unsigned int n_error_q_points = error_quadrature_formula.size();
+  std::vector<Tensor<1, dim>> error_velocity_values(n_error_q_points);
+  std::vector<double>         error_pressure_values(n_error_q_points);
+  std::vector<Vector<double>> exact_values(n_error_q_points,
+                                           Vector<double>(dim + 1));
+
+  // The pressure is only defined up to a constant and its error is calculated
+  // once the average pressures are known. The pressure differences and their
+  // weights are stored so that the cells are not evaluated a second time.
+  std::vector<double> pressure_differences;
+  std::vector<double> pressure_weights;
+
+  // Position of the sums in the vector reduced over the processes
+  const unsigned int kinetic_energy_index          = 0;
+  const unsigned int enstrophy_index               = 1;
+  const unsigned int pressure_integral_index       = 2;
+  const unsigned int exact_pressure_integral_index = 3;
+  const unsigned int l2_error_velocity_index       = 4;
+  const unsigned int volume_index                  = 5;
+
+  std::vector<double> local_sums(6, 0.);
+
+  double cfl = 0;
+
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      if (cell->is_locally_owned())
+        {
+          local_sums[volume_index] += cell->measure();
+
+          if (calculate_cfl)
+            {
+              double h;
+              if (dim == 2)
+                h = std::sqrt(4. * cell->measure() / M_PI) / degree;
+              else
+                h = pow(6 * cell->measure() / M_PI, 1. / 3.) / degree;
+              cfl_fe_values.reinit(cell);
+              cfl_fe_values[velocities].get_function_values(
+                evaluation_point, cfl_velocity_values);
+              cfl = std::max(cfl,
+                             cfl_velocity_values[0].norm() / h * time_step);
+            }
+
+          if (calculate_kinetic_energy || calculate_enstrophy)
+            {
+              energy_fe_values.reinit(cell);
+              if (calculate_kinetic_energy)
+                energy_fe_values[velocities].get_function_values(
+                  evaluation_point, energy_velocity_values);
+              if (calculate_enstrophy)
+                energy_fe_values[velocities].get_function_gradients(
+                  evaluation_point, energy_velocity_gradients);
+
+              for (unsigned int q = 0; q < n_energy_q_points; q++)
+                {
+                  const double JxW = energy_fe_values.JxW(q);
+                  if (calculate_kinetic_energy)
+                    local_sums[kinetic_energy_index] +=
+                      0.5 * energy_velocity_values[q].norm_square() * JxW;
+
+                  if (calculate_enstrophy)
+                    {
+                      const Tensor<2, dim> &gradient =
+                        energy_velocity_gradients[q];
+                      double vorticity_squared =
+                        (gradient[1][0] - gradient[0][1]) *
+                        (gradient[1][0] - gradient[0][1]);
+                      if (dim == 3)
+                        {
+                          vorticity_squared +=
+                            (gradient[2][1] - gradient[1][2]) *
+                            (gradient[2][1] - gradient[1][2]);
+                          vorticity_squared +=
+                            (gradient[0][2] - gradient[2][0]) *
+                            (gradient[0][2] - gradient[2][0]);
+                        }
+                      local_sums[enstrophy_index] +=
+                        0.5 * vorticity_squared * JxW;
+                    }
+                }
+            }
+
+          if (calculate_error)
+            {
+              error_fe_values.reinit(cell);
+              error_fe_values[velocities].get_function_values(
+                evaluation_point, error_velocity_values);
+              error_fe_values[pressure].get_function_values(
+                evaluation_point, error_pressure_values);
+              exact_solution->vector_value_list(
+                error_fe_values.get_quadrature_points(), exact_values);
+
+              for (unsigned int q = 0; q < n_error_q_points; q++)
+                {
+                  const double JxW = error_fe_values.JxW(q);
+                  for (unsigned int d = 0; d < dim; ++d)
+                    {
+                      const double difference =
+                        error_velocity_values[q][d] - exact_values[q][d];
+                      local_sums[l2_error_velocity_index] +=
+                        difference * difference * JxW;
+                    }
+
+                  local_sums[pressure_integral_index] +=
+                    error_pressure_values[q] * JxW;
+                  local_sums[exact_pressure_integral_index] +=
+                    exact_values[q][dim] * JxW;
+                  pressure_differences.push_back(error_pressure_values[q] -
+                                                 exact_values[q][dim]);
+                  pressure_weights.push_back(JxW);
+                }
+            }
+        }
+    }
+
+  std::vector<double> sums(local_sums.size());
+  Utilities::MPI::sum(local_sums, mpi_communicator, sums);
+
+  VolumeQuantities quantities;
+  const double     volume = sums[volume_index];
+  if (calculate_cfl)
+    quantities.cfl = Utilities::MPI::max(cfl, mpi_communicator);
+  quantities.kinetic_energy = sums[kinetic_energy_index] / volume;
+  quantities.enstrophy      = sums[enstrophy_index] / volume;
+
+  if (calculate_error)
+    {
+      const double average_difference = (sums[pressure_integral_index] -
+                                         sums[exact_pressure_integral_index]) /
+                                        volume;
+      double l2_error_pressure = 0;
+      for (unsigned int i = 0; i < pressure_differences.size(); ++i)
+        l2_error_pressure += (pressure_differences[i] - average_difference) *
+                             (pressure_differences[i] - average_difference) *
+                             pressure_weights[i];
+      l2_error_pressure =
+        Utilities::MPI::sum(l2_error_pressure, mpi_communicator);
+
+      quantities.l2_error_velocity =
+        std::sqrt(sums[l2_error_velocity_index]);
+      quantities.l2_error_pressure = std::sqrt(l2_error_pressure);
+    }
+
+  return quantities;
+}
+
+template VolumeQuantities
+calculate_volume_quantities<2, TrilinosWrappers::MPI::Vector>(
+  const DoFHandler<2> &                 dof_handler,
+  const TrilinosWrappers::MPI::Vector &evaluation_point,
+  const Parameters::FEM &               fem_parameters,
+  const bool                            calculate_cfl,
+  const double                          time_step,
+  const bool                            calculate_kinetic_energy,
+  const bool                            calculate_enstrophy,
+  const Function<2> *                   exact_solution,
+  const unsigned int                    error_quadrature_points,
+  const MPI_Comm &                      mpi_communicator);
+
+template VolumeQuantities
+calculate_volume_quantities<3, TrilinosWrappers::MPI::Vector>(
+  const DoFHandler<3> &                 dof_handler,
+  const TrilinosWrappers::MPI::Vector &evaluation_point,
+  const Parameters::FEM &               fem_parameters,
+  const bool                            calculate_cfl,
+  const double                          time_step,
+  const bool                            calculate_kinetic_energy,
+  const bool                            calculate_enstrophy,
+  const Function<3> *                   exact_solution,
+  const unsigned int                    error_quadrature_points,
+  const MPI_Comm &                      mpi_communicator);
+
+template VolumeQuantities
+calculate_volume_quantities<2, TrilinosWrappers::MPI::BlockVector>(
+  const DoFHandler<2> &                      dof_handler,
+  const TrilinosWrappers::MPI::BlockVector &evaluation_point,
+  const Parameters::FEM &                    fem_parameters,
+  const bool                                 calculate_cfl,
+  const double                               time_step,
+  const bool                                 calculate_kinetic_energy,
+  const bool                                 calculate_enstrophy,
+  const Function<2> *                        exact_solution,
+  const unsigned int                         error_quadrature_points,
+  const MPI_Comm &                           mpi_communicator);
+
+template VolumeQuantities
+calculate_volume_quantities<3, TrilinosWrappers::MPI::BlockVector>(
+  const DoFHandler<3> &                      dof_handler,
+  const TrilinosWrappers::MPI::BlockVector &evaluation_point,
+  const Parameters::FEM &                    fem_parameters,
+  const bool                                 calculate_cfl,
+  const double                               time_step,
+  const bool                                 calculate_kinetic_energy,
+  const bool                                 calculate_enstrophy,
+  const Function<3> *                        exact_solution,
+  const unsigned int                         error_quadrature_points,
+  const MPI_Comm &                           mpi_communicator);
+
+template VolumeQuantities
+calculate_volume_quantities<2, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<2> &                              dof_handler,
+  const LinearAlgebra::distributed::Vector<double> &evaluation_point,
+  const Parameters::FEM &                            fem_parameters,
+  const bool                                         calculate_cfl,
+  const double                                       time_step,
+  const bool                                         calculate_kinetic_energy,
+  const bool                                         calculate_enstrophy,
+  const Function<2> *                                exact_solution,
+  const unsigned int                                 error_quadrature_points,
+  const MPI_Comm &                                   mpi_communicator);
+
+template VolumeQuantities
+calculate_volume_quantities<3, LinearAlgebra::distributed::Vector<double>>(
+  const DoFHandler<3> &                              dof_handler,
+  const LinearAlgebra::distributed::Vector<double> &evaluation_point,
+  const Parameters::FEM &                            fem_parameters,
+  const bool                                         calculate_cfl,
+  const double                                       time_step,
+  const bool                                         calculate_kinetic_energy,
+  const bool                                         calculate_enstrophy,
+  const Function<3> *                                exact_solution,
+  const unsigned int                                 error_quadrature_points,
+  const MPI_Comm &                                   mpi_communicator);
@@ -0,0 +1,315 @@
+// Base
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+// Grid
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+// Lac
+#include <deal.II/lac/la_parallel_vector.h>
+
+// Lac - Trilinos includes
+#include <deal.II/lac/trilinos_parallel_block_vector.h>
+#include <deal.II/lac/trilinos_vector.h>
+
+// Fe
+#include <deal.II/fe/fe_system.h>
+
+// Lethe includes
+#include <solvers/probes.h>
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+
+template <int dim, typename VectorType>
+Probes<dim, VectorType>::Probes(const Parameters::Probes &parameters,
+                                const DoFHandler<dim> &   dof_handler,
+                                const unsigned int        velocity_fem_degree,
+                                const Parameters::FEM &   fem_parameters,
+                                const MPI_Comm &          mpi_communicator)
+  : dof_handler(dof_handler)
+  , mapping(velocity_fem_degree, fem_parameters.qmapping_all)
+  , mpi_communicator(mpi_communicator)
+  , this_mpi_process(Utilities::MPI::this_mpi_process(mpi_communicator))
+  , samples_outdated(true)
+{
+  auto to_point = [](const std::vector<double> &values,
+                     const unsigned int         first) {
+    Point<dim> point;
+    for (unsigned int d = 0; d < dim; ++d)
+      point[d] = values[first + d];
+    return point;
+  };
+
+  auto to_number_of_samples = [](const double value) {
+    if (value < 2 || value != std::floor(value))
+      throw(std::runtime_error(
+        "Error, the number of samples of the lines and planes of the probes "
+        "must be an integer larger than one"));
+    return static_cast<unsigned int>(value);
+  };
+
+  for (const auto &point : parameters.points)
+    {
+      if (point.size() != dim)
+        throw(std::runtime_error(
+          "Error, the points of the probes must have one coordinate per "
+          "dimension"));
+      probe_first_sample.push_back(sample_points.size());
+      sample_points.push_back(to_point(point, 0));
+    }
+
+  for (const auto &line : parameters.lines)
+    {
+      if (line.size() != 2 * dim + 1)
+        throw(std::runtime_error(
+          "Error, the lines of the probes must be described by their start "
+          "and end points and their number of samples"));
+      const Point<dim>   start     = to_point(line, 0);
+      const Point<dim>   end       = to_point(line, dim);
+      const unsigned int n_samples = to_number_of_samples(line[2 * dim]);
+
+      probe_first_sample.push_back(sample_points.size());
+      for (unsigned int i = 0; i < n_samples; ++i)
+        sample_points.push_back(start + (end - start) * (i / (n_samples - 1.)));
+    }
+
+  for (const auto &plane : parameters.planes)
+    {
+      if (plane.size() != 3 * dim + 2)
+        throw(std::runtime_error(
+          "Error, the planes of the probes must be described by their origin, "
+          "their two edge vectors and their number of samples along each "
+          "edge"));
+      const Point<dim>     origin      = to_point(plane, 0);
+      const Tensor<1, dim> first_edge  = to_point(plane, dim);
+      const Tensor<1, dim> second_edge = to_point(plane, 2 * dim);
+
+      const unsigned int n_first  = to_number_of_samples(plane[3 * dim]);
+      const unsigned int n_second = to_number_of_samples(plane[3 * dim + 1]);
+
+      probe_first_sample.push_back(sample_points.size());
+      for (unsigned int j = 0; j < n_second; ++j)
+        for (unsigned int i = 0; i < n_first; ++i)
+          sample_points.push_back(origin +
+                                  first_edge * (i / (n_first - 1.)) +
+                                  second_edge * (j / (n_second - 1.)));
+    }
+
+  const unsigned int n_probes = probe_first_sample.size();
+  probe_first_sample.push_back(sample_points.size());
+
+  // Each probe has its own time series and file of sample coordinates
+  const std::vector<std::string> component_names = {"u", "v", "w"};
+  for (unsigned int probe = 0; probe < n_probes; ++probe)
+    {
+      const std::string prefix = parameters.output_name + "." +
+                                 Utilities::int_to_string(probe, 2);
+
+      std::vector<std::string> column_names = {"time"};
+      for (unsigned int s = probe_first_sample[probe];
+           s < probe_first_sample[probe + 1];
+           ++s)
+        {
+          const std::string suffix =
+            "_" + Utilities::int_to_string(s - probe_first_sample[probe]);
+          for (unsigned int d = 0; d < dim; ++d)
+            column_names.push_back(component_names[d] + suffix);
+          column_names.push_back("p" + suffix);
+        }
+
+      tables.emplace_back(prefix + ".dat",
+                          column_names,
+                          parameters.precision,
+                          this_mpi_process == 0);
+
+      if (this_mpi_process == 0)
+        {
+          std::ofstream output((prefix + ".coordinates.dat").c_str());
+          output << "sample x y" << (dim == 3 ? " z" : "") << std::endl;
+          for (unsigned int s = probe_first_sample[probe];
+               s < probe_first_sample[probe + 1];
+               ++s)
+            output << s - probe_first_sample[probe] << " "
+                   << sample_points[s] << std::endl;
+        }
+    }
+
+  // The samples are located again after any change of the triangulation
+  triangulation_connection =
+    dof_handler.get_triangulation().signals.any_change.connect(
+      [this]() { this->samples_outdated = true; });
+}
+
+template <int dim, typename VectorType>
+Probes<dim, VectorType>::~Probes()
+{
+  triangulation_connection.disconnect();
+}
+
+template <int dim, typename VectorType>
+void
+Probes<dim, VectorType>::locate_samples()
+{
+  const Triangulation<dim> &  triangulation = dof_handler.get_triangulation();
+  const FiniteElement<dim> &  fe            = dof_handler.get_fe();
+  const GridTools::Cache<dim> cache(triangulation, mapping);
+  const unsigned int          n_processes =
+    Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+  // The sample is owned by the process of lowest rank which finds it in one of
+  // its locally owned cells, since a sample on the interface between two
+  // processes can be found by both of them
+  std::vector<unsigned int> local_owners(sample_points.size(), n_processes);
+  std::vector<std::pair<typename Triangulation<dim>::active_cell_iterator,
+                        Point<dim>>>
+    cells_and_reference_points(sample_points.size());
+
+  // The consecutive samples of the lines and planes are close to each other.
+  // The cell of the previous sample is used as a hint for the search.
+  typename Triangulation<dim>::active_cell_iterator hint =
+    triangulation.begin_active();
+  for (unsigned int s = 0; s < sample_points.size(); ++s)
+    {
+      try
+        {
+          const auto cell_and_reference_point =
+            GridTools::find_active_cell_around_point(cache,
+                                                     sample_points[s],
+                                                     hint);
+          const auto &cell = cell_and_reference_point.first;
+          if (cell.state() == IteratorState::valid)
+            {
+              hint = cell;
+              if (cell->is_locally_owned())
+                {
+                  local_owners[s]               = this_mpi_process;
+                  cells_and_reference_points[s] = cell_and_reference_point;
+                }
+            }
+        }
+      catch (...)
+        {
+          // The sample is not in the part of the domain known by this process
+        }
+    }
+
+  std::vector<unsigned int> owners(sample_points.size());
+  Utilities::MPI::min(local_owners, mpi_communicator, owners);
+
+  located_samples.clear();
+  sample_found.resize(sample_points.size());
+  for (unsigned int s = 0; s < sample_points.size(); ++s)
+    {
+      sample_found[s] = owners[s] < n_processes;
+      if (owners[s] != this_mpi_process)
+        continue;
+
+      const auto &  tria_cell = cells_and_reference_points[s].first;
+      LocatedSample located_sample;
+      located_sample.sample = s;
+      located_sample.cell =
+        typename DoFHandler<dim>::active_cell_iterator(&triangulation,
+                                                       tria_cell->level(),
+                                                       tria_cell->index(),
+                                                       &dof_handler);
+      located_sample.shape_values.resize(fe.dofs_per_cell);
+      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        located_sample.shape_values[i] =
+          fe.shape_value(i, cells_and_reference_points[s].second);
+      located_samples.push_back(located_sample);
+    }
+
+  samples_outdated = false;
+}
+
+template <int dim, typename VectorType>
+void
+Probes<dim, VectorType>::sample(const VectorType &solution, const double time)
+{
+  if (samples_outdated)
+    locate_samples();
+
+  const FiniteElement<dim> &fe           = dof_handler.get_fe();
+  const unsigned int        n_components = dim + 1;
+  const unsigned int        n_values     = sample_points.size() * n_components;
+
+  std::vector<double>                  local_values(n_values, 0.);
+  std::vector<types::global_dof_index> local_dof_indices(fe.dofs_per_cell);
+
+  for (const auto &located_sample : located_samples)
+    {
+      located_sample.cell->get_dof_indices(local_dof_indices);
+      double *values = &local_values[located_sample.sample * n_components];
+      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        values[fe.system_to_component_index(i).first] +=
+          solution(local_dof_indices[i]) * located_sample.shape_values[i];
+    }
+
+  // The values are only needed by the first process, which writes them
+  std::vector<double> values(n_values, 0.);
+  MPI_Reduce(local_values.data(),
+             values.data(),
+             n_values,
+             MPI_DOUBLE,
+             MPI_SUM,
+             0,
+             mpi_communicator);
+
+  if (this_mpi_process != 0)
+    return;
+
+  for (unsigned int probe = 0; probe < tables.size(); ++probe)
+    {
+      std::vector<double> row = {time};
+      for (unsigned int s = probe_first_sample[probe];
+           s < probe_first_sample[probe + 1];
+           ++s)
+        for (unsigned int c = 0; c < n_components; ++c)
+          row.push_back(sample_found[s] ?
+                          values[s * n_components + c] :
+                          std::numeric_limits<double>::quiet_NaN());
+      tables[probe].add_row(row);
+    }
+}
+
+template <int dim, typename VectorType>
+void
+Probes<dim, VectorType>::flush()
+{
+  for (auto &table : tables)
+    table.flush();
+}
+
+template <int dim, typename VectorType>
+void
+Probes<dim, VectorType>::save(const std::string &prefix)
+{
+  for (unsigned int probe = 0; probe < tables.size(); ++probe)
+    tables[probe].save(prefix + ".probe." + Utilities::int_to_string(probe, 2));
+}
+
+template <int dim, typename VectorType>
+void
+Probes<dim, VectorType>::save(const unsigned int probe, std::ostream &output)
+{
+  tables[probe].save(output);
+}
+
+template <int dim, typename VectorType>
+void
+Probes<dim, VectorType>::read(const std::string &prefix)
+{
+  for (unsigned int probe = 0; probe < tables.size(); ++probe)
+    tables[probe].read(prefix + ".probe." + Utilities::int_to_string(probe, 2));
+}
+
+template class Probes<2, TrilinosWrappers::MPI::Vector>;
+template class Probes<3, TrilinosWrappers::MPI::Vector>;
+template class Probes<2, TrilinosWrappers::MPI::BlockVector>;
+template class Probes<3, TrilinosWrappers::MPI::BlockVector>;
+template class Probes<2, LinearAlgebra::distributed::Vector<double>>;
+template class Probes<3, LinearAlgebra::distributed::Vector<double>>;
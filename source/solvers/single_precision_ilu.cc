@@ -0,0 +1,137 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 2019 - 2020 by the Lethe authors
+ *
+ * This file is part of the Lethe library
+ *
+ * The Lethe library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE at
+ * the top level of the Lethe distribution.
+ *
+ * ---------------------------------------------------------------------
+
+ *
+ * Author: Bruno Blais, Polytechnique Montreal, 2020 -
+ */
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/trilinos_index_access.h>
+
+#include <solvers/single_precision_ilu.h>
+
+#include <Epetra_CrsMatrix.h>
+#include <Epetra_MultiVector.h>
+
+void
+SinglePrecisionILU::initialize(const TrilinosWrappers::SparseMatrix &matrix,
+                               const AdditionalData &additional_data)
+{
+  preconditioner.reset();
+  preconditioner = Teuchos::rcp(new LocalILUOperator(matrix, additional_data));
+}
+
+SinglePrecisionILU::LocalILUOperator::LocalILUOperator(
+  const TrilinosWrappers::SparseMatrix &matrix,
+  const AdditionalData &                additional_data)
+  : domain_map(matrix.trilinos_matrix().DomainMap())
+  , range_map(matrix.trilinos_matrix().RangeMap())
+{
+  const Epetra_CrsMatrix &epetra_matrix = matrix.trilinos_matrix();
+  const Epetra_Map &      row_map       = epetra_matrix.RowMap();
+  n_local_rows                          = epetra_matrix.NumMyRows();
+
+  // Sparsity pattern of the block of the matrix which couples the locally
+  // owned rows. The columns are identified by their local row index.
+  DynamicSparsityPattern dsp(n_local_rows);
+  for (unsigned int row = 0; row < n_local_rows; ++row)
+    {
+      int     n_entries;
+      double *values;
+      int *   indices;
+      epetra_matrix.ExtractMyRowView(row, n_entries, values, indices);
+      for (int k = 0; k < n_entries; ++k)
+        {
+          const int local_column = row_map.LID(TrilinosWrappers::global_index(
+            epetra_matrix.ColMap(), indices[k]));
+          if (local_column >= 0)
+            dsp.add(row, local_column);
+        }
+      // The ILU requires the diagonal entry even if it is not stored
+      dsp.add(row, row);
+    }
+  sparsity_pattern.copy_from(dsp);
+
+  // Single precision copy of the block. It is only needed during the
+  // factorization, the factors having their own storage. The diagonal is
+  // perturbed by the thresholds before it is rounded, like the Trilinos ILU
+  // does, so that both preconditioners factor the same matrix.
+  SparseMatrix<float> local_matrix(sparsity_pattern);
+  for (unsigned int row = 0; row < n_local_rows; ++row)
+    {
+      int     n_entries;
+      double *values;
+      int *   indices;
+      epetra_matrix.ExtractMyRowView(row, n_entries, values, indices);
+
+      double diagonal = 0.;
+      for (int k = 0; k < n_entries; ++k)
+        {
+          const int local_column = row_map.LID(TrilinosWrappers::global_index(
+            epetra_matrix.ColMap(), indices[k]));
+          if (local_column == static_cast<int>(row))
+            diagonal += values[k];
+          else if (local_column >= 0)
+            local_matrix.add(row, local_column, static_cast<float>(values[k]));
+        }
+
+      diagonal = additional_data.ilu_rtol * diagonal +
+                 (diagonal < 0. ? -1. : 1.) * additional_data.ilu_atol;
+      local_matrix.add(row, row, static_cast<float>(diagonal));
+    }
+
+  factors.initialize(local_matrix,
+                     SparseILU<float>::AdditionalData(
+                       0., additional_data.extra_off_diagonals));
+
+  local_src.reinit(n_local_rows);
+  local_dst.reinit(n_local_rows);
+}
+
+int
+SinglePrecisionILU::LocalILUOperator::SetUseTranspose(bool use_transpose)
+{
+  // The transpose of the factors is not available
+  return use_transpose ? -1 : 0;
+}
+
+int
+SinglePrecisionILU::LocalILUOperator::Apply(const Epetra_MultiVector &,
+                                            Epetra_MultiVector &) const
+{
+  // Only the inverse of the operator, the preconditioner, is available
+  return -1;
+}
+
+int
+SinglePrecisionILU::LocalILUOperator::ApplyInverse(
+  const Epetra_MultiVector &X,
+  Epetra_MultiVector &      Y) const
+{
+  // X and Y may be the same vector, so the source is copied before the
+  // destination is written
+  for (int v = 0; v < X.NumVectors(); ++v)
+    {
+      for (unsigned int i = 0; i < n_local_rows; ++i)
+        local_src[i] = X[v][i];
+
+      factors.vmult(local_dst, local_src);
+
+      for (unsigned int i = 0; i < n_local_rows; ++i)
+        Y[v][i] = local_dst[i];
+    }
+  return 0;
+}
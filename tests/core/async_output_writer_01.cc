@@ -0,0 +1,80 @@
+// check the writing of files by the background thread of the
+// AsyncOutputWriter, with a buffer smaller than the queued files
+
+#include "../tests.h"
+#include "core/async_output_writer.h"
+
+#include <fstream>
+
+int
+main()
+{
+  try
+    {
+      initlog();
+
+      deallog << "Beggining" << std::endl;
+
+      {
+        AsyncOutputWriter writer(8);
+        for (unsigned int i = 0; i < 10; ++i)
+          writer.write("output." + std::to_string(i % 3) + ".txt",
+                       "iteration " + std::to_string(i));
+        writer.flush();
+
+        for (unsigned int i = 0; i < 3; ++i)
+          {
+            std::ifstream input("output." + std::to_string(i) + ".txt");
+            std::string   line;
+            std::getline(input, line);
+            deallog << line << std::endl;
+          }
+
+        // The error of a failed write is thrown by the next flush
+        writer.write("missing_folder/output.txt", "content");
+        try
+          {
+            writer.flush();
+          }
+        catch (std::exception &exc)
+          {
+            deallog << "Failed write : " << exc.what() << std::endl;
+          }
+
+        // The files queued before the destruction of the writer are written
+        writer.write("output.last.txt", "last");
+      }
+
+      std::ifstream input("output.last.txt");
+      std::string   line;
+      std::getline(input, line);
+      deallog << line << std::endl;
+
+      deallog << "OK" << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
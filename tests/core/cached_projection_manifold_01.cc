@@ -0,0 +1,96 @@
+// check that the cached projection manifold returns the cached projection of
+// a repeated query and evicts the least recently used projection when it is
+// full
+
+#include "../tests.h"
+#include "core/cached_projection_manifold.h"
+
+#include <BRepPrimAPI_MakeSphere.hxx>
+
+#include <vector>
+
+int
+main()
+{
+  try
+    {
+      initlog();
+
+      const TopoDS_Shape sphere = BRepPrimAPI_MakeSphere(1.).Shape();
+
+      // The cache holds two projections and is shared with the clone
+      CachedProjectionManifold<3, 3> manifold(sphere, 1e-8, 2);
+      const std::unique_ptr<Manifold<3, 3>> clone = manifold.clone();
+
+      // Faces of the mesh just above the north pole of the sphere, each one
+      // being projected from its center
+      std::vector<std::vector<Point<3>>> faces;
+      for (const double x : {0., 0.2, 0.4})
+        faces.push_back({Point<3>(x - 0.1, -0.1, 1.05),
+                         Point<3>(x + 0.1, -0.1, 1.05),
+                         Point<3>(x - 0.1, 0.1, 1.05),
+                         Point<3>(x + 0.1, 0.1, 1.05)});
+
+      auto project = [&](const Manifold<3, 3> &projector,
+                         const unsigned int    face) {
+        const ArrayView<const Point<3>> surrounding_points(faces[face]);
+        return projector.project_to_manifold(surrounding_points,
+                                             Point<3>(0.2 * face, 0., 1.05));
+      };
+
+      const Point<3> first_projection    = project(manifold, 0);
+      const Point<3> repeated_projection = project(manifold, 0);
+
+      deallog << "Projection on the sphere : "
+              << (std::abs(first_projection.norm() - 1.) < 1e-6 ? "true" :
+                                                                  "false")
+              << std::endl;
+      deallog << "Repeated query hits the cache : "
+              << (manifold.n_cache_hits() == 1 &&
+                      repeated_projection == first_projection ?
+                    "true" :
+                    "false")
+              << std::endl;
+
+      // The second face is the least recently used one when the third face is
+      // projected, so it is evicted while the first face stays in the cache
+      project(manifold, 1);
+      project(*clone, 0);
+      project(*clone, 2);
+      project(manifold, 0);
+      deallog << "Cache hits : " << manifold.n_cache_hits()
+              << " - Cached projections : " << manifold.n_cached_projections()
+              << std::endl;
+      project(manifold, 1);
+      deallog << "Least recently used projection evicted : "
+              << (manifold.n_cache_hits() == 3 ? "true" : "false")
+              << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
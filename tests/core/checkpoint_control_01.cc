@@ -0,0 +1,101 @@
+// check the rotation of the checkpoints over two generations and the
+// fallback to the previous checkpoint when the latest one is corrupted
+
+#include "../tests.h"
+#include "core/checkpoint_control.h"
+
+#include <cstdio>
+#include <fstream>
+
+void
+write_checkpoint(const CheckpointControl &control, const std::string &content)
+{
+  const std::string prefix = control.next_prefix();
+  std::ofstream     output(prefix + ".data");
+  output << content;
+  output.close();
+  control.commit(prefix, {".data", ".missing"});
+  deallog << "Checkpoint written : " << prefix << std::endl;
+}
+
+int
+main()
+{
+  try
+    {
+      initlog();
+
+      deallog << "Beggining" << std::endl;
+
+      // The checkpoints left by a previous run of the test would be found as
+      // the existing generations
+      for (const char *file : {"restart.checkpoints",
+                               "restart_00.data",
+                               "restart_00.checksums",
+                               "restart_01.data",
+                               "restart_01.checksums"})
+        std::remove(file);
+
+      CheckpointControl control("restart", 2);
+      for (unsigned int i = 0; i < 3; ++i)
+        write_checkpoint(control, "iteration " + std::to_string(i));
+      deallog << "Latest checkpoint : " << control.latest_valid_prefix()
+              << std::endl;
+
+      // A checkpoint interrupted while its files are overwritten does not
+      // match its checksums
+      {
+        std::ofstream output("restart_00.data");
+        output << "interrupted";
+      }
+      deallog << "Latest valid checkpoint : " << control.latest_valid_prefix()
+              << std::endl;
+      deallog << "Next checkpoint : " << control.next_prefix() << std::endl;
+
+      {
+        std::ofstream output("restart_01.data");
+        output << "interrupted";
+      }
+      try
+        {
+          control.latest_valid_prefix();
+        }
+      catch (std::exception &exc)
+        {
+          deallog << "No valid checkpoint : " << exc.what() << std::endl;
+        }
+
+      // A single generation would overwrite its checkpoint in place, so two
+      // generations are still kept
+      CheckpointControl single_control("single", 1);
+      deallog << "Single generation requested : "
+              << single_control.next_prefix() << std::endl;
+
+      deallog << "OK" << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
@@ -0,0 +1,75 @@
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/vector.h>
+
+#include <core/newton_non_linear_solver.h>
+#include <core/parameters.h>
+#include <core/physics_solver.h>
+
+#include <iostream>
+#include <memory>
+
+#include "../tests.h"
+#include "non_linear_test_system_01.h"
+
+/**
+ * @brief Tests the jacobian-free Newton-Krylov non-linear solver using a simple
+ * system of two equations, only one of which is non-linear
+ */
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, numbers::invalid_unsigned_int);
+  initlog();
+
+  Parameters::NonLinearSolver params{
+    Parameters::Verbosity::quiet,
+    Parameters::NonLinearSolver::SolverType::jfnk,
+    1e-8, // tolerance
+    10,   // maxIter
+    4,    // display precision
+    1,    // skip iterations
+    Parameters::NonLinearSolver::SkipPolicy::fixed,
+    0.1,  // skip contraction threshold
+    3,    // anderson depth
+    1e-2, // jfnk forcing term
+    10    // jfnk preconditioner lifetime
+  };
+
+  deallog << "Creating solver" << std::endl;
+
+  // Create an instantiation of the Test Class
+  std::unique_ptr<TestClass> solver = std::make_unique<TestClass>(params);
+
+
+  deallog << "Solving non-linear system " << std::endl;
+  // Solve the non-linear system of equation
+  solver->solve_non_linear_system(
+    Parameters::SimulationControl::TimeSteppingMethod::steady, true, true);
+
+
+  deallog << "The final solution is : " << solver->present_solution[0] << " "
+          << solver->present_solution[1] << std::endl;
+
+  // The jacobian matrix is only assembled once to build the preconditioner,
+  // which is kept for the whole solution. Each GMRES solve of this system of
+  // two equations needs a few jacobian-free products only.
+  const auto *jfnk_solver =
+    dynamic_cast<JFNKNonLinearSolver<Vector<double>> *>(
+      solver->non_linear_solver);
+  const unsigned int n_products = jfnk_solver->get_n_jacobian_products();
+  const unsigned int n_iterations =
+    solver->solver_statistics.non_linear_iterations;
+
+  deallog << "Jacobian assemblies : " << solver->n_jacobian_assemblies
+          << std::endl;
+  deallog << "Jacobian-free products at most three per iteration : "
+          << (n_products > 0 && n_products <= 3 * n_iterations ? "true" :
+                                                                 "false")
+          << std::endl;
+  AssertThrow(solver->n_jacobian_assemblies == 1,
+              ExcMessage("The jacobian matrix was assembled more than once"));
+}
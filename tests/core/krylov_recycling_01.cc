@@ -0,0 +1,114 @@
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/vector.h>
+
+#include <core/krylov_recycling.h>
+
+#include "../tests.h"
+
+/**
+ * @brief Tests the recycling FGMRES solver on a sequence of non-symmetric
+ * tridiagonal systems with slowly varying right-hand sides. The last system
+ * also has a modified matrix, which requires the update of the recycled
+ * subspace.
+ */
+
+void
+fill_matrix(FullMatrix<double> &A, const double diagonal)
+{
+  const unsigned int n = A.m();
+  A                    = 0;
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      A(i, i) = diagonal;
+      if (i > 0)
+        A(i, i - 1) = -1.2;
+      if (i < n - 1)
+        A(i, i + 1) = -0.8;
+    }
+}
+
+void
+test()
+{
+  const unsigned int n = 100;
+  FullMatrix<double> A(n, n);
+  fill_matrix(A, 2.5);
+
+  RecyclingFGMRES<Vector<double>> recycler(5);
+  PreconditionIdentity            preconditioner;
+
+  Vector<double> x(n);
+  Vector<double> b(n);
+  Vector<double> residual(n);
+  unsigned int   first_iterations = 0;
+
+  for (unsigned int k = 0; k < 4; ++k)
+    {
+      for (unsigned int i = 0; i < n; ++i)
+        b[i] = 1. + 0.01 * k * std::sin(i);
+
+      const bool matrix_changed = (k == 3);
+      if (matrix_changed)
+        fill_matrix(A, 2.51);
+
+      SolverControl solver_control(1000, 1e-10 * b.l2_norm(), false, false);
+      recycler.solve(A, x, b, preconditioner, solver_control, matrix_changed);
+
+      A.vmult(residual, x);
+      residual -= b;
+
+      deallog << "Solution " << k << " - converged : "
+              << (residual.l2_norm() < 1e-9 * b.l2_norm() ? "true" : "false");
+      if (k == 0)
+        first_iterations = solver_control.last_step();
+      else
+        deallog << " - fewer iterations than the first solution : "
+                << (solver_control.last_step() < first_iterations ? "true" :
+                                                                    "false")
+                << " - saved iterations reported : "
+                << (recycler.get_saved_iterations() ==
+                        static_cast<int>(first_iterations) -
+                          static_cast<int>(solver_control.last_step()) ?
+                      "true" :
+                      "false");
+      deallog << std::endl;
+    }
+}
+
+int
+main()
+{
+  try
+    {
+      initlog();
+      test();
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,67 @@
+// check the statistics of the load balance over the ranks and their report,
+// with a timer section which was not entered on every rank
+
+#include "../tests.h"
+#include "core/load_balance_report.h"
+
+int
+main()
+{
+  try
+    {
+      initlog();
+
+      deallog << "Beggining" << std::endl;
+
+      // Summaries of the timer of three ranks, the probes being located on
+      // the last rank only
+      const std::vector<std::map<std::string, double>> section_times = {
+        {{"assemble", 2.}, {"solve", 4.}},
+        {{"assemble", 3.}, {"solve", 4.}},
+        {{"assemble", 4.}, {"solve", 4.}, {"probes", 0.5}}};
+
+      const std::vector<std::map<std::string, double>> workload = {
+        {{"locally_owned_cells", 100}, {"locally_owned_dofs", 1000}},
+        {{"locally_owned_cells", 150}, {"locally_owned_dofs", 1400}},
+        {{"locally_owned_cells", 200}, {"locally_owned_dofs", 1900}}};
+
+      // The report formats the numbers itself, independently of the log
+      std::ostringstream report;
+      write_load_balance_report(report,
+                                3,
+                                compute_load_balance_statistics(section_times),
+                                compute_load_balance_statistics(workload));
+
+      std::istringstream report_lines(report.str());
+      std::string        line;
+      while (std::getline(report_lines, line))
+        deallog << line << std::endl;
+
+      deallog << "OK" << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
@@ -0,0 +1,144 @@
+// check that a GMSH mesh loaded from the mesh cache is identical to the mesh
+// from which the cache was written, including the boundary ids of the lines in
+// 3D, and that the second read is served by the cache
+
+#include <deal.II/distributed/tria.h>
+
+#include "../tests.h"
+#include "core/grids.h"
+
+#include <chrono>
+#include <filesystem>
+
+template <int dim>
+void
+test(const std::string &mesh_file_name)
+{
+  Parameters::Mesh mesh_parameters;
+  mesh_parameters.type               = Parameters::Mesh::Type::gmsh;
+  mesh_parameters.file_name          = mesh_file_name;
+  mesh_parameters.initial_refinement = 2;
+  mesh_parameters.use_cache          = true;
+  mesh_parameters.cache_file_name    = "mesh_cache_01_" + std::to_string(dim);
+
+  // A cache left by a previous run of the test would turn the first read into
+  // a cache hit
+  const std::string coarse_file_name =
+    mesh_parameters.cache_file_name + ".coarse";
+  const std::string forest_file_name =
+    mesh_parameters.cache_file_name + ".triangulation";
+  for (const std::string &file_name : {coarse_file_name,
+                                       forest_file_name,
+                                       forest_file_name + "_fixed.data",
+                                       forest_file_name + "_variable.data",
+                                       forest_file_name + ".info"})
+    std::filesystem::remove(file_name);
+
+  Parameters::Manifolds manifolds_parameters;
+  manifolds_parameters.size = 0;
+
+  BoundaryConditions::BoundaryConditions<dim> boundary_conditions;
+  boundary_conditions.size = 0;
+
+  // The first mesh is read from the GMSH file and refined, which writes the
+  // cache
+  auto generated_triangulation =
+    std::make_shared<parallel::distributed::Triangulation<dim>>(
+      MPI_COMM_WORLD);
+  read_mesh_and_manifolds<dim>(generated_triangulation,
+                               mesh_parameters,
+                               manifolds_parameters,
+                               boundary_conditions);
+
+  // The second mesh is loaded from the cache. A cache miss would write the
+  // coarse file again, which is detected by moving its time back.
+  const auto written_time =
+    std::filesystem::last_write_time(coarse_file_name) - std::chrono::hours(1);
+  std::filesystem::last_write_time(coarse_file_name, written_time);
+
+  auto cached_triangulation =
+    std::make_shared<parallel::distributed::Triangulation<dim>>(
+      MPI_COMM_WORLD);
+  read_mesh_and_manifolds<dim>(cached_triangulation,
+                               mesh_parameters,
+                               manifolds_parameters,
+                               boundary_conditions);
+
+  deallog << "Dimension " << dim << " - Cache hit : "
+          << (std::filesystem::last_write_time(coarse_file_name) ==
+                  written_time ?
+                "true" :
+                "false")
+          << std::endl;
+  deallog << "Generated mesh cells : "
+          << generated_triangulation->n_global_active_cells() << std::endl;
+  deallog << "Cached mesh cells    : "
+          << cached_triangulation->n_global_active_cells() << std::endl;
+
+  if (generated_triangulation->n_global_active_cells() !=
+      cached_triangulation->n_global_active_cells())
+    throw std::runtime_error("Number of cells not equal");
+
+  auto generated_cell = generated_triangulation->begin_active();
+  auto cached_cell    = cached_triangulation->begin_active();
+  for (; generated_cell != generated_triangulation->end();
+       ++generated_cell, ++cached_cell)
+    {
+      if (generated_cell->center().distance(cached_cell->center()) > 1e-12)
+        throw std::runtime_error("Cells not equal");
+      if (generated_cell->material_id() != cached_cell->material_id() ||
+          generated_cell->manifold_id() != cached_cell->manifold_id())
+        throw std::runtime_error("Material or manifold ids not equal");
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (generated_cell->face(f)->at_boundary() &&
+            generated_cell->face(f)->boundary_id() !=
+              cached_cell->face(f)->boundary_id())
+          throw std::runtime_error("Boundary ids not equal");
+      if (dim == 3)
+        for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+          if (generated_cell->line(l)->at_boundary() &&
+              generated_cell->line(l)->boundary_id() !=
+                cached_cell->line(l)->boundary_id())
+            throw std::runtime_error("Boundary ids of the lines not equal");
+    }
+  deallog << "OK" << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+  try
+    {
+      initlog();
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      test<2>(SOURCE_DIR "/mesh_cache_01_2d.msh");
+      test<3>(SOURCE_DIR "/mesh_cache_01_3d.msh");
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
@@ -0,0 +1,81 @@
+// check the records of the metrics log, with the increments of cumulative
+// quantities and the numbers which are not finite
+
+#include "../tests.h"
+#include "core/metrics_log.h"
+
+#include <fstream>
+#include <limits>
+
+void
+print_file(const std::string &filename)
+{
+  std::ifstream input(filename.c_str());
+  std::string   line;
+  while (std::getline(input, line))
+    deallog << line << std::endl;
+}
+
+int
+main()
+{
+  try
+    {
+      initlog();
+
+      deallog << "Beggining" << std::endl;
+
+      {
+        MetricsLog log("metrics.jsonl", true, false);
+        log.add("step", 1U);
+        log.add("dt", 0.125);
+        log.add("linear_iterations", std::vector<unsigned int>{12, 9});
+        log.add_increments("timer", {{"assemble", 2.5}, {"solve", 1.}});
+        log.write();
+
+        log.add("step", 2U);
+        log.add("cfl", std::numeric_limits<double>::quiet_NaN());
+        log.add("linear_iterations", std::vector<unsigned int>());
+        // The solve section was reset since the previous record
+        log.add_increments("timer",
+                           {{"assemble", 3.}, {"solve", 0.5}, {"output", 1.}});
+        log.write();
+      }
+      print_file("metrics.jsonl");
+
+      // A restarted simulation appends its records to the log
+      {
+        MetricsLog log("metrics.jsonl", true, true);
+        log.add("step", 3U);
+        log.write();
+      }
+      print_file("metrics.jsonl");
+
+      deallog << "OK" << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
@@ -0,0 +1,95 @@
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/vector.h>
+
+#include <core/newton_non_linear_solver.h>
+#include <core/parameters.h>
+#include <core/physics_solver.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+#include "non_linear_test_system_01.h"
+
+/**
+ * @brief Tests that the non-linear solvers call the hooks of the physics
+ * solver once at the beginning of each solve and once per accepted iterate.
+ * The initial guess is far enough from the solution for the line search to
+ * evaluate trial points, which must not be reported as accepted iterates.
+ */
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, numbers::invalid_unsigned_int);
+  initlog();
+
+  const std::vector<std::pair<std::string,
+                              Parameters::NonLinearSolver::SolverType>>
+    solver_types = {{"newton", Parameters::NonLinearSolver::SolverType::newton},
+                    {"skip_newton",
+                     Parameters::NonLinearSolver::SolverType::skip_newton},
+                    {"picard", Parameters::NonLinearSolver::SolverType::picard},
+                    {"jfnk", Parameters::NonLinearSolver::SolverType::jfnk}};
+
+  for (const auto &solver_type : solver_types)
+    {
+      Parameters::NonLinearSolver params{
+        Parameters::Verbosity::quiet,
+        solver_type.second,
+        1e-8, // tolerance
+        10,   // maxIter
+        4,    // display precision
+        1,    // skip iterations
+        Parameters::NonLinearSolver::SkipPolicy::fixed,
+        0.1,  // skip contraction threshold
+        3,    // anderson depth
+        1e-2, // jfnk forcing term
+        10    // jfnk preconditioner lifetime
+      };
+
+      std::unique_ptr<TestClass> solver = std::make_unique<TestClass>(params);
+      solver->present_solution[0] = 0.1;
+
+      // The second solve starts from the solution of the first one and must
+      // restart the history of the accepted iterates
+      solver->solve_non_linear_system(
+        Parameters::SimulationControl::TimeSteppingMethod::steady, true, true);
+      const unsigned int first_iterations =
+        solver->solver_statistics.non_linear_iterations;
+      const unsigned int first_accepted = solver->accepted_residuals.size();
+      const unsigned int first_rhs_assemblies = solver->n_rhs_assemblies;
+
+      solver->solve_non_linear_system(
+        Parameters::SimulationControl::TimeSteppingMethod::steady,
+        false,
+        false);
+      const unsigned int second_iterations =
+        solver->solver_statistics.non_linear_iterations - first_iterations;
+
+      const bool consistent =
+        solver->n_non_linear_solves == 2 &&
+        first_accepted == first_iterations + 1 &&
+        solver->accepted_residuals.size() == second_iterations + 1 &&
+        solver->n_inconsistent_iterates == 0;
+
+      deallog << solver_type.first << " - Accepted iterates consistent : "
+              << (consistent ? "true" : "false") << std::endl;
+      AssertThrow(consistent,
+                  ExcMessage("The accepted iterates of the " +
+                             solver_type.first +
+                             " solver do not match its iterations"));
+
+      // The line search of the Newton method evaluates more residuals than it
+      // accepts iterates
+      if (solver_type.second ==
+          Parameters::NonLinearSolver::SolverType::newton)
+        deallog << "Residual evaluations : " << first_rhs_assemblies
+                << " - Accepted iterates : " << first_accepted << std::endl;
+    }
+}
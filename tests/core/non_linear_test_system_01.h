@@ -26,8 +26,10 @@
 #include <core/non_linear_solver.h>
 #include <core/physics_solver.h>
 
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "../tests.h"
 
@@ -52,6 +54,11 @@ class TestClass : public PhysicsSolver<Vector<double>>
 public:
   TestClass(Parameters::NonLinearSolver &params)
     : PhysicsSolver(params)
+    , n_jacobian_assemblies(0)
+    , n_picard_assemblies(0)
+    , n_rhs_assemblies(0)
+    , n_non_linear_solves(0)
+    , n_inconsistent_iterates(0)
   {
     // Initialize the vectors needed for the Physics Solver
     this->evaluation_point.reinit(2);
@@ -74,6 +81,9 @@ public:
     const Parameters::SimulationControl::TimeSteppingMethod
       time_stepping_method) override
   {
+    ++n_jacobian_assemblies;
+    if (this->picard_linearization)
+      ++n_picard_assemblies;
     system_matrix.reinit(2);
     // System
     // x_0*x_0 +x_1 = 0
@@ -82,9 +92,14 @@ public:
     // Jacobian
     // 2x_0     1
     // 0        2
+    //
+    // The Picard linearization of x_0*x_0 keeps the present x_0 as the
+    // coefficient of the unknown x_0, which gives the matrix
+    // x_0      1
+    // 0        2
     double x_0 = this->evaluation_point[0];
     double x_1 = this->evaluation_point[1];
-    system_matrix.set(0, 0, 2 * x_0);
+    system_matrix.set(0, 0, this->picard_linearization ? x_0 : 2 * x_0);
     system_matrix.set(0, 1, 1);
     system_matrix.set(1, 0, 0);
     system_matrix.set(1, 1, 2);
@@ -100,6 +115,7 @@ public:
   assemble_rhs(const Parameters::SimulationControl::TimeSteppingMethod
                  time_stepping_method) override
   {
+    ++n_rhs_assemblies;
     double x_0          = this->evaluation_point[0];
     double x_1          = this->evaluation_point[1];
     this->system_rhs[0] = -(x_0 * x_0 + x_1);
@@ -123,6 +139,42 @@ public:
   apply_constraints()
   {}
 
+  void
+  start_non_linear_solve(
+    const Parameters::SimulationControl::TimeSteppingMethod) override
+  {
+    ++n_non_linear_solves;
+    accepted_residuals.clear();
+  }
+
+  // The residual of an accepted iterate is recalculated from the present
+  // solution to check that the non-linear solver has accepted it
+  void
+  accept_non_linear_iterate(
+    const Parameters::SimulationControl::TimeSteppingMethod,
+    const double residual) override
+  {
+    const double x_0 = this->present_solution[0];
+    const double x_1 = this->present_solution[1];
+    const double present_residual =
+      std::sqrt(std::pow(x_0 * x_0 + x_1, 2) + std::pow(2 * x_1 + 3, 2));
+    if (std::abs(residual - present_residual) > 1e-12 * (1. + residual))
+      ++n_inconsistent_iterates;
+    accepted_residuals.push_back(residual);
+  }
+
+  // Number of assemblies of the matrix, of its Picard linearization and of
+  // the right-hand side alone, used to check the work done by the solvers
+  unsigned int n_jacobian_assemblies;
+  unsigned int n_picard_assemblies;
+  unsigned int n_rhs_assemblies;
+
+  // Calls of the hooks of the non-linear solvers. The residuals of the
+  // accepted iterates are those of the last solve.
+  unsigned int        n_non_linear_solves;
+  unsigned int        n_inconsistent_iterates;
+  std::vector<double> accepted_residuals;
+
 private:
   LAPACKFullMatrix<double> system_matrix;
   Vector<double>           rhs;
@@ -0,0 +1,65 @@
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/vector.h>
+
+#include <core/newton_non_linear_solver.h>
+#include <core/parameters.h>
+#include <core/physics_solver.h>
+
+#include <iostream>
+#include <memory>
+
+#include "../tests.h"
+#include "non_linear_test_system_01.h"
+
+/**
+ * @brief Tests the Anderson-accelerated picard non-linear solver using a simple
+ * system of two equations, only one of which is non-linear
+ */
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, numbers::invalid_unsigned_int);
+  initlog();
+
+  Parameters::NonLinearSolver params{
+    Parameters::Verbosity::quiet,
+    Parameters::NonLinearSolver::SolverType::picard,
+    1e-8, // tolerance
+    10,   // maxIter
+    4,    // display precision
+    1,    // skip iterations
+    Parameters::NonLinearSolver::SkipPolicy::fixed,
+    0.1, // skip contraction threshold
+    3    // anderson depth
+  };
+
+  deallog << "Creating solver" << std::endl;
+
+  // Create an instantiation of the Test Class
+  std::unique_ptr<TestClass> solver = std::make_unique<TestClass>(params);
+
+
+  deallog << "Solving non-linear system " << std::endl;
+  // Solve the non-linear system of equation
+  solver->solve_non_linear_system(
+    Parameters::SimulationControl::TimeSteppingMethod::steady, true, true);
+
+
+  deallog << "The final solution is : " << solver->present_solution[0] << " "
+          << solver->present_solution[1] << std::endl;
+
+  // Every matrix is the Picard linearization at the present iterate. Its
+  // unaccelerated fixed-point iteration oscillates around the solution of
+  // this system, which the Anderson mixing makes converge.
+  deallog << "Picard linearizations : " << solver->n_picard_assemblies
+          << " of " << solver->n_jacobian_assemblies << " matrix assemblies"
+          << std::endl;
+  deallog << "Non-linear iterations : "
+          << solver->solver_statistics.non_linear_iterations << std::endl;
+  AssertThrow(solver->n_picard_assemblies == solver->n_jacobian_assemblies,
+              ExcMessage("The jacobian matrix was used by the Picard solver"));
+}
@@ -0,0 +1,87 @@
+// check the append-only writing of a table and its restart from a checkpoint
+
+#include "../tests.h"
+#include "core/table_writer.h"
+
+#include <fstream>
+
+void
+print_file(const std::string &filename)
+{
+  std::ifstream input(filename.c_str());
+  std::string   line;
+  while (std::getline(input, line))
+    deallog << line << std::endl;
+}
+
+int
+main()
+{
+  try
+    {
+      initlog();
+
+      deallog << "Beggining" << std::endl;
+
+      {
+        TableWriter table("table.dat", {"time", "value"}, 3, true, 2);
+        table.add_row({0.1, 1.0});
+        // The second row exceeds the buffer and flushes the table
+        table.add_row({0.2, 2.0});
+        table.add_row({0.3, 3.0});
+        table.save("restart");
+        // These rows are written after the checkpoint
+        table.add_row({0.4, 4.0});
+        table.flush();
+        deallog << "Rows written : " << table.n_written_rows() << std::endl;
+      }
+      print_file("table.dat");
+
+      deallog << "Restart" << std::endl;
+      TableWriter table("table.dat", {"time", "value"}, 3, true, 2);
+      table.read("restart");
+      table.add_row({0.4, 40.0});
+      table.flush();
+      deallog << "Rows written : " << table.n_written_rows() << std::endl;
+      print_file("table.dat");
+
+      // A checkpoint without the number of rows of the table appends the new
+      // rows to the file
+      deallog << "Restart without table checkpoint" << std::endl;
+      std::remove("missing.tablewriter");
+      TableWriter appended_table("table.dat", {"time", "value"}, 3, true, 2);
+      appended_table.read("missing");
+      appended_table.add_row({0.5, 50.0});
+      appended_table.flush();
+      deallog << "Rows written : " << appended_table.n_written_rows()
+              << std::endl;
+      print_file("table.dat");
+
+      deallog << "OK" << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
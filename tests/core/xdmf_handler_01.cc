@@ -0,0 +1,116 @@
+// check the save and read of the xdmfhandler and the append of its entries
+// to the xdmf file
+
+#include "../tests.h"
+#include "core/xdmf_handler.h"
+
+#include <fstream>
+#include <sstream>
+
+std::string
+file_content(const std::string &filename)
+{
+  std::ifstream      input(filename.c_str());
+  std::ostringstream content;
+  content << input.rdbuf();
+  return content.str();
+}
+
+XDMFEntry
+create_entry(const unsigned int output)
+{
+  XDMFEntry entry("out." + Utilities::int_to_string(output, 4) + ".h5",
+                  0.1 * output,
+                  121,
+                  100,
+                  2);
+  entry.add_attribute("velocity", 2);
+  entry.add_attribute("pressure", 1);
+  return entry;
+}
+
+// Writes the complete xdmf file of a list of outputs
+std::string
+complete_file(const std::vector<unsigned int> &outputs)
+{
+  XDMFHandler complete_handler;
+  for (const unsigned int output : outputs)
+    complete_handler.entries.push_back(create_entry(output));
+  complete_handler.write_xdmf_file("complete.xdmf", MPI_COMM_WORLD);
+  return file_content("complete.xdmf");
+}
+
+int
+main(int argc, char *argv[])
+{
+  try
+    {
+      initlog();
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      deallog << "Beggining" << std::endl;
+
+      XDMFHandler xdmfhandlerMaster;
+      xdmfhandlerMaster.entries.push_back(create_entry(0));
+      xdmfhandlerMaster.write_xdmf_file("out.xdmf", MPI_COMM_WORLD);
+      xdmfhandlerMaster.entries.push_back(create_entry(1));
+      xdmfhandlerMaster.write_xdmf_file("out.xdmf", MPI_COMM_WORLD);
+      xdmfhandlerMaster.save("restart");
+
+      // This output follows the checkpoint
+      xdmfhandlerMaster.entries.push_back(create_entry(2));
+      xdmfhandlerMaster.write_xdmf_file("out.xdmf", MPI_COMM_WORLD);
+      deallog << "Appended file identical to a complete write : "
+              << (file_content("out.xdmf") == complete_file({0, 1, 2}) ?
+                    "true" :
+                    "false")
+              << std::endl;
+
+      XDMFHandler xdmfhandlerWorker;
+      xdmfhandlerWorker.read("restart");
+      bool entries_restored = xdmfhandlerWorker.entries.size() == 2;
+      for (unsigned int i = 0; entries_restored && i < 2; ++i)
+        entries_restored =
+          xdmfhandlerWorker.entries[i].get_xdmf_content(3) ==
+          xdmfhandlerMaster.entries[i].get_xdmf_content(3);
+      deallog << "Entries restored : " << (entries_restored ? "true" : "false")
+              << std::endl;
+
+      // The output which followed the checkpoint is dropped from the file
+      xdmfhandlerWorker.entries.push_back(create_entry(3));
+      xdmfhandlerWorker.write_xdmf_file("out.xdmf", MPI_COMM_WORLD);
+      deallog << "Restarted file holds the outputs of the checkpoint : "
+              << (file_content("out.xdmf") == complete_file({0, 1, 3}) ?
+                    "true" :
+                    "false")
+              << std::endl;
+
+      deallog << "OK" << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
@@ -0,0 +1,183 @@
+// check that the autotune of the linear solver leaves the solution of the
+// linear system and writes the selected configuration
+
+#include "../tests.h"
+#include "core/parameters.h"
+#include "solvers/gls_navier_stokes.h"
+#include "solvers/navier_stokes_solver_parameters.h"
+
+#include <cstdio>
+#include <fstream>
+
+template <int dim>
+class ExactSolutionMMS : public Function<dim>
+{
+public:
+  ExactSolutionMMS()
+    : Function<dim>(3)
+  {}
+  virtual void
+  vector_value(const Point<dim> &p, Vector<double> &values) const;
+};
+template <int dim>
+void
+ExactSolutionMMS<dim>::vector_value(const Point<dim> &p,
+                                    Vector<double> &  values) const
+{
+  assert(dim == 2);
+  const double a = M_PI;
+  double       x = p[0];
+  double       y = p[1];
+  values(0)      = sin(a * x) * sin(a * x) * cos(a * y) * sin(a * y);
+  values(1)      = -cos(a * x) * sin(a * x) * sin(a * y) * sin(a * y);
+}
+
+
+template <int dim>
+class MMSSineForcingFunction : public Function<dim>
+{
+public:
+  MMSSineForcingFunction()
+    : Function<dim>(3)
+  {}
+  virtual void
+  vector_value(const Point<dim> &p, Vector<double> &values) const;
+};
+template <int dim>
+void
+MMSSineForcingFunction<dim>::vector_value(const Point<dim> &p,
+                                          Vector<double> &  values) const
+{
+  assert(dim == 2);
+  const double a = M_PI;
+  const double x = p[0];
+  const double y = p[1];
+  values(0) =
+    (2 * a * a * (-sin(a * x) * sin(a * x) + cos(a * x) * (cos(a * x))) *
+       sin(a * y) * cos(a * y) -
+     4 * a * a * sin(a * x) * sin(a * x) * sin(a * y) * cos(a * y) - 2.0 * x) *
+      (-1.) +
+    a * std::pow(sin(a * x), 3.) * std::pow(sin(a * y), 2.) * std::cos(a * x);
+  values(1) =
+    (2 * a * a * (sin(a * y) * (sin(a * y)) - cos(a * y) * cos(a * y)) *
+       sin(a * x) * cos(a * x) +
+     4 * a * a * sin(a * x) * sin(a * y) * sin(a * y) * cos(a * x) - 2.0 * y) *
+      (-1) +
+    a * std::pow(sin(a * x), 2.) * std::pow(sin(a * y), 3.) * std::cos(a * y);
+}
+
+
+template <int dim>
+class MMSNavierStokes : public GLSNavierStokesSolver<dim>
+{
+public:
+  MMSNavierStokes(NavierStokesSolverParameters<dim> nsparam,
+                  const unsigned int                degreeVelocity,
+                  const unsigned int                degreePressure)
+    : GLSNavierStokesSolver<dim>(nsparam, degreeVelocity, degreePressure)
+  {}
+
+  // Solves the steady manufactured solution and returns the L2 error of the
+  // velocity
+  double
+  run();
+};
+
+template <int dim>
+double
+MMSNavierStokes<dim>::run()
+{
+  const int initialSize = 4;
+  GridGenerator::hyper_cube(*this->triangulation, -1, 1);
+  this->triangulation->refine_global(initialSize);
+  this->setup_dofs();
+  this->exact_solution                        = new ExactSolutionMMS<dim>;
+  this->forcing_function                      = new MMSSineForcingFunction<dim>;
+  this->nsparam.physical_properties.viscosity = 1.;
+
+  this->first_iteration();
+  return this->calculate_L2_error(this->present_solution).first;
+}
+
+int
+main(int argc, char *argv[])
+{
+  try
+    {
+      initlog();
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      // The parameter file of a previous run must not be found
+      std::remove("autotuned_linear_solver.prm");
+
+      ParameterHandler                prm;
+      NavierStokesSolverParameters<2> NSparam;
+      NSparam.declare(prm);
+      NSparam.parse(prm);
+
+      // Manually alter some of the default parameters of the solver
+      NSparam.non_linear_solver.verbosity = Parameters::Verbosity::quiet;
+      NSparam.linear_solver.verbosity     = Parameters::Verbosity::quiet;
+      NSparam.boundary_conditions.createDefaultNoSlip();
+
+      // The configurations selected by the autotune depend on the timings,
+      // so the history of the linear solvers is not written to the output
+      deallog.depth_file(0);
+
+      NSparam.linear_solver.autotune = false;
+      MMSNavierStokes<2> reference_problem(
+        NSparam,
+        NSparam.fem_parameters.velocity_order,
+        NSparam.fem_parameters.pressure_order);
+      const double reference_error = reference_problem.run();
+
+      NSparam.linear_solver.autotune = true;
+      MMSNavierStokes<2> autotuned_problem(
+        NSparam,
+        NSparam.fem_parameters.velocity_order,
+        NSparam.fem_parameters.pressure_order);
+      const double autotuned_error = autotuned_problem.run();
+
+      deallog.depth_file(10000);
+
+      deallog << "Same error with and without the autotune : "
+              << (std::abs(autotuned_error - reference_error) <
+                      1e-5 * reference_error ?
+                    "true" :
+                    "false")
+              << std::endl;
+
+      std::ifstream autotuned_parameters("autotuned_linear_solver.prm");
+      deallog << "Selected configuration written : "
+              << (autotuned_parameters.good() ? "true" : "false")
+              << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,204 @@
+// check that the direct solver of the gls and gd solvers gives the solution
+// of the iterative solver on a mesh with hanging nodes
+
+#include "../tests.h"
+#include "core/parameters.h"
+#include "solvers/gd_navier_stokes.h"
+#include "solvers/gls_navier_stokes.h"
+#include "solvers/navier_stokes_solver_parameters.h"
+
+template <int dim>
+class ExactSolutionMMS : public Function<dim>
+{
+public:
+  ExactSolutionMMS()
+    : Function<dim>(3)
+  {}
+  virtual void
+  vector_value(const Point<dim> &p, Vector<double> &values) const;
+};
+template <int dim>
+void
+ExactSolutionMMS<dim>::vector_value(const Point<dim> &p,
+                                    Vector<double> &  values) const
+{
+  assert(dim == 2);
+  const double a = M_PI;
+  double       x = p[0];
+  double       y = p[1];
+  values(0)      = sin(a * x) * sin(a * x) * cos(a * y) * sin(a * y);
+  values(1)      = -cos(a * x) * sin(a * x) * sin(a * y) * sin(a * y);
+}
+
+
+template <int dim>
+class MMSSineForcingFunction : public Function<dim>
+{
+public:
+  MMSSineForcingFunction()
+    : Function<dim>(3)
+  {}
+  virtual void
+  vector_value(const Point<dim> &p, Vector<double> &values) const;
+};
+template <int dim>
+void
+MMSSineForcingFunction<dim>::vector_value(const Point<dim> &p,
+                                          Vector<double> &  values) const
+{
+  assert(dim == 2);
+  const double a = M_PI;
+  const double x = p[0];
+  const double y = p[1];
+  values(0) =
+    (2 * a * a * (-sin(a * x) * sin(a * x) + cos(a * x) * (cos(a * x))) *
+       sin(a * y) * cos(a * y) -
+     4 * a * a * sin(a * x) * sin(a * x) * sin(a * y) * cos(a * y) - 2.0 * x) *
+      (-1.) +
+    a * std::pow(sin(a * x), 3.) * std::pow(sin(a * y), 2.) * std::cos(a * x);
+  values(1) =
+    (2 * a * a * (sin(a * y) * (sin(a * y)) - cos(a * y) * cos(a * y)) *
+       sin(a * x) * cos(a * x) +
+     4 * a * a * sin(a * x) * sin(a * y) * sin(a * y) * cos(a * x) - 2.0 * y) *
+      (-1) +
+    a * std::pow(sin(a * x), 2.) * std::pow(sin(a * y), 3.) * std::cos(a * y);
+}
+
+
+template <int dim, typename BaseSolver, typename VectorType>
+class MMSNavierStokes : public BaseSolver
+{
+public:
+  MMSNavierStokes(NavierStokesSolverParameters<dim> &nsparam,
+                  const unsigned int                 degreeVelocity,
+                  const unsigned int                 degreePressure)
+    : BaseSolver(nsparam, degreeVelocity, degreePressure)
+  {}
+
+  // Solves the steady manufactured solution and returns the locally owned
+  // part of the solution
+  VectorType
+  run();
+};
+
+template <int dim, typename BaseSolver, typename VectorType>
+VectorType
+MMSNavierStokes<dim, BaseSolver, VectorType>::run()
+{
+  GridGenerator::hyper_cube(*this->triangulation, -1, 1);
+  this->triangulation->refine_global(3);
+
+  // The refinement of a quarter of the domain creates hanging nodes at its
+  // interface with the rest of the mesh
+  for (const auto &cell : this->triangulation->active_cell_iterators())
+    if (cell->is_locally_owned() && cell->center()[0] > 0 &&
+        cell->center()[1] > 0)
+      cell->set_refine_flag();
+  this->triangulation->execute_coarsening_and_refinement();
+
+  this->setup_dofs();
+  this->exact_solution                        = new ExactSolutionMMS<dim>;
+  this->forcing_function                      = new MMSSineForcingFunction<dim>;
+  this->nsparam.physical_properties.viscosity = 1.;
+
+  this->first_iteration();
+
+  VectorType solution(this->locally_owned_dofs, this->mpi_communicator);
+  solution = this->present_solution;
+  return solution;
+}
+
+// Solves the problem with the iterative and the direct solvers and compares
+// their solutions
+template <typename BaseSolver, typename VectorType>
+bool
+same_solution_with_direct_solver(NavierStokesSolverParameters<2> NSparam)
+{
+  NSparam.linear_solver.solver = Parameters::LinearSolver::SolverType::gmres;
+  MMSNavierStokes<2, BaseSolver, VectorType> iterative_problem(
+    NSparam,
+    NSparam.fem_parameters.velocity_order,
+    NSparam.fem_parameters.pressure_order);
+  const VectorType iterative_solution = iterative_problem.run();
+
+  NSparam.linear_solver.solver = Parameters::LinearSolver::SolverType::direct;
+  MMSNavierStokes<2, BaseSolver, VectorType> direct_problem(
+    NSparam,
+    NSparam.fem_parameters.velocity_order,
+    NSparam.fem_parameters.pressure_order);
+  VectorType difference = direct_problem.run();
+
+  difference -= iterative_solution;
+  return difference.l2_norm() < 1e-6 * iterative_solution.l2_norm();
+}
+
+int
+main(int argc, char *argv[])
+{
+  try
+    {
+      initlog();
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      ParameterHandler                prm;
+      NavierStokesSolverParameters<2> NSparam;
+      NSparam.declare(prm);
+      NSparam.parse(prm);
+
+      // Manually alter some of the default parameters of the solver
+      NSparam.non_linear_solver.verbosity     = Parameters::Verbosity::quiet;
+      NSparam.non_linear_solver.tolerance     = 1e-10;
+      NSparam.linear_solver.verbosity         = Parameters::Verbosity::quiet;
+      NSparam.linear_solver.relative_residual = 1e-10;
+      NSparam.linear_solver.minimum_residual  = 1e-14;
+      NSparam.boundary_conditions.createDefaultNoSlip();
+
+      // The history of the linear solvers depends on the solver, so it is not
+      // written to the output
+      deallog.depth_file(0);
+
+      const bool gls_same_solution =
+        same_solution_with_direct_solver<GLSNavierStokesSolver<2>,
+                                         TrilinosWrappers::MPI::Vector>(
+          NSparam);
+      const bool gd_same_solution =
+        same_solution_with_direct_solver<GDNavierStokesSolver<2>,
+                                         TrilinosWrappers::MPI::BlockVector>(
+          NSparam);
+
+      deallog.depth_file(10000);
+
+      deallog << "GLS direct solution identical to the iterative solution : "
+              << (gls_same_solution ? "true" : "false") << std::endl;
+      deallog << "GD direct solution identical to the iterative solution : "
+              << (gd_same_solution ? "true" : "false") << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
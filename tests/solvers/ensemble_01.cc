@@ -0,0 +1,145 @@
+// check that the velocity scale of an ensemble variant only scales the
+// inhomogeneities of the function boundary conditions
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include "../tests.h"
+#include "core/parameters.h"
+#include "solvers/gls_navier_stokes.h"
+#include "solvers/navier_stokes_solver_parameters.h"
+
+template <int dim>
+class EnsembleNavierStokes : public GLSNavierStokesSolver<dim>
+{
+public:
+  EnsembleNavierStokes(NavierStokesSolverParameters<dim> nsparam,
+                       const unsigned int                degreeVelocity,
+                       const unsigned int                degreePressure)
+    : GLSNavierStokesSolver<dim>(nsparam, degreeVelocity, degreePressure)
+  {}
+  void
+  run();
+};
+
+template <int dim>
+void
+EnsembleNavierStokes<dim>::run()
+{
+  GridGenerator::hyper_cube(*this->triangulation, -1, 1, true);
+  this->triangulation->refine_global(2);
+  this->setup_dofs();
+
+  // An inhomogeneous constraint of an interior dof, which is not imposed by a
+  // function boundary condition and must not be scaled
+  IndexSet boundary_dofs(this->dof_handler.n_dofs());
+  DoFTools::extract_boundary_dofs(this->dof_handler,
+                                  ComponentMask(),
+                                  boundary_dofs);
+  types::global_dof_index interior_dof = 0;
+  while (boundary_dofs.is_element(interior_dof) ||
+         this->nonzero_constraints.is_constrained(interior_dof))
+    ++interior_dof;
+
+  AffineConstraints<double> interior_constraints;
+  interior_constraints.add_line(interior_dof);
+  interior_constraints.set_inhomogeneity(interior_dof, 3.);
+  interior_constraints.close();
+  this->nonzero_constraints.merge(interior_constraints);
+
+  const NavierStokesSolverParameters<dim> reference_parameters = this->nsparam;
+  AffineConstraints<double>               reference_constraints;
+  reference_constraints.copy_from(this->nonzero_constraints);
+
+  // The second variant doubles the velocity of the function boundary
+  this->setup_ensemble_variant(1, reference_parameters, reference_constraints);
+
+  const double interior_inhomogeneity =
+    this->nonzero_constraints.get_inhomogeneity(interior_dof);
+
+  unsigned int n_scaled        = 0;
+  bool         function_scaled = true;
+  for (const auto &line : reference_constraints.get_lines())
+    if (line.inhomogeneity != 0. && line.index != interior_dof)
+      {
+        ++n_scaled;
+        function_scaled =
+          function_scaled &&
+          std::abs(this->nonzero_constraints.get_inhomogeneity(line.index) -
+                   2. * line.inhomogeneity) < 1e-12;
+      }
+
+  deallog << "Function boundary velocity scaled : "
+          << (n_scaled > 0 && function_scaled ? "true" : "false")
+          << std::endl;
+  deallog << "Interior inhomogeneity unchanged : "
+          << (interior_inhomogeneity == 3. ? "true" : "false") << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+  try
+    {
+      initlog();
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      ParameterHandler                prm;
+      NavierStokesSolverParameters<2> NSparam;
+      NSparam.declare(prm);
+      prm.parse_input_from_string("subsection boundary conditions\n"
+                                  "  set number = 2\n"
+                                  "  subsection bc 0\n"
+                                  "    set type = function\n"
+                                  "    set id = 0\n"
+                                  "    subsection u\n"
+                                  "      set Function expression = 1\n"
+                                  "    end\n"
+                                  "  end\n"
+                                  "  subsection bc 1\n"
+                                  "    set type = noslip\n"
+                                  "    set id = 1\n"
+                                  "  end\n"
+                                  "end\n"
+                                  "subsection ensemble\n"
+                                  "  set velocity scales = 1, 2\n"
+                                  "end\n");
+      NSparam.parse(prm);
+
+      NSparam.non_linear_solver.verbosity = Parameters::Verbosity::quiet;
+      NSparam.linear_solver.verbosity     = Parameters::Verbosity::quiet;
+
+      EnsembleNavierStokes<2> problem_2d(
+        NSparam,
+        NSparam.fem_parameters.velocity_order,
+        NSparam.fem_parameters.pressure_order);
+      problem_2d.run();
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+// check the sampling of a linear field by a point probe and a line probe
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/trilinos_vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+#include "solvers/probes.h"
+
+#include <fstream>
+
+// Velocity (x, 2y) and pressure x + y, which are interpolated exactly
+class LinearSolution : public Function<2>
+{
+public:
+  LinearSolution()
+    : Function<2>(3)
+  {}
+  virtual double
+  value(const Point<2> &p, const unsigned int component) const override
+  {
+    if (component == 0)
+      return p[0];
+    if (component == 1)
+      return 2 * p[1];
+    return p[0] + p[1];
+  }
+};
+
+void
+print_file(const std::string &filename)
+{
+  std::ifstream input(filename.c_str());
+  std::string   line;
+  while (std::getline(input, line))
+    deallog << line << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+  try
+    {
+      initlog();
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      parallel::distributed::Triangulation<2> triangulation(MPI_COMM_WORLD);
+      GridGenerator::hyper_cube(triangulation, 0, 1);
+      triangulation.refine_global(3);
+
+      FESystem<2>   fe(FE_Q<2>(1), 2, FE_Q<2>(1), 1);
+      DoFHandler<2> dof_handler(triangulation);
+      dof_handler.distribute_dofs(fe);
+
+      IndexSet locally_relevant_dofs;
+      DoFTools::extract_locally_relevant_dofs(dof_handler,
+                                              locally_relevant_dofs);
+      TrilinosWrappers::MPI::Vector locally_owned_solution(
+        dof_handler.locally_owned_dofs(), MPI_COMM_WORLD);
+      TrilinosWrappers::MPI::Vector solution(dof_handler.locally_owned_dofs(),
+                                             locally_relevant_dofs,
+                                             MPI_COMM_WORLD);
+      VectorTools::interpolate(dof_handler,
+                               LinearSolution(),
+                               locally_owned_solution);
+      solution = locally_owned_solution;
+
+      Parameters::Probes probe_parameters;
+      probe_parameters.enable      = true;
+      probe_parameters.frequency   = 1;
+      probe_parameters.output_name = "probes";
+      probe_parameters.precision   = 4;
+      probe_parameters.points      = {{0.3, 0.6}};
+      probe_parameters.lines       = {{0.1, 0.5, 0.9, 0.5, 3}};
+
+      Parameters::FEM fem_parameters;
+      fem_parameters.qmapping_all = false;
+
+      {
+        Probes<2, TrilinosWrappers::MPI::Vector> probes(
+          probe_parameters, dof_handler, 1, fem_parameters, MPI_COMM_WORLD);
+        probes.sample(solution, 0.5);
+        probes.flush();
+      }
+
+      print_file("probes.00.dat");
+      print_file("probes.01.coordinates.dat");
+      print_file("probes.01.dat");
+
+      deallog << "OK" << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
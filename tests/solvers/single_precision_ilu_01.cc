@@ -0,0 +1,111 @@
+// check that the single precision ILU gives the same preconditioned vector as
+// the double precision Trilinos ILU with the same thresholds
+
+#include <deal.II/base/index_set.h>
+
+#include <deal.II/lac/trilinos_precondition.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+#include <deal.II/lac/trilinos_vector.h>
+
+#include "../tests.h"
+#include "solvers/single_precision_ilu.h"
+
+#include <utility>
+#include <vector>
+
+int
+main(int argc, char *argv[])
+{
+  try
+    {
+      initlog();
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      // Convection-diffusion operator of finite differences on a square grid,
+      // which is not symmetric
+      const unsigned int n_points = 8;
+      const unsigned int n        = n_points * n_points;
+
+      TrilinosWrappers::SparseMatrix matrix(n, n, 5U);
+      for (unsigned int i = 0; i < n_points; ++i)
+        for (unsigned int j = 0; j < n_points; ++j)
+          {
+            const unsigned int row = i * n_points + j;
+            matrix.set(row, row, 4.5);
+            if (i > 0)
+              matrix.set(row, row - n_points, -1.5);
+            if (i + 1 < n_points)
+              matrix.set(row, row + n_points, -0.5);
+            if (j > 0)
+              matrix.set(row, row - 1, -1.25);
+            if (j + 1 < n_points)
+              matrix.set(row, row + 1, -0.75);
+          }
+      matrix.compress(VectorOperation::insert);
+
+      const IndexSet                locally_owned = complete_index_set(n);
+      TrilinosWrappers::MPI::Vector src(locally_owned, MPI_COMM_WORLD);
+      TrilinosWrappers::MPI::Vector single_dst(locally_owned, MPI_COMM_WORLD);
+      TrilinosWrappers::MPI::Vector double_dst(locally_owned, MPI_COMM_WORLD);
+      for (unsigned int i = 0; i < n; ++i)
+        src[i] = 1. + 0.1 * (i % 7);
+      src.compress(VectorOperation::insert);
+
+      // Absolute and relative thresholds, without and with a perturbation of
+      // the diagonal
+      const std::vector<std::pair<double, double>> thresholds = {{0., 1.},
+                                                                 {1e-2, 1.1}};
+      for (const auto &threshold : thresholds)
+        {
+          TrilinosWrappers::PreconditionILU double_ilu;
+          double_ilu.initialize(
+            matrix,
+            TrilinosWrappers::PreconditionILU::AdditionalData(
+              0, threshold.first, threshold.second, 0));
+          double_ilu.vmult(double_dst, src);
+
+          SinglePrecisionILU single_ilu;
+          single_ilu.initialize(matrix,
+                                SinglePrecisionILU::AdditionalData(
+                                  0, threshold.first, threshold.second));
+          single_ilu.vmult(single_dst, src);
+
+          single_dst -= double_dst;
+          const double relative_difference =
+            single_dst.l2_norm() / double_dst.l2_norm();
+
+          deallog << (threshold.first > 0 ? "Perturbed" : "Unperturbed")
+                  << " diagonal - Same as the double precision ILU : "
+                  << (relative_difference < 1e-5 ? "true" : "false")
+                  << std::endl;
+        }
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
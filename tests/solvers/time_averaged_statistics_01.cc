@@ -0,0 +1,176 @@
+// check the time-averaged statistics of a known sequence of solutions and the
+// shift of the velocity components used to compute the shear Reynolds stresses
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+#include "core/parameters.h"
+#include "solvers/gls_navier_stokes.h"
+#include "solvers/navier_stokes_solver_parameters.h"
+
+template <int dim>
+class StatisticsNavierStokes : public GLSNavierStokesSolver<dim>
+{
+public:
+  StatisticsNavierStokes(NavierStokesSolverParameters<dim> nsparam,
+                         const unsigned int                degreeVelocity,
+                         const unsigned int                degreePressure)
+    : GLSNavierStokesSolver<dim>(nsparam, degreeVelocity, degreePressure)
+  {}
+  void
+  run();
+};
+
+template <int dim>
+void
+StatisticsNavierStokes<dim>::run()
+{
+  GridGenerator::hyper_cube(*this->triangulation, -1, 1);
+  this->triangulation->refine_global(1);
+  this->setup_dofs();
+
+  // Uniform solutions (u, v, p) of the successive time steps, which all have
+  // the same time step
+  const std::vector<std::vector<double>> sequence = {{1., 3., 0.5},
+                                                     {2., 1., 1.5},
+                                                     {4., 2., 1.}};
+
+  TrilinosWrappers::MPI::Vector solution(this->locally_owned_dofs,
+                                         this->mpi_communicator);
+  for (const std::vector<double> &values : sequence)
+    {
+      VectorTools::interpolate(this->dof_handler,
+                               Functions::ConstantFunction<dim>(values),
+                               solution);
+      this->present_solution = solution;
+      this->update_time_averaged_statistics();
+    }
+
+  // Expected mean, variance and covariance with the velocity component which
+  // follows, u v for u and v u for v, of each component
+  const unsigned int  n_steps = sequence.size();
+  std::vector<double> mean(dim + 1, 0.);
+  std::vector<double> variance(dim + 1, 0.);
+  std::vector<double> covariance(dim + 1, 0.);
+  for (const std::vector<double> &values : sequence)
+    for (unsigned int c = 0; c < dim + 1; ++c)
+      mean[c] += values[c] / n_steps;
+  for (const std::vector<double> &values : sequence)
+    for (unsigned int c = 0; c < dim + 1; ++c)
+      {
+        variance[c] += (values[c] - mean[c]) * (values[c] - mean[c]) / n_steps;
+        if (c < dim)
+          covariance[c] += (values[c] - mean[c]) *
+                           (values[(c + 1) % dim] - mean[(c + 1) % dim]) /
+                           n_steps;
+      }
+
+  const std::vector<TrilinosWrappers::MPI::Vector> statistics =
+    this->time_averaged_statistics();
+  TrilinosWrappers::MPI::Vector shifted_solution;
+  this->shift_velocity_components(solution, shifted_solution);
+
+  bool mean_correct     = true;
+  bool variance_correct = true;
+  bool shear_correct    = true;
+  bool shift_correct    = true;
+  for (unsigned int c = 0; c < dim + 1; ++c)
+    {
+      std::vector<bool> component_dofs(this->dof_handler.n_dofs());
+      DoFTools::extract_dofs(this->dof_handler,
+                             this->fe.component_mask(
+                               FEValuesExtractors::Scalar(c)),
+                             component_dofs);
+
+      const double shifted_value =
+        c < dim ? sequence.back()[(c + 1) % dim] : 0.;
+      for (const auto dof : this->locally_owned_dofs)
+        if (component_dofs[dof])
+          {
+            mean_correct =
+              mean_correct && std::abs(statistics[0](dof) - mean[c]) < 1e-12;
+            variance_correct =
+              variance_correct &&
+              std::abs(statistics[1](dof) - variance[c]) < 1e-12;
+            shear_correct = shear_correct &&
+                            std::abs(statistics[2](dof) - covariance[c]) <
+                              1e-12;
+            shift_correct = shift_correct &&
+                            std::abs(shifted_solution(dof) - shifted_value) <
+                              1e-12;
+          }
+    }
+
+  deallog << "Mean : " << (mean_correct ? "true" : "false") << std::endl;
+  deallog << "Variance : " << (variance_correct ? "true" : "false")
+          << std::endl;
+  deallog << "Reynolds shear stress : " << (shear_correct ? "true" : "false")
+          << std::endl;
+  deallog << "Shifted velocity components : "
+          << (shift_correct ? "true" : "false") << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+  try
+    {
+      initlog();
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      ParameterHandler                prm;
+      NavierStokesSolverParameters<2> NSparam;
+      NSparam.declare(prm);
+      prm.parse_input_from_string("subsection simulation control\n"
+                                  "  set method    = bdf1\n"
+                                  "  set time step = 0.1\n"
+                                  "end\n"
+                                  "subsection post-processing\n"
+                                  "  set calculate time-averaged statistics "
+                                  "= true\n"
+                                  "end\n");
+      NSparam.parse(prm);
+
+      NSparam.non_linear_solver.verbosity = Parameters::Verbosity::quiet;
+      NSparam.linear_solver.verbosity     = Parameters::Verbosity::quiet;
+      NSparam.boundary_conditions.createDefaultNoSlip();
+
+      StatisticsNavierStokes<2> problem_2d(
+        NSparam,
+        NSparam.fem_parameters.velocity_order,
+        NSparam.fem_parameters.pressure_order);
+      problem_2d.run();
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,180 @@
+// check that the gls solver gives the same solution with the trilinos and the
+// dealii vector backends
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include "../tests.h"
+#include "core/parameters.h"
+#include "solvers/gls_navier_stokes.h"
+#include "solvers/navier_stokes_solver_parameters.h"
+
+template <int dim>
+class ExactSolutionMMS : public Function<dim>
+{
+public:
+  ExactSolutionMMS()
+    : Function<dim>(3)
+  {}
+  virtual void
+  vector_value(const Point<dim> &p, Vector<double> &values) const;
+};
+template <int dim>
+void
+ExactSolutionMMS<dim>::vector_value(const Point<dim> &p,
+                                    Vector<double> &  values) const
+{
+  assert(dim == 2);
+  const double a = M_PI;
+  double       x = p[0];
+  double       y = p[1];
+  values(0)      = sin(a * x) * sin(a * x) * cos(a * y) * sin(a * y);
+  values(1)      = -cos(a * x) * sin(a * x) * sin(a * y) * sin(a * y);
+}
+
+
+template <int dim>
+class MMSSineForcingFunction : public Function<dim>
+{
+public:
+  MMSSineForcingFunction()
+    : Function<dim>(3)
+  {}
+  virtual void
+  vector_value(const Point<dim> &p, Vector<double> &values) const;
+};
+template <int dim>
+void
+MMSSineForcingFunction<dim>::vector_value(const Point<dim> &p,
+                                          Vector<double> &  values) const
+{
+  assert(dim == 2);
+  const double a = M_PI;
+  const double x = p[0];
+  const double y = p[1];
+  values(0) =
+    (2 * a * a * (-sin(a * x) * sin(a * x) + cos(a * x) * (cos(a * x))) *
+       sin(a * y) * cos(a * y) -
+     4 * a * a * sin(a * x) * sin(a * x) * sin(a * y) * cos(a * y) - 2.0 * x) *
+      (-1.) +
+    a * std::pow(sin(a * x), 3.) * std::pow(sin(a * y), 2.) * std::cos(a * x);
+  values(1) =
+    (2 * a * a * (sin(a * y) * (sin(a * y)) - cos(a * y) * cos(a * y)) *
+       sin(a * x) * cos(a * x) +
+     4 * a * a * sin(a * x) * sin(a * y) * sin(a * y) * cos(a * x) - 2.0 * y) *
+      (-1) +
+    a * std::pow(sin(a * x), 2.) * std::pow(sin(a * y), 3.) * std::cos(a * y);
+}
+
+
+template <int dim, typename VectorType>
+class MMSNavierStokes : public GLSNavierStokesSolver<dim, VectorType>
+{
+public:
+  MMSNavierStokes(NavierStokesSolverParameters<dim> nsparam,
+                  const unsigned int                degreeVelocity,
+                  const unsigned int                degreePressure)
+    : GLSNavierStokesSolver<dim, VectorType>(nsparam,
+                                             degreeVelocity,
+                                             degreePressure)
+  {}
+
+  // Solves the steady manufactured solution and returns the L2 error of the
+  // velocity
+  double
+  run();
+};
+
+template <int dim, typename VectorType>
+double
+MMSNavierStokes<dim, VectorType>::run()
+{
+  const int initialSize = 4;
+  GridGenerator::hyper_cube(*this->triangulation, -1, 1);
+  this->triangulation->refine_global(initialSize);
+  this->setup_dofs();
+  this->exact_solution                        = new ExactSolutionMMS<dim>;
+  this->forcing_function                      = new MMSSineForcingFunction<dim>;
+  this->nsparam.physical_properties.viscosity = 1.;
+
+  this->first_iteration();
+  return this->calculate_L2_error(this->present_solution).first;
+}
+
+int
+main(int argc, char *argv[])
+{
+  try
+    {
+      initlog();
+      Utilities::MPI::MPI_InitFinalize mpi_initialization(
+        argc, argv, numbers::invalid_unsigned_int);
+
+      ParameterHandler                prm;
+      NavierStokesSolverParameters<2> NSparam;
+      NSparam.declare(prm);
+      NSparam.parse(prm);
+
+      // Manually alter some of the default parameters of the solver
+      NSparam.non_linear_solver.verbosity = Parameters::Verbosity::quiet;
+      NSparam.linear_solver.verbosity     = Parameters::Verbosity::quiet;
+      NSparam.boundary_conditions.createDefaultNoSlip();
+
+      // The history of the linear solvers depends on the vector backend, so
+      // it is not written to the output
+      deallog.depth_file(0);
+
+      NSparam.linear_solver.vector_backend =
+        Parameters::LinearSolver::VectorBackend::trilinos;
+      MMSNavierStokes<2, TrilinosWrappers::MPI::Vector> trilinos_problem(
+        NSparam,
+        NSparam.fem_parameters.velocity_order,
+        NSparam.fem_parameters.pressure_order);
+      const double trilinos_error = trilinos_problem.run();
+
+      NSparam.linear_solver.vector_backend =
+        Parameters::LinearSolver::VectorBackend::dealii;
+      MMSNavierStokes<2, LinearAlgebra::distributed::Vector<double>>
+        dealii_problem(NSparam,
+                       NSparam.fem_parameters.velocity_order,
+                       NSparam.fem_parameters.pressure_order);
+      const double dealii_error = dealii_problem.run();
+
+      deallog.depth_file(10000);
+
+      deallog << "Converged : " << (trilinos_error < 0.05 ? "true" : "false")
+              << std::endl;
+      deallog << "Same error with both vector backends : "
+              << (std::abs(dealii_error - trilinos_error) <
+                      1e-5 * trilinos_error ?
+                    "true" :
+                    "false")
+              << std::endl;
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}